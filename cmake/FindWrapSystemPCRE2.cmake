@@ -6,8 +6,9 @@ set(WrapSystemPCRE2_REQUIRED_VARS __pcre2_found)
 
 find_package(PCRE2 ${${CMAKE_FIND_PACKAGE_NAME}_FIND_VERSION} CONFIG QUIET)
 
-set(__pcre2_target_name "PCRE2::pcre2-16")
-if(PCRE2_FOUND AND TARGET "${__pcre2_target_name}")
+# QRegularExpression uses the 16-bit library, and the 8-bit one to match UTF-8 data
+set(__pcre2_target_names "PCRE2::pcre2-16" "PCRE2::pcre2-8")
+if(PCRE2_FOUND AND TARGET PCRE2::pcre2-16 AND TARGET PCRE2::pcre2-8)
   # Hunter case.
   set(__pcre2_found TRUE)
   if(PCRE2_VERSION)
@@ -16,7 +17,7 @@ if(PCRE2_FOUND AND TARGET "${__pcre2_target_name}")
 endif()
 
 if(NOT __pcre2_found)
-  list(PREPEND WrapSystemPCRE2_REQUIRED_VARS PCRE2_LIBRARIES PCRE2_INCLUDE_DIRS)
+  list(PREPEND WrapSystemPCRE2_REQUIRED_VARS PCRE2_LIBRARIES PCRE2_8_LIBRARIES PCRE2_INCLUDE_DIRS)
 
   find_package(PkgConfig QUIET)
   pkg_check_modules(PC_PCRE2 QUIET libpcre2-16)
@@ -30,14 +31,21 @@ if(NOT __pcre2_found)
   find_library(PCRE2_LIBRARY_DEBUG
               NAMES pcre2-16d pcre2-16
               HINTS ${PC_PCRE2_LIBDIR})
+  find_library(PCRE2_8_LIBRARY_RELEASE
+              NAMES pcre2-8
+              HINTS ${PC_PCRE2_LIBDIR})
+  find_library(PCRE2_8_LIBRARY_DEBUG
+              NAMES pcre2-8d pcre2-8
+              HINTS ${PC_PCRE2_LIBDIR})
   include(SelectLibraryConfigurations)
   select_library_configurations(PCRE2)
+  select_library_configurations(PCRE2_8)
 
   if(PC_PCRE2_VERSION)
       set(WrapSystemPCRE2_VERSION "${PC_PCRE2_VERSION}")
   endif()
 
-  if (PCRE2_LIBRARIES AND PCRE2_INCLUDE_DIRS)
+  if (PCRE2_LIBRARIES AND PCRE2_8_LIBRARIES AND PCRE2_INCLUDE_DIRS)
       set(__pcre2_found TRUE)
   endif()
 endif()
@@ -48,12 +56,12 @@ find_package_handle_standard_args(WrapSystemPCRE2
                                   VERSION_VAR WrapSystemPCRE2_VERSION)
 if(WrapSystemPCRE2_FOUND)
     add_library(WrapSystemPCRE2::WrapSystemPCRE2 INTERFACE IMPORTED)
-    if(TARGET "${__pcre2_target_name}")
-        target_link_libraries(WrapSystemPCRE2::WrapSystemPCRE2 INTERFACE "${__pcre2_target_name}")
+    if(TARGET PCRE2::pcre2-16 AND TARGET PCRE2::pcre2-8)
+        target_link_libraries(WrapSystemPCRE2::WrapSystemPCRE2 INTERFACE ${__pcre2_target_names})
     else()
-        target_link_libraries(WrapSystemPCRE2::WrapSystemPCRE2 INTERFACE ${PCRE2_LIBRARIES})
+        target_link_libraries(WrapSystemPCRE2::WrapSystemPCRE2 INTERFACE ${PCRE2_LIBRARIES} ${PCRE2_8_LIBRARIES})
         target_include_directories(WrapSystemPCRE2::WrapSystemPCRE2 INTERFACE ${PCRE2_INCLUDE_DIRS})
     endif()
 endif()
-unset(__pcre2_target_name)
+unset(__pcre2_target_names)
 unset(__pcre2_found)
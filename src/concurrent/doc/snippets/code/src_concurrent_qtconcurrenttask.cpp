@@ -138,3 +138,13 @@ void increment(QPromise<int> &promise, int i)
 
 int result = QtConcurrent::task(&increment).withArguments(10).spawn().result(); // result == 11
 //! [12]
+
+//! [13]
+QtConcurrent::QTaskGraph graph;
+auto downloaded = graph.addTask([&]{ data = download(url); });
+auto configured = graph.addTask([&]{ settings = loadSettings(); });
+auto parsed = graph.addTask([&]{ document = parse(data, settings); }, {downloaded, configured});
+graph.addTask([&]{ render(document); }, {parsed});
+
+graph.spawn().waitForFinished();
+//! [13]
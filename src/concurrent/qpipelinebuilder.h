@@ -0,0 +1,309 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtConcurrent module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QTBASE_QPIPELINEBUILDER_H
+#define QTBASE_QPIPELINEBUILDER_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_CLANG_QDOC)
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qfuture.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmap.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthreadpool.h>
+
+#include <memory>
+#include <optional>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtConcurrent {
+
+enum class StageMode { Parallel, SerialInOrder, SerialOutOfOrder };
+
+class Q_CONCURRENT_EXPORT PipelineStatistics
+{
+public:
+    PipelineStatistics();
+    ~PipelineStatistics();
+
+    int stageCount() const;
+    qint64 processedCount(int stage) const;
+    qint64 busyTime(int stage) const;
+
+private:
+    friend class PipelineEngineBase;
+
+    struct Counters
+    {
+        QAtomicInteger<qint64> processed;
+        QAtomicInteger<qint64> busyNSecs;
+    };
+
+    void reset(int stageCount);
+
+    std::unique_ptr<Counters[]> counters;
+    int count = 0;
+
+    Q_DISABLE_COPY_MOVE(PipelineStatistics)
+};
+
+// a stage of the pipeline, the items are passed type-erased between stages
+class Q_CONCURRENT_EXPORT PipelineStageBase
+{
+public:
+    explicit PipelineStageBase(StageMode stageMode) : mode(stageMode) { }
+    virtual ~PipelineStageBase();
+
+    // for the source stage, returns null when there are no more items
+    virtual std::shared_ptr<void> process(std::shared_ptr<void> &&input) = 0;
+
+    const StageMode mode;
+};
+
+template <class T, class Source>
+class PipelineSource : public PipelineStageBase
+{
+public:
+    template <class F>
+    explicit PipelineSource(F &&f)
+        : PipelineStageBase(StageMode::SerialInOrder), source(std::forward<F>(f))
+    { }
+
+    std::shared_ptr<void> process(std::shared_ptr<void> &&) override
+    {
+        std::optional<T> item = std::invoke(source);
+        if (!item)
+            return {};
+        return std::make_shared<T>(std::move(*item));
+    }
+
+private:
+    Source source;
+};
+
+template <class In, class Out, class Stage>
+class PipelineStage : public PipelineStageBase
+{
+public:
+    template <class F>
+    PipelineStage(StageMode mode, F &&f) : PipelineStageBase(mode), stage(std::forward<F>(f)) { }
+
+    std::shared_ptr<void> process(std::shared_ptr<void> &&input) override
+    {
+        In &item = *std::static_pointer_cast<In>(input);
+        if constexpr (std::is_void_v<Out>) {
+            std::invoke(stage, std::move(item));
+            return {};
+        } else {
+            return std::make_shared<Out>(std::invoke(stage, std::move(item)));
+        }
+    }
+
+private:
+    Stage stage;
+};
+
+struct PipelineParameters
+{
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+    int maxTokens = 0;
+    PipelineStatistics *statistics = nullptr;
+};
+
+using PipelineStages = QList<std::shared_ptr<PipelineStageBase>>;
+
+class Q_CONCURRENT_EXPORT PipelineEngineBase
+{
+public:
+    PipelineEngineBase(QFutureInterfaceBase &futureInterface,
+                       const PipelineParameters &parameters, const PipelineStages &stages);
+    virtual ~PipelineEngineBase();
+
+protected:
+    void start();
+
+private:
+    struct Token
+    {
+        qint64 sequence = 0;
+        int stage = 0;
+        std::shared_ptr<void> item;
+    };
+
+    struct StageState
+    {
+        QMap<qint64, std::shared_ptr<void>> waiting;
+        qint64 nextSequence = 0;
+        bool busy = false;
+    };
+
+    void run();
+    void process(Token token);
+    bool hasWork() const;
+    void startWorker();
+    void releaseToken();
+    void discardWaitingTokens();
+    virtual void reportResult(std::shared_ptr<void> &&result, qint64 index) = 0;
+
+    QFutureInterfaceBase &futureInterface;
+    const PipelineParameters parameters;
+    const PipelineStages stages;
+    QList<StageState> states;
+    QList<Token> readyTokens;
+    QMutex mutex;
+    qint64 nextSequence = 0;
+    int maxTokens;
+    int maxWorkers;
+    int activeWorkers = 0;
+    int tokensInFlight = 0;
+    bool sourceBusy = false;
+    bool sourceDone = false;
+
+    Q_DISABLE_COPY_MOVE(PipelineEngineBase)
+};
+
+template <class T>
+class PipelineEngine : public PipelineEngineBase
+{
+public:
+    PipelineEngine(const PipelineParameters &parameters, const PipelineStages &stages)
+        : PipelineEngineBase(promise, parameters, stages)
+    { }
+
+    QFuture<T> start()
+    {
+        QFuture<T> future = promise.future();
+        PipelineEngineBase::start();
+        return future;
+    }
+
+private:
+    void reportResult(std::shared_ptr<void> &&result, qint64 index) override
+    {
+        if constexpr (!std::is_void_v<T>)
+            promise.reportAndMoveResult(std::move(*std::static_pointer_cast<T>(result)), int(index));
+    }
+
+    QFutureInterface<T> promise;
+};
+
+template <class T>
+class QPipelineBuilder
+{
+public:
+    template <class Stage>
+    [[nodiscard]]
+    auto addStage(StageMode mode, Stage &&stage)
+    {
+        static_assert(!std::is_void_v<T>,
+                      "No stage can follow a stage that doesn't return a value.");
+        static_assert(std::is_invocable_v<std::decay_t<Stage> &, T &&>,
+                      "The stage must accept the result of the previous stage.");
+
+        using Out = std::decay_t<std::invoke_result_t<std::decay_t<Stage> &, T &&>>;
+        QPipelineBuilder<Out> builder(parameters, stages);
+        builder.stages.append(std::make_shared<PipelineStage<T, Out, std::decay_t<Stage>>>(
+                mode, std::forward<Stage>(stage)));
+        return builder;
+    }
+
+    [[nodiscard]]
+    QPipelineBuilder<T> &onThreadPool(QThreadPool &newThreadPool)
+    {
+        parameters.threadPool = &newThreadPool;
+        return *this;
+    }
+
+    [[nodiscard]]
+    QPipelineBuilder<T> &withMaxTokens(int count)
+    {
+        parameters.maxTokens = count;
+        return *this;
+    }
+
+    [[nodiscard]]
+    QPipelineBuilder<T> &withStatistics(PipelineStatistics &statistics)
+    {
+        parameters.statistics = &statistics;
+        return *this;
+    }
+
+    [[nodiscard]]
+    QFuture<T> spawn()
+    {
+        return (new PipelineEngine<T>(parameters, stages))->start();
+    }
+
+private: // Methods
+    template <class Source>
+    explicit QPipelineBuilder(Source &&source)
+        : stages{std::make_shared<PipelineSource<T, std::decay_t<Source>>>(
+                  std::forward<Source>(source))}
+    { }
+
+    QPipelineBuilder(const PipelineParameters &pipelineParameters,
+                     const PipelineStages &pipelineStages)
+        : parameters(pipelineParameters), stages(pipelineStages)
+    { }
+
+    // Required for creating a builder from "pipeline" function
+    template <class Source>
+    friend auto pipeline(Source &&source);
+
+    // Required for creating a new builder from "addStage" function
+    template <class U>
+    friend class QPipelineBuilder;
+
+private: // Data
+    PipelineParameters parameters;
+    PipelineStages stages;
+};
+
+} // namespace QtConcurrent
+
+QT_END_NAMESPACE
+
+#endif // !defined(QT_NO_CONCURRENT)
+
+#endif // QTBASE_QPIPELINEBUILDER_H
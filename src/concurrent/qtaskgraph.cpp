@@ -0,0 +1,371 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtConcurrent module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qtaskgraph.h"
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qexception.h>
+#include <QtCore/qmutex.h>
+
+#include <memory>
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_CLANG_QDOC)
+
+QT_BEGIN_NAMESPACE
+
+namespace QtConcurrent {
+
+/*!
+    \class QtConcurrent::QTaskGraph
+    \inmodule QtConcurrent
+    \brief The QTaskGraph class runs tasks that depend on each other.
+    \since 6.1
+
+    \ingroup thread
+
+    A task graph runs a set of tasks on a QThreadPool, where each task only
+    starts after the tasks it depends on have finished. Tasks that don't
+    depend on each other run concurrently.
+
+    \snippet code/src_concurrent_qtconcurrenttask.cpp 13
+
+    A task is added with addTask(), together with the nodes of the tasks it
+    depends on. Since those must have been added before, the dependencies
+    can't form a cycle. spawn() starts running the graph and returns a
+    future that finishes when all tasks have finished. The same graph can
+    be spawned several times.
+
+    Each task is scheduled on the thread pool as soon as the last of its
+    dependencies has finished. One of the tasks that become ready is run
+    directly by the thread that finished the dependency, without going
+    through the thread pool.
+
+    If a task throws an exception, the tasks depending on it, directly or
+    indirectly, are not run. The other tasks still run, and the exception is
+    rethrown by the future when the graph has finished. Canceling the future
+    prevents all tasks that haven't started yet from running.
+
+    The return values of the tasks are discarded. Tasks that produce data
+    for their dependents can store it in variables captured by both.
+
+    \sa {Concurrent Task}
+*/
+
+/*!
+    \class QtConcurrent::QTaskGraph::Node
+    \inmodule QtConcurrent
+    \brief The Node class refers to a task in a QTaskGraph.
+    \since 6.1
+
+    A node is returned by QTaskGraph::addTask(), and is used for declaring
+    the dependencies of the tasks added after it.
+*/
+
+/*!
+    \fn QtConcurrent::QTaskGraph::Node::Node()
+
+    Constructs an invalid node.
+*/
+
+/*!
+    \fn bool QtConcurrent::QTaskGraph::Node::isValid() const
+
+    Returns \c true if this node refers to a task.
+*/
+
+/*!
+    \fn template <class Task> QTaskGraph::Node QtConcurrent::QTaskGraph::addTask(Task &&task, const QList<QTaskGraph::Node> &dependencies)
+
+    Adds \a task to the graph and returns its node. The task only runs
+    after the tasks of all \a dependencies have finished.
+
+    \a task is a callable object that takes no arguments, and must be
+    copyable.
+*/
+
+class QTaskGraphPrivate
+{
+public:
+    struct Task
+    {
+        std::function<void()> function;
+        QList<int> dependents;
+        int dependencyCount = 0;
+    };
+
+    QList<Task> tasks;
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+    int priority = 0;
+};
+
+namespace {
+
+// One run of a task graph. Deletes itself when all tasks have finished.
+class TaskGraphRun
+{
+public:
+    explicit TaskGraphRun(const QTaskGraphPrivate &graph);
+
+    QFuture<void> start();
+
+private:
+    class TaskRunnable : public QRunnable
+    {
+    public:
+        TaskGraphRun *graphRun = nullptr;
+        int index = 0;
+
+        void run() override { graphRun->runFrom(index); }
+    };
+
+    void runFrom(int index);
+    bool runTask(int index);
+    void finish();
+
+    const QList<QTaskGraphPrivate::Task> tasks;
+    QThreadPool *const threadPool;
+    const int priority;
+    std::unique_ptr<TaskRunnable[]> runnables;
+    std::unique_ptr<QAtomicInt[]> pendingDependencies;
+    std::unique_ptr<QAtomicInt[]> skip;
+    QAtomicInt remainingTasks;
+    QMutex exceptionMutex;
+    std::exception_ptr exception;
+    QFutureInterface<void> promise;
+};
+
+TaskGraphRun::TaskGraphRun(const QTaskGraphPrivate &graph)
+    : tasks(graph.tasks),
+      threadPool(graph.threadPool),
+      priority(graph.priority),
+      runnables(new TaskRunnable[graph.tasks.size()]),
+      pendingDependencies(new QAtomicInt[graph.tasks.size()]),
+      skip(new QAtomicInt[graph.tasks.size()]),
+      remainingTasks(int(graph.tasks.size()))
+{
+    for (int i = 0; i < tasks.size(); ++i) {
+        runnables[i].graphRun = this;
+        runnables[i].index = i;
+        runnables[i].setAutoDelete(false);
+        pendingDependencies[i].storeRelaxed(tasks.at(i).dependencyCount);
+    }
+}
+
+QFuture<void> TaskGraphRun::start()
+{
+    promise.setThreadPool(threadPool);
+    promise.setProgressRange(0, int(tasks.size()));
+    promise.reportStarted();
+    QFuture<void> future = promise.future();
+
+    if (tasks.isEmpty()) {
+        finish();
+        return future;
+    }
+
+    // collect the roots first, this run may be deleted as soon as the
+    // last one is started
+    QList<int> roots;
+    for (int i = 0; i < tasks.size(); ++i) {
+        if (tasks.at(i).dependencyCount == 0)
+            roots.append(i);
+    }
+    for (int root : qAsConst(roots))
+        threadPool->start(&runnables[root], priority);
+    return future;
+}
+
+// Runs the task at index, then keeps running one of the dependents that
+// become ready, and schedules the others.
+void TaskGraphRun::runFrom(int index)
+{
+    // Once this thread has counted its task as done, another thread may
+    // finish the last one and delete the run. Only the thread that counts
+    // the last task, or one that still has a task to run, can use it then.
+    QFutureInterface<void> future = promise;
+    const int taskCount = int(tasks.size());
+
+    while (index >= 0) {
+        const bool succeeded = runTask(index);
+
+        int next = -1;
+        for (int dependent : tasks.at(index).dependents) {
+            if (!succeeded)
+                skip[dependent].storeRelaxed(1);
+            // the ordered decrement publishes the skip flag to the thread
+            // that runs the dependent
+            if (!pendingDependencies[dependent].deref()) {
+                if (next < 0)
+                    next = dependent;
+                else
+                    threadPool->start(&runnables[dependent], priority);
+            }
+        }
+
+        const int remaining = remainingTasks.fetchAndSubOrdered(1) - 1;
+        future.setProgressValue(taskCount - remaining);
+        if (remaining == 0) {
+            finish();
+            return;
+        }
+        index = next;
+    }
+}
+
+// returns whether the task ran and didn't throw
+bool TaskGraphRun::runTask(int index)
+{
+    if (promise.isCanceled() || skip[index].loadRelaxed())
+        return false;
+
+#ifndef QT_NO_EXCEPTIONS
+    try {
+#endif
+        tasks.at(index).function();
+#ifndef QT_NO_EXCEPTIONS
+    } catch (QException &) {
+        QMutexLocker locker(&exceptionMutex);
+        if (!exception)
+            exception = std::current_exception();
+        return false;
+    } catch (...) {
+        QMutexLocker locker(&exceptionMutex);
+        if (!exception)
+            exception = std::make_exception_ptr(QUnhandledException(std::current_exception()));
+        return false;
+    }
+#endif
+    return true;
+}
+
+void TaskGraphRun::finish()
+{
+    if (exception)
+        promise.reportException(exception);
+    promise.reportFinished();
+    delete this;
+}
+
+} // unnamed namespace
+
+/*!
+    Constructs an empty task graph, that runs on the global thread pool.
+*/
+QTaskGraph::QTaskGraph()
+    : d_ptr(new QTaskGraphPrivate)
+{
+}
+
+/*!
+    Destroys the task graph. Graphs that have been spawned keep running.
+*/
+QTaskGraph::~QTaskGraph()
+{
+}
+
+QTaskGraph::Node QTaskGraph::addTaskImpl(std::function<void()> &&task,
+                                         const QList<Node> &dependencies)
+{
+    Q_D(QTaskGraph);
+    const int index = int(d->tasks.size());
+    QTaskGraphPrivate::Task newTask;
+    newTask.function = std::move(task);
+
+    for (const Node &dependency : dependencies) {
+        if (dependency.index < 0 || dependency.index >= index) {
+            qWarning("QTaskGraph::addTask: Ignoring a dependency on an invalid node");
+            continue;
+        }
+        QList<int> &dependents = d->tasks[dependency.index].dependents;
+        if (dependents.contains(index))
+            continue;
+        dependents.append(index);
+        ++newTask.dependencyCount;
+    }
+
+    d->tasks.append(std::move(newTask));
+    return Node(index);
+}
+
+/*!
+    Returns the number of tasks in the graph.
+*/
+int QTaskGraph::taskCount() const
+{
+    Q_D(const QTaskGraph);
+    return int(d->tasks.size());
+}
+
+/*!
+    Sets the thread pool \a newThreadPool that the tasks will be run on.
+*/
+QTaskGraph &QTaskGraph::onThreadPool(QThreadPool &newThreadPool)
+{
+    Q_D(QTaskGraph);
+    d->threadPool = &newThreadPool;
+    return *this;
+}
+
+/*!
+    Sets the priority \a newPriority that the tasks will be run with.
+*/
+QTaskGraph &QTaskGraph::withPriority(int newPriority)
+{
+    Q_D(QTaskGraph);
+    d->priority = newPriority;
+    return *this;
+}
+
+/*!
+    Starts running the tasks of the graph and returns a future object
+    immediately. The future finishes when all tasks have either run or been
+    skipped, and its progress value counts the finished tasks.
+*/
+QFuture<void> QTaskGraph::spawn() const
+{
+    Q_D(const QTaskGraph);
+    return (new TaskGraphRun(*d))->start();
+}
+
+} // namespace QtConcurrent
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
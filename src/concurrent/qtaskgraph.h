@@ -0,0 +1,109 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtConcurrent module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QTBASE_QTASKGRAPH_H
+#define QTBASE_QTASKGRAPH_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_CLANG_QDOC)
+
+#include <QtCore/qfuture.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qthreadpool.h>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtConcurrent {
+
+class QTaskGraphPrivate;
+
+class Q_CONCURRENT_EXPORT QTaskGraph
+{
+public:
+    class Node
+    {
+    public:
+        constexpr Node() noexcept = default;
+        constexpr bool isValid() const noexcept { return index >= 0; }
+
+    private:
+        friend class QTaskGraph;
+        constexpr explicit Node(int i) noexcept : index(i) { }
+
+        int index = -1;
+    };
+
+    QTaskGraph();
+    ~QTaskGraph();
+
+    template <class Task>
+    Node addTask(Task &&task, const QList<Node> &dependencies = {})
+    {
+        return addTaskImpl([task = std::forward<Task>(task)]() mutable { std::invoke(task); },
+                           dependencies);
+    }
+
+    int taskCount() const;
+
+    QTaskGraph &onThreadPool(QThreadPool &newThreadPool);
+    QTaskGraph &withPriority(int newPriority);
+
+    [[nodiscard]]
+    QFuture<void> spawn() const;
+
+private:
+    Node addTaskImpl(std::function<void()> &&task, const QList<Node> &dependencies);
+
+    QScopedPointer<QTaskGraphPrivate> d_ptr;
+    Q_DECLARE_PRIVATE(QTaskGraph)
+    Q_DISABLE_COPY(QTaskGraph)
+};
+
+} // namespace QtConcurrent
+
+QT_END_NAMESPACE
+
+#endif // !defined(QT_NO_CONCURRENT)
+
+#endif // QTBASE_QTASKGRAPH_H
@@ -0,0 +1,354 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtConcurrent module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+/*!
+    \page qtconcurrentalgorithms.html
+    \title Concurrent Algorithms
+    \ingroup thread
+
+    Besides the map, filter and reduce functions, Qt Concurrent provides
+    parallel versions of a few common algorithms. They run on the threads of
+    a QThreadPool, either the global one or the one passed as first argument.
+
+    \list
+    \li QtConcurrent::forEachIndex() calls a function for each index of an
+        integer range. A function that takes two \c int arguments is called
+        with the begin and end of a block of consecutive indexes instead,
+        which avoids the call overhead for small loop bodies.
+    \li QtConcurrent::sort() sorts a sequence in-place using a parallel
+        merge sort. Like std::sort(), it is not stable.
+    \li QtConcurrent::inclusiveScan() and QtConcurrent::exclusiveScan()
+        replace each item of a sequence with the prefix sum, or another
+        binary operation, of the items up to it.
+    \li QtConcurrent::transformReduce() calls a function for each item of a
+        sequence and combines the results with a binary operation, like
+        std::transform_reduce().
+    \endlist
+
+    Each algorithm is also available in a blocking variant, for example
+    QtConcurrent::blockingSort(). The blocking variants use the calling
+    thread as one of the worker threads, so they can be called from a thread
+    of the same thread pool.
+
+    The sequences passed to sort() and the scan functions are modified
+    in-place and must stay valid until the returned QFuture has finished.
+    They need random-access iterators. The binary operations passed to the
+    scan functions and transformReduce() must be associative, since items
+    are combined in chunks. transformReduce() also requires the operation to
+    be commutative.
+
+    The asynchronous variants of sort() and the scan functions run as one
+    task that coordinates the parallel passes. They can't be canceled or
+    suspended, and don't report progress.
+
+    \snippet code/src_concurrent_qtconcurrentalgorithms.cpp 0
+*/
+
+/*!
+  \class QtConcurrent::ForEachIndexKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::IndexIterator
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::BinaryReduceWrapper
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \fn template <typename Functor> ThreadEngineStarter<void> QtConcurrent::startForEachIndex(QThreadPool *pool, int begin, int end, Functor &&functor)
+  \internal
+*/
+
+/*!
+    \fn template <typename Functor> QFuture<void> QtConcurrent::forEachIndex(QThreadPool *pool, int begin, int end, Functor &&functor)
+    \since 6.1
+
+    Calls \a functor once for each index from \a begin up to, but not
+    including, \a end. All calls to \a functor are invoked from the threads
+    taken from the QThreadPool \a pool.
+
+    If \a functor takes two \c int arguments, it is called once for each
+    block of consecutive indexes instead, with the first index of the block
+    and the index following the last one.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Functor> QFuture<void> QtConcurrent::forEachIndex(int begin, int end, Functor &&functor)
+    \since 6.1
+
+    Calls \a functor once for each index from \a begin up to, but not
+    including, \a end.
+
+    If \a functor takes two \c int arguments, it is called once for each
+    block of consecutive indexes instead, with the first index of the block
+    and the index following the last one.
+
+    \sa {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Functor> void QtConcurrent::blockingForEachIndex(QThreadPool *pool, int begin, int end, Functor &&functor)
+    \since 6.1
+
+    Calls \a functor once for each index from \a begin up to, but not
+    including, \a end, or for each block of indexes if \a functor takes two
+    \c int arguments. All calls to \a functor are invoked from the calling
+    thread and the threads taken from the QThreadPool \a pool.
+
+    \note This function will block until all indexes have been processed.
+
+    \sa forEachIndex(), {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Functor> void QtConcurrent::blockingForEachIndex(int begin, int end, Functor &&functor)
+    \since 6.1
+
+    Calls \a functor once for each index from \a begin up to, but not
+    including, \a end, or for each block of indexes if \a functor takes two
+    \c int arguments.
+
+    \note This function will block until all indexes have been processed.
+
+    \sa forEachIndex(), {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> QFuture<void> QtConcurrent::sort(QThreadPool *pool, Sequence &sequence, LessThan lessThan)
+    \since 6.1
+
+    Sorts \a sequence in-place using the threads taken from the QThreadPool
+    \a pool. The items are compared with \a lessThan, which defaults to
+    \c{operator<()}.
+
+    \sa blockingSort(), {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> QFuture<void> QtConcurrent::sort(Sequence &sequence, LessThan lessThan)
+    \since 6.1
+
+    Sorts \a sequence in-place. The items are compared with \a lessThan,
+    which defaults to \c{operator<()}.
+
+    \sa blockingSort(), {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> void QtConcurrent::blockingSort(QThreadPool *pool, Sequence &sequence, LessThan lessThan)
+    \since 6.1
+
+    Sorts \a sequence in-place using the calling thread and the threads
+    taken from the QThreadPool \a pool. The items are compared with
+    \a lessThan, which defaults to \c{operator<()}.
+
+    \note This function will block until the sequence is sorted.
+
+    \sa sort(), {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> void QtConcurrent::blockingSort(Sequence &sequence, LessThan lessThan)
+    \since 6.1
+
+    Sorts \a sequence in-place. The items are compared with \a lessThan,
+    which defaults to \c{operator<()}.
+
+    \note This function will block until the sequence is sorted.
+
+    \sa sort(), {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOperation> QFuture<void> QtConcurrent::inclusiveScan(QThreadPool *pool, Sequence &sequence, BinaryOperation op)
+    \since 6.1
+
+    Replaces each item of \a sequence with the result of combining it and
+    all items before it with \a op, which defaults to \c{operator+()}. The
+    threads are taken from the QThreadPool \a pool.
+
+    \sa exclusiveScan(), {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOperation> QFuture<void> QtConcurrent::inclusiveScan(Sequence &sequence, BinaryOperation op)
+    \since 6.1
+
+    Replaces each item of \a sequence with the result of combining it and
+    all items before it with \a op, which defaults to \c{operator+()}.
+
+    \sa exclusiveScan(), {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOperation> void QtConcurrent::blockingInclusiveScan(QThreadPool *pool, Sequence &sequence, BinaryOperation op)
+    \since 6.1
+
+    Replaces each item of \a sequence with the result of combining it and
+    all items before it with \a op, which defaults to \c{operator+()}. The
+    calling thread and the threads taken from the QThreadPool \a pool are
+    used.
+
+    \note This function will block until the whole sequence has been processed.
+
+    \sa inclusiveScan(), {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOperation> void QtConcurrent::blockingInclusiveScan(Sequence &sequence, BinaryOperation op)
+    \since 6.1
+
+    Replaces each item of \a sequence with the result of combining it and
+    all items before it with \a op, which defaults to \c{operator+()}.
+
+    \note This function will block until the whole sequence has been processed.
+
+    \sa inclusiveScan(), {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename T, typename BinaryOperation> QFuture<void> QtConcurrent::exclusiveScan(QThreadPool *pool, Sequence &sequence, T initialValue, BinaryOperation op)
+    \since 6.1
+
+    Replaces each item of \a sequence with the result of combining
+    \a initialValue and all items before it with \a op, which defaults to
+    \c{operator+()}. The first item becomes \a initialValue. The threads are
+    taken from the QThreadPool \a pool.
+
+    \sa inclusiveScan(), {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename T, typename BinaryOperation> QFuture<void> QtConcurrent::exclusiveScan(Sequence &sequence, T initialValue, BinaryOperation op)
+    \since 6.1
+
+    Replaces each item of \a sequence with the result of combining
+    \a initialValue and all items before it with \a op, which defaults to
+    \c{operator+()}. The first item becomes \a initialValue.
+
+    \sa inclusiveScan(), {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename T, typename BinaryOperation> void QtConcurrent::blockingExclusiveScan(QThreadPool *pool, Sequence &sequence, T initialValue, BinaryOperation op)
+    \since 6.1
+
+    Replaces each item of \a sequence with the result of combining
+    \a initialValue and all items before it with \a op, which defaults to
+    \c{operator+()}. The calling thread and the threads taken from the
+    QThreadPool \a pool are used.
+
+    \note This function will block until the whole sequence has been processed.
+
+    \sa exclusiveScan(), {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename T, typename BinaryOperation> void QtConcurrent::blockingExclusiveScan(Sequence &sequence, T initialValue, BinaryOperation op)
+    \since 6.1
+
+    Replaces each item of \a sequence with the result of combining
+    \a initialValue and all items before it with \a op, which defaults to
+    \c{operator+()}.
+
+    \note This function will block until the whole sequence has been processed.
+
+    \sa exclusiveScan(), {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename T, typename BinaryOperation, typename TransformFunctor> QFuture<T> QtConcurrent::transformReduce(QThreadPool *pool, Sequence &&sequence, T initialValue, BinaryOperation reduce, TransformFunctor &&transform)
+    \since 6.1
+
+    Calls \a transform once for each item in \a sequence and combines the
+    results and \a initialValue with \a reduce, which must be associative
+    and commutative. All calls are invoked from the threads taken from the
+    QThreadPool \a pool, and \a reduce is called concurrently.
+
+    \sa mappedReduced(), {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename T, typename BinaryOperation, typename TransformFunctor> QFuture<T> QtConcurrent::transformReduce(Sequence &&sequence, T initialValue, BinaryOperation reduce, TransformFunctor &&transform)
+    \since 6.1
+
+    Calls \a transform once for each item in \a sequence and combines the
+    results and \a initialValue with \a reduce, which must be associative
+    and commutative. \a reduce is called concurrently.
+
+    \sa mappedReduced(), {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename T, typename BinaryOperation, typename TransformFunctor> T QtConcurrent::blockingTransformReduce(QThreadPool *pool, Sequence &&sequence, T initialValue, BinaryOperation reduce, TransformFunctor &&transform)
+    \since 6.1
+
+    Calls \a transform once for each item in \a sequence and combines the
+    results and \a initialValue with \a reduce, which must be associative
+    and commutative. All calls are invoked from the calling thread and the
+    threads taken from the QThreadPool \a pool.
+
+    \note This function will block until all items in the sequence have been processed.
+
+    \sa transformReduce(), {Concurrent Algorithms}
+*/
+
+/*!
+    \fn template <typename Sequence, typename T, typename BinaryOperation, typename TransformFunctor> T QtConcurrent::blockingTransformReduce(Sequence &&sequence, T initialValue, BinaryOperation reduce, TransformFunctor &&transform)
+    \since 6.1
+
+    Calls \a transform once for each item in \a sequence and combines the
+    results and \a initialValue with \a reduce, which must be associative
+    and commutative.
+
+    \note This function will block until all items in the sequence have been processed.
+
+    \sa transformReduce(), {Concurrent Algorithms}
+*/
@@ -0,0 +1,239 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtConcurrent module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QTCONCURRENT_ALGORITHMS_H
+#define QTCONCURRENT_ALGORITHMS_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_CLANG_QDOC)
+
+#include <QtConcurrent/qtconcurrentalgorithmskernel.h>
+#include <QtConcurrent/qtconcurrentrun.h>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+
+
+namespace QtConcurrent {
+
+// forEachIndex()
+template <typename Functor>
+QFuture<void> forEachIndex(QThreadPool *pool, int begin, int end, Functor &&functor)
+{
+    return startForEachIndex(pool, begin, end, std::forward<Functor>(functor));
+}
+
+template <typename Functor>
+QFuture<void> forEachIndex(int begin, int end, Functor &&functor)
+{
+    return startForEachIndex(QThreadPool::globalInstance(), begin, end,
+                             std::forward<Functor>(functor));
+}
+
+template <typename Functor>
+void blockingForEachIndex(QThreadPool *pool, int begin, int end, Functor &&functor)
+{
+    startForEachIndex(pool, begin, end, std::forward<Functor>(functor)).startBlocking();
+}
+
+template <typename Functor>
+void blockingForEachIndex(int begin, int end, Functor &&functor)
+{
+    startForEachIndex(QThreadPool::globalInstance(), begin, end,
+                      std::forward<Functor>(functor)).startBlocking();
+}
+
+// sort()
+template <typename Sequence, typename LessThan = std::less<>>
+QFuture<void> sort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+{
+    return QtConcurrent::run(pool, [pool, &sequence, lessThan = std::move(lessThan)] {
+        sortBlocking(pool, sequence.begin(), sequence.end(), lessThan);
+    });
+}
+
+template <typename Sequence, typename LessThan = std::less<>>
+QFuture<void> sort(Sequence &sequence, LessThan lessThan = LessThan())
+{
+    return QtConcurrent::sort(QThreadPool::globalInstance(), sequence, std::move(lessThan));
+}
+
+template <typename Sequence, typename LessThan = std::less<>>
+void blockingSort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+{
+    sortBlocking(pool, sequence.begin(), sequence.end(), std::move(lessThan));
+}
+
+template <typename Sequence, typename LessThan = std::less<>>
+void blockingSort(Sequence &sequence, LessThan lessThan = LessThan())
+{
+    sortBlocking(QThreadPool::globalInstance(), sequence.begin(), sequence.end(),
+                 std::move(lessThan));
+}
+
+// inclusiveScan()
+template <typename Sequence, typename BinaryOperation = std::plus<>>
+QFuture<void> inclusiveScan(QThreadPool *pool, Sequence &sequence,
+                            BinaryOperation op = BinaryOperation())
+{
+    using T = std::decay_t<decltype(*sequence.begin())>;
+    return QtConcurrent::run(pool, [pool, &sequence, op = std::move(op)] {
+        scanBlocking(pool, sequence.begin(), sequence.end(), std::optional<T>(), op);
+    });
+}
+
+template <typename Sequence, typename BinaryOperation = std::plus<>>
+QFuture<void> inclusiveScan(Sequence &sequence, BinaryOperation op = BinaryOperation())
+{
+    return QtConcurrent::inclusiveScan(QThreadPool::globalInstance(), sequence, std::move(op));
+}
+
+template <typename Sequence, typename BinaryOperation = std::plus<>>
+void blockingInclusiveScan(QThreadPool *pool, Sequence &sequence,
+                           BinaryOperation op = BinaryOperation())
+{
+    using T = std::decay_t<decltype(*sequence.begin())>;
+    scanBlocking(pool, sequence.begin(), sequence.end(), std::optional<T>(), std::move(op));
+}
+
+template <typename Sequence, typename BinaryOperation = std::plus<>>
+void blockingInclusiveScan(Sequence &sequence, BinaryOperation op = BinaryOperation())
+{
+    QtConcurrent::blockingInclusiveScan(QThreadPool::globalInstance(), sequence, std::move(op));
+}
+
+// exclusiveScan()
+template <typename Sequence, typename T, typename BinaryOperation = std::plus<>>
+QFuture<void> exclusiveScan(QThreadPool *pool, Sequence &sequence, T initialValue,
+                            BinaryOperation op = BinaryOperation())
+{
+    return QtConcurrent::run(pool, [pool, &sequence, initialValue = std::move(initialValue),
+                                    op = std::move(op)] {
+        scanBlocking(pool, sequence.begin(), sequence.end(), std::optional<T>(initialValue), op);
+    });
+}
+
+template <typename Sequence, typename T, typename BinaryOperation = std::plus<>>
+QFuture<void> exclusiveScan(Sequence &sequence, T initialValue,
+                            BinaryOperation op = BinaryOperation())
+{
+    return QtConcurrent::exclusiveScan(QThreadPool::globalInstance(), sequence,
+                                       std::move(initialValue), std::move(op));
+}
+
+template <typename Sequence, typename T, typename BinaryOperation = std::plus<>>
+void blockingExclusiveScan(QThreadPool *pool, Sequence &sequence, T initialValue,
+                           BinaryOperation op = BinaryOperation())
+{
+    scanBlocking(pool, sequence.begin(), sequence.end(),
+                 std::optional<T>(std::move(initialValue)), std::move(op));
+}
+
+template <typename Sequence, typename T, typename BinaryOperation = std::plus<>>
+void blockingExclusiveScan(Sequence &sequence, T initialValue,
+                           BinaryOperation op = BinaryOperation())
+{
+    QtConcurrent::blockingExclusiveScan(QThreadPool::globalInstance(), sequence,
+                                        std::move(initialValue), std::move(op));
+}
+
+// transformReduce()
+template <typename Sequence, typename T, typename BinaryOperation, typename TransformFunctor>
+QFuture<T> transformReduce(QThreadPool *pool, Sequence &&sequence, T initialValue,
+                           BinaryOperation reduce, TransformFunctor &&transform)
+{
+    using Wrapper = BinaryReduceWrapper<T, BinaryOperation>;
+    QFuture<std::optional<T>> future =
+            startMappedReduced<QtPrivate::MapResultType<Sequence, TransformFunctor>,
+                               std::optional<T>>(
+                    pool, std::forward<Sequence>(sequence),
+                    std::forward<TransformFunctor>(transform), Wrapper { std::move(reduce) },
+                    std::optional<T>(std::move(initialValue)),
+                    ReduceOptions(UnorderedReduce | ParallelReduce));
+    return future.then(QtFuture::Launch::Sync,
+                       [](const std::optional<T> &result) { return *result; });
+}
+
+template <typename Sequence, typename T, typename BinaryOperation, typename TransformFunctor>
+QFuture<T> transformReduce(Sequence &&sequence, T initialValue, BinaryOperation reduce,
+                           TransformFunctor &&transform)
+{
+    return QtConcurrent::transformReduce(QThreadPool::globalInstance(),
+                                         std::forward<Sequence>(sequence),
+                                         std::move(initialValue), std::move(reduce),
+                                         std::forward<TransformFunctor>(transform));
+}
+
+template <typename Sequence, typename T, typename BinaryOperation, typename TransformFunctor>
+T blockingTransformReduce(QThreadPool *pool, Sequence &&sequence, T initialValue,
+                          BinaryOperation reduce, TransformFunctor &&transform)
+{
+    using Wrapper = BinaryReduceWrapper<T, BinaryOperation>;
+    std::optional<T> result =
+            startMappedReduced<QtPrivate::MapResultType<Sequence, TransformFunctor>,
+                               std::optional<T>>(
+                    pool, std::forward<Sequence>(sequence),
+                    std::forward<TransformFunctor>(transform), Wrapper { std::move(reduce) },
+                    std::optional<T>(std::move(initialValue)),
+                    ReduceOptions(UnorderedReduce | ParallelReduce)).startBlocking();
+    return std::move(*result);
+}
+
+template <typename Sequence, typename T, typename BinaryOperation, typename TransformFunctor>
+T blockingTransformReduce(Sequence &&sequence, T initialValue, BinaryOperation reduce,
+                          TransformFunctor &&transform)
+{
+    return QtConcurrent::blockingTransformReduce(QThreadPool::globalInstance(),
+                                                 std::forward<Sequence>(sequence),
+                                                 std::move(initialValue), std::move(reduce),
+                                                 std::forward<TransformFunctor>(transform));
+}
+
+} // namespace QtConcurrent
+
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
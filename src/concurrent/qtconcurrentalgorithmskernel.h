@@ -0,0 +1,286 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtConcurrent module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QTCONCURRENT_ALGORITHMSKERNEL_H
+#define QTCONCURRENT_ALGORITHMSKERNEL_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined (Q_CLANG_QDOC)
+
+#include <QtConcurrent/qtconcurrentiteratekernel.h>
+#include <QtConcurrent/qtconcurrentmapkernel.h>
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+
+QT_BEGIN_NAMESPACE
+
+
+namespace QtConcurrent {
+
+// random access iterator over the integers of a range
+class IndexIterator
+{
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = int;
+    using difference_type = int;
+    using pointer = const int *;
+    using reference = int;
+
+    constexpr IndexIterator(int index = 0) noexcept : i(index) { }
+
+    constexpr int operator*() const noexcept { return i; }
+    IndexIterator &operator++() noexcept { ++i; return *this; }
+    IndexIterator &operator+=(int n) noexcept { i += n; return *this; }
+    constexpr IndexIterator operator+(int n) const noexcept { return IndexIterator(i + n); }
+    constexpr int operator-(IndexIterator other) const noexcept { return i - other.i; }
+    constexpr bool operator==(IndexIterator other) const noexcept { return i == other.i; }
+    constexpr bool operator!=(IndexIterator other) const noexcept { return i != other.i; }
+
+private:
+    int i;
+};
+
+// calls the functor for each index, or for each block of indexes if it
+// takes the begin and end of the block
+template <typename Functor>
+class ForEachIndexKernel : public IterateKernel<IndexIterator, void>
+{
+    Functor functor;
+public:
+    typedef void ReturnType;
+    template <typename F = Functor>
+    ForEachIndexKernel(QThreadPool *pool, int rangeBegin, int rangeEnd, F &&_functor)
+        : IterateKernel<IndexIterator, void>(pool, IndexIterator(rangeBegin),
+                                             IndexIterator(qMax(rangeBegin, rangeEnd))),
+          functor(std::forward<F>(_functor))
+    { }
+
+    bool runIteration(IndexIterator it, int, void *) override
+    {
+        if constexpr (std::is_invocable_v<Functor &, int, int>)
+            std::invoke(functor, *it, *it + 1);
+        else
+            std::invoke(functor, *it);
+        return false;
+    }
+
+    bool runIterations(IndexIterator rangeBeginIterator, int beginIndex, int endIndex, void *) override
+    {
+        const int rangeBegin = *rangeBeginIterator;
+        if constexpr (std::is_invocable_v<Functor &, int, int>) {
+            std::invoke(functor, rangeBegin + beginIndex, rangeBegin + endIndex);
+        } else {
+            for (int i = beginIndex; i < endIndex; ++i)
+                std::invoke(functor, rangeBegin + i);
+        }
+        return false;
+    }
+};
+
+template <typename Functor>
+inline ThreadEngineStarter<void> startForEachIndex(QThreadPool *pool, int begin, int end,
+                                                   Functor &&functor)
+{
+    return startThreadEngine(new ForEachIndexKernel<std::decay_t<Functor>>(
+            pool, begin, end, std::forward<Functor>(functor)));
+}
+
+// Adapts a binary operation returning the reduced value, as used by
+// transformReduce(), to the reduce functors of the reduce kernel. The
+// partial results start out empty, so no identity value is needed, and the
+// result starts out as the initial value.
+template <typename T, typename BinaryOperation>
+struct BinaryReduceWrapper
+{
+    BinaryOperation op;
+
+    template <typename U>
+    void operator()(std::optional<T> &result, const U &value)
+    {
+        if constexpr (std::is_same_v<U, std::optional<T>>) {
+            if (value)
+                combine(result, *value);
+        } else {
+            combine(result, value);
+        }
+    }
+
+    template <typename U>
+    void combine(std::optional<T> &result, const U &value)
+    {
+        if (result)
+            result = std::invoke(op, std::move(*result), value);
+        else
+            result.emplace(value);
+    }
+};
+
+// Splits count items into at most four chunks per thread of the pool,
+// each holding at least minimumChunkSize items.
+inline int chunkCount(QThreadPool *pool, qint64 count, int minimumChunkSize)
+{
+    const int threadCount = pool->maxThreadCount();
+    if (threadCount <= 1)
+        return 1;
+    return int(qBound(qint64(1), count / minimumChunkSize, qint64(threadCount) * 4));
+}
+
+template <typename Iterator>
+inline Iterator chunkBegin(Iterator begin, qint64 count, int chunkCount, int chunk)
+{
+    return begin + typename std::iterator_traits<Iterator>::difference_type(count * chunk / chunkCount);
+}
+
+// Parallel merge sort: sorts chunks of the range concurrently, then merges
+// neighboring chunks pairwise, halving their number in each pass.
+template <typename Iterator, typename LessThan>
+void sortBlocking(QThreadPool *pool, Iterator begin, Iterator end, LessThan lessThan)
+{
+    const qint64 count = std::distance(begin, end);
+    int chunks = chunkCount(pool, count, 2048);
+    while (chunks & (chunks - 1)) // round down to a power of two
+        chunks &= chunks - 1;
+
+    if (chunks <= 1) {
+        std::sort(begin, end, lessThan);
+        return;
+    }
+
+    auto chunkAt = [=](int chunk) { return chunkBegin(begin, count, chunks, chunk); };
+
+    startForEachIndex(pool, 0, chunks, [&](int chunk) {
+        std::sort(chunkAt(chunk), chunkAt(chunk + 1), lessThan);
+    }).startBlocking();
+
+    for (int width = 1; width < chunks; width *= 2) {
+        startForEachIndex(pool, 0, chunks / (2 * width), [&](int pair) {
+            const int first = pair * 2 * width;
+            std::inplace_merge(chunkAt(first), chunkAt(first + width),
+                               chunkAt(first + 2 * width), lessThan);
+        }).startBlocking();
+    }
+}
+
+// Parallel in-place scan in three passes: the chunks of the range are
+// reduced concurrently, the chunk totals are scanned sequentially to get
+// the value each chunk starts from, and then the chunks are scanned
+// concurrently. Without an initial value, the scan is inclusive.
+template <typename Iterator, typename T, typename BinaryOperation>
+void scanBlocking(QThreadPool *pool, Iterator begin, Iterator end,
+                  std::optional<T> initialValue, BinaryOperation op)
+{
+    const qint64 count = std::distance(begin, end);
+    if (count == 0)
+        return;
+
+    const bool inclusive = !initialValue;
+    const int chunks = chunkCount(pool, count, 1024);
+    auto chunkAt = [=](int chunk) { return chunkBegin(begin, count, chunks, chunk); };
+
+    QList<std::optional<T>> offsets(chunks);
+    offsets[0] = std::move(initialValue);
+
+    if (chunks > 1) {
+        QList<std::optional<T>> totals(chunks - 1);
+        startForEachIndex(pool, 0, chunks - 1, [&](int chunk) {
+            const Iterator chunkEnd = chunkAt(chunk + 1);
+            Iterator it = chunkAt(chunk);
+            T total = *it;
+            for (++it; it != chunkEnd; ++it)
+                total = std::invoke(op, std::move(total), *it);
+            totals[chunk] = std::move(total);
+        }).startBlocking();
+
+        for (int chunk = 1; chunk < chunks; ++chunk) {
+            const std::optional<T> &previous = offsets.at(chunk - 1);
+            if (previous)
+                offsets[chunk] = std::invoke(op, *previous, *totals.at(chunk - 1));
+            else
+                offsets[chunk] = totals.at(chunk - 1);
+        }
+    }
+
+    startForEachIndex(pool, 0, chunks, [&](int chunk) {
+        std::optional<T> value = offsets.at(chunk);
+        const Iterator chunkEnd = chunkAt(chunk + 1);
+        for (Iterator it = chunkAt(chunk); it != chunkEnd; ++it) {
+            if (inclusive) {
+                if (value)
+                    value = std::invoke(op, std::move(*value), *it);
+                else
+                    value = *it;
+                *it = *value;
+            } else {
+                T next = std::invoke(op, *value, *it);
+                *it = std::move(*value);
+                value = std::move(next);
+            }
+        }
+    }).startBlocking();
+}
+
+} // namespace QtConcurrent
+
+namespace QtPrivate {
+
+// The partial results of transformReduce() are combined with the binary
+// operation, so it has to take them exactly as T as well.
+template <typename T, typename BinaryOperation>
+struct ReduceValueType<QtConcurrent::BinaryReduceWrapper<T, BinaryOperation>>
+{
+    using OperationValueType = typename ReduceValueType<BinaryOperation>::Type;
+    using Type = std::conditional_t<std::is_void_v<OperationValueType>
+                                            || std::is_same_v<OperationValueType, T>
+                                            || std::is_same_v<OperationValueType, const T &>,
+                                    std::optional<T>, OperationValueType>;
+};
+
+} // namespace QtPrivate
+
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
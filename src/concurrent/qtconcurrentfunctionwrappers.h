@@ -143,6 +143,72 @@ struct ReduceResultType<T(C::*)(U) noexcept>
 };
 #endif
 
+// -- ReduceValueType
+
+// The type in which a reduce function takes the values to reduce, or void
+// if that can't be told from its signature, as for generic lambdas.
+template <class T, class Enable = void>
+struct ReduceValueType
+{
+    using Type = void;
+};
+
+template <class T>
+struct ReduceValueType<T, std::void_t<decltype(&T::operator())>>
+    : ReduceValueType<decltype(&T::operator())>
+{
+};
+
+template <class R, class U, class V>
+struct ReduceValueType<R(*)(U, V)>
+{
+    using Type = V;
+};
+
+template <class R, class C, class V>
+struct ReduceValueType<R(C::*)(V)>
+{
+    using Type = V;
+};
+
+template <class R, class C, class U, class V>
+struct ReduceValueType<R(C::*)(U, V)>
+{
+    using Type = V;
+};
+
+template <class R, class C, class U, class V>
+struct ReduceValueType<R(C::*)(U, V) const>
+{
+    using Type = V;
+};
+
+#if defined(__cpp_noexcept_function_type) && __cpp_noexcept_function_type >= 201510
+template <class R, class U, class V>
+struct ReduceValueType<R(*)(U, V) noexcept>
+{
+    using Type = V;
+};
+
+template <class R, class C, class V>
+struct ReduceValueType<R(C::*)(V) noexcept>
+{
+    using Type = V;
+};
+
+template <class R, class C, class U, class V>
+struct ReduceValueType<R(C::*)(U, V) noexcept>
+{
+    using Type = V;
+};
+
+template <class R, class C, class U, class V>
+struct ReduceValueType<R(C::*)(U, V) const noexcept>
+{
+    using Type = V;
+};
+#endif
+
 // -- MapSequenceResultType
 
 template <class InputSequence, class MapFunctor>
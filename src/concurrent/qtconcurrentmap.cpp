@@ -137,8 +137,19 @@
     \value OrderedReduce Reduction is done in the order of the
     original sequence.
     \value SequentialReduce Reduction is done sequentially: only one
-    thread will enter the reduce function at a time. (Parallel reduction
-    might be supported in a future version of Qt Concurrent.)
+    thread will enter the reduce function at a time.
+    \value ParallelReduce Each thread reduces its own results into a partial
+    result, without waiting for other threads. The partial results are then
+    combined by calling the reduce function with two results of the reduced
+    type, first pairwise and finally into the result. Together with
+    OrderedReduce, consecutive results are reduced into partial results
+    that are combined in the order of the original sequence. This option
+    was introduced in Qt 6.1.
+
+    ParallelReduce can only be used when the reduce function is associative,
+    also accepts the reduced type as its second argument, and a default
+    constructed reduced value does not change a result it is combined with,
+    like for summing up numbers. Otherwise it is ignored.
 */
 
 /*!
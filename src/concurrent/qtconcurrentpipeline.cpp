@@ -0,0 +1,434 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtConcurrent module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qtconcurrentpipeline.h"
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qexception.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_CLANG_QDOC)
+
+QT_BEGIN_NAMESPACE
+
+namespace QtConcurrent {
+
+/*!
+    \page qtconcurrentpipeline.html
+    \title Concurrent Pipeline
+    \ingroup thread
+
+    QtConcurrent::pipeline() creates an instance of QtConcurrent::QPipelineBuilder,
+    which runs a sequence of stages on a stream of items, like reading,
+    parsing, transforming and writing records.
+
+    The pipeline starts with a source function that returns the next item
+    as a \c std::optional, or an empty optional when there are no more
+    items. Each stage added with QPipelineBuilder::addStage() takes the
+    result of the previous stage and returns the item passed on to the
+    next one. The last stage may return \c void.
+
+    \snippet code/src_concurrent_qtconcurrentpipeline.cpp 0
+
+    Each stage runs in one of the modes of QtConcurrent::StageMode. Parallel
+    stages process several items at the same time. Serial stages process one
+    item at a time, either in the order of the source, or in any order.
+    The source is always called serially.
+
+    The number of items in flight, that have been returned by the source
+    and have not yet left the last stage, is limited by
+    QPipelineBuilder::withMaxTokens(). When the limit is reached, the source
+    is not called until an item leaves the pipeline. This bounds the memory
+    used by the pipeline when some stage is slower than the source.
+
+    The results of the last stage are reported to the returned QFuture, at
+    the index of their item in the source sequence. Canceling the future
+    stops calling the source, and discards the items in flight. An exception
+    thrown by a stage cancels the pipeline and is rethrown by the future.
+
+    QtConcurrent::PipelineStatistics, set with
+    QPipelineBuilder::withStatistics(), counts the items processed by each
+    stage and the time spent in it.
+*/
+
+/*!
+    \fn template <class Source> QPipelineBuilder<T> QtConcurrent::pipeline(Source &&source)
+    \since 6.1
+
+    Creates an instance of QtConcurrent::QPipelineBuilder that takes its
+    items from \a source. The source is a function taking no arguments and
+    returning a \c{std::optional<T>}, where an empty optional ends the
+    stream of items.
+
+    \sa {Concurrent Pipeline}
+*/
+
+/*!
+    \class QtConcurrent::QPipelineBuilder
+    \inmodule QtConcurrent
+    \brief The QPipelineBuilder class is used for setting up a pipeline of stages.
+    \since 6.1
+
+    \ingroup thread
+
+    It's not possible to create an object of this class manually. See
+    \l {Concurrent Pipeline} for more details and usage examples.
+*/
+
+/*!
+    \fn template <class T> template <class Stage> QPipelineBuilder<U> QtConcurrent::QPipelineBuilder<T>::addStage(QtConcurrent::StageMode mode, Stage &&stage)
+
+    Returns a builder with \a stage appended to the pipeline, running in
+    \a mode. The stage is invoked with the items of type \c T returned by
+    the previous stage, and the type \c U of its result is the item type of
+    the returned builder.
+
+    A parallel stage is invoked from several threads at the same time.
+*/
+
+/*!
+    \fn template <class T> QPipelineBuilder<T> &QtConcurrent::QPipelineBuilder<T>::onThreadPool(QThreadPool &newThreadPool)
+
+    Sets the thread pool \a newThreadPool that the pipeline will be run on.
+    By default, the global thread pool is used.
+*/
+
+/*!
+    \fn template <class T> QPipelineBuilder<T> &QtConcurrent::QPipelineBuilder<T>::withMaxTokens(int count)
+
+    Limits the number of items in flight to \a count. By default, or if
+    \a count is not positive, twice the maximum thread count of the thread
+    pool is used.
+*/
+
+/*!
+    \fn template <class T> QPipelineBuilder<T> &QtConcurrent::QPipelineBuilder<T>::withStatistics(QtConcurrent::PipelineStatistics &statistics)
+
+    Makes the pipeline count the items processed by each stage and the time
+    spent in it in \a statistics. The counters are reset when the pipeline
+    is spawned, and \a statistics must stay valid until the pipeline has
+    finished.
+*/
+
+/*!
+    \fn template <class T> QFuture<T> QtConcurrent::QPipelineBuilder<T>::spawn()
+
+    Starts running the pipeline and returns a future object immediately.
+    The future reports the results of the last stage, or has no results if
+    the last stage returns \c void.
+*/
+
+/*!
+    \enum QtConcurrent::StageMode
+    \since 6.1
+
+    This enum specifies how a pipeline stage processes items.
+
+    \value Parallel Several items are processed at the same time, in any order.
+    \value SerialInOrder One item is processed at a time, in the order they
+           were returned by the source of the pipeline.
+    \value SerialOutOfOrder One item is processed at a time, in any order.
+*/
+
+/*!
+    \class QtConcurrent::PipelineStatistics
+    \inmodule QtConcurrent
+    \brief The PipelineStatistics class counts the work done by the stages of a pipeline.
+    \since 6.1
+
+    \ingroup thread
+
+    Stage 0 is the source of the pipeline, followed by the stages in the
+    order they were added. The counters can be read while the pipeline is
+    running.
+
+    \sa QPipelineBuilder::withStatistics()
+*/
+
+/*!
+    Constructs an empty PipelineStatistics object.
+*/
+PipelineStatistics::PipelineStatistics() = default;
+
+/*!
+    Destroys the PipelineStatistics object.
+*/
+PipelineStatistics::~PipelineStatistics() = default;
+
+/*!
+    Returns the number of stages, including the source.
+*/
+int PipelineStatistics::stageCount() const
+{
+    return count;
+}
+
+/*!
+    Returns the number of items that \a stage has processed.
+*/
+qint64 PipelineStatistics::processedCount(int stage) const
+{
+    return stage >= 0 && stage < count ? counters[stage].processed.loadRelaxed() : 0;
+}
+
+/*!
+    Returns the time in nanoseconds spent in \a stage, summed up over all
+    threads. Dividing processedCount() by it gives the throughput of a single
+    thread running the stage.
+*/
+qint64 PipelineStatistics::busyTime(int stage) const
+{
+    return stage >= 0 && stage < count ? counters[stage].busyNSecs.loadRelaxed() : 0;
+}
+
+void PipelineStatistics::reset(int stageCount)
+{
+    counters.reset(new Counters[stageCount]);
+    count = stageCount;
+}
+
+/*!
+  \class QtConcurrent::PipelineStageBase
+  \inmodule QtConcurrent
+  \internal
+*/
+
+PipelineStageBase::~PipelineStageBase()
+    = default;
+
+/*!
+  \class QtConcurrent::PipelineEngineBase
+  \inmodule QtConcurrent
+  \internal
+
+  Runs the items of the pipeline as tokens through the stages. Each worker
+  thread carries a token as far as it can; when a serial stage can't take
+  it, the token waits in the stage until the stage is done with the tokens
+  before it, and is then queued for the next free worker.
+*/
+
+PipelineEngineBase::PipelineEngineBase(QFutureInterfaceBase &promise,
+                                       const PipelineParameters &pipelineParameters,
+                                       const PipelineStages &pipelineStages)
+    : futureInterface(promise),
+      parameters(pipelineParameters),
+      stages(pipelineStages),
+      states(pipelineStages.size())
+{
+    const int threadCount = qMax(1, parameters.threadPool->maxThreadCount());
+    maxTokens = parameters.maxTokens > 0 ? parameters.maxTokens : 2 * threadCount;
+    maxWorkers = qMin(maxTokens, threadCount);
+    if (parameters.statistics)
+        parameters.statistics->reset(stages.size());
+}
+
+PipelineEngineBase::~PipelineEngineBase()
+    = default;
+
+void PipelineEngineBase::start()
+{
+    futureInterface.setThreadPool(parameters.threadPool);
+    futureInterface.reportStarted();
+
+    activeWorkers = 1;
+    parameters.threadPool->start([this] { run(); });
+}
+
+// called with the mutex locked
+bool PipelineEngineBase::hasWork() const
+{
+    return !readyTokens.isEmpty() || (!sourceDone && !sourceBusy && tokensInFlight < maxTokens);
+}
+
+// called with the mutex locked
+void PipelineEngineBase::startWorker()
+{
+    if (activeWorkers >= maxWorkers || !hasWork())
+        return;
+    ++activeWorkers;
+    if (!parameters.threadPool->tryStart([this] { run(); }))
+        --activeWorkers;
+}
+
+// called with the mutex locked
+void PipelineEngineBase::discardWaitingTokens()
+{
+    sourceDone = true;
+    tokensInFlight -= readyTokens.size();
+    readyTokens.clear();
+    for (StageState &state : states) {
+        tokensInFlight -= state.waiting.size();
+        state.waiting.clear();
+    }
+}
+
+void PipelineEngineBase::releaseToken()
+{
+    QMutexLocker locker(&mutex);
+    --tokensInFlight;
+}
+
+void PipelineEngineBase::run()
+{
+    QMutexLocker locker(&mutex);
+    for (;;) {
+        if (futureInterface.isCanceled())
+            discardWaitingTokens();
+
+        Token token;
+        if (!readyTokens.isEmpty()) {
+            token = readyTokens.takeFirst();
+        } else if (hasWork()) {
+            // take a new item from the source
+            sourceBusy = true;
+            ++tokensInFlight;
+            token.sequence = nextSequence++;
+        } else {
+            break;
+        }
+        startWorker();
+
+        locker.unlock();
+        process(std::move(token));
+        locker.relock();
+    }
+
+    // Every token is either carried by a worker or waits for one that is,
+    // so the last worker to leave finds none in flight.
+    Q_ASSERT(activeWorkers > 1 || tokensInFlight == 0);
+    if (--activeWorkers > 0)
+        return;
+
+    locker.unlock();
+    futureInterface.reportFinished();
+    delete this;
+}
+
+void PipelineEngineBase::process(Token token)
+{
+    PipelineStatistics *statistics = parameters.statistics;
+
+    for (; token.stage < stages.size(); ++token.stage) {
+        PipelineStageBase *stage = stages.at(token.stage).get();
+        const bool isSource = token.stage == 0;
+        const bool serial = !isSource && stage->mode != StageMode::Parallel;
+        const bool inOrder = stage->mode == StageMode::SerialInOrder;
+
+        if (serial) {
+            QMutexLocker locker(&mutex);
+            if (futureInterface.isCanceled()) {
+                --tokensInFlight;
+                return;
+            }
+            StageState &state = states[token.stage];
+            if (state.busy || (inOrder && state.nextSequence != token.sequence)) {
+                state.waiting.insert(token.sequence, std::move(token.item));
+                return;
+            }
+            state.busy = true;
+        }
+
+        std::shared_ptr<void> output;
+        bool failed = futureInterface.isCanceled();
+        if (!failed) {
+            QElapsedTimer timer;
+            if (statistics)
+                timer.start();
+#ifndef QT_NO_EXCEPTIONS
+            try {
+#endif
+                output = stage->process(std::move(token.item));
+#ifndef QT_NO_EXCEPTIONS
+            } catch (QException &e) {
+                futureInterface.reportException(e);
+                failed = true;
+            } catch (...) {
+                futureInterface.reportException(QUnhandledException(std::current_exception()));
+                failed = true;
+            }
+#endif
+            if (statistics && !failed && (output || !isSource)) {
+                PipelineStatistics::Counters &counters = statistics->counters[token.stage];
+                counters.processed.fetchAndAddRelaxed(1);
+                counters.busyNSecs.fetchAndAddRelaxed(timer.nsecsElapsed());
+            }
+        }
+
+        if (isSource) {
+            QMutexLocker locker(&mutex);
+            sourceBusy = false;
+            if (failed || !output) {
+                sourceDone = true;
+                --tokensInFlight;
+                return;
+            }
+        } else if (serial) {
+            QMutexLocker locker(&mutex);
+            StageState &state = states[token.stage];
+            state.busy = false;
+            if (inOrder)
+                ++state.nextSequence;
+            const auto next = inOrder ? state.waiting.find(state.nextSequence)
+                                      : state.waiting.begin();
+            if (next != state.waiting.end()) {
+                readyTokens.append({ next.key(), token.stage, std::move(next.value()) });
+                state.waiting.erase(next);
+                startWorker();
+            }
+            if (failed) {
+                --tokensInFlight;
+                return;
+            }
+        } else if (failed) {
+            releaseToken();
+            return;
+        }
+
+        token.item = std::move(output);
+    }
+
+    reportResult(std::move(token.item), token.sequence);
+    releaseToken();
+}
+
+} // namespace QtConcurrent
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
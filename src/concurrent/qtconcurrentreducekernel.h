@@ -92,8 +92,8 @@ public:
 enum ReduceOption {
     UnorderedReduce = 0x1,
     OrderedReduce = 0x2,
-    SequentialReduce = 0x4
-    // ParallelReduce = 0x8
+    SequentialReduce = 0x4,
+    ParallelReduce = 0x8
 };
 Q_DECLARE_FLAGS(ReduceOptions, ReduceOption)
 #ifndef Q_CLANG_QDOC
@@ -112,6 +112,25 @@ class ReduceKernel
     const int threadCount;
     ResultsMap resultsMap;
 
+    // ParallelReduce needs to combine partial results with the reduce function,
+    // starting from default constructed ones. The reduce function has to take
+    // the partial results exactly as they are: one accepting them through a
+    // conversion, like (qint64 &, int), would truncate them. Generic functors
+    // deduce the type. PushBackWrapper only collects results and claims to
+    // accept anything.
+    using ReduceValueType = typename QtPrivate::ReduceValueType<ReduceFunctor>::Type;
+    static constexpr bool canReduceInParallel =
+            std::is_invocable_v<ReduceFunctor &, ReduceResultType &, const ReduceResultType &>
+            && (std::is_void_v<ReduceValueType>
+                || std::is_same_v<ReduceValueType, ReduceResultType>
+                || std::is_same_v<ReduceValueType, const ReduceResultType &>)
+            && std::is_default_constructible_v<ReduceResultType>
+            && !std::is_same_v<std::decay_t<ReduceFunctor>, QtPrivate::PushBackWrapper>;
+
+    // partial results of ParallelReduce, per thread or, for OrderedReduce, per block
+    QMap<QThread *, ReduceResultType> threadResults;
+    QMap<int, ReduceResultType> blockResults;
+
     bool canReduce(int begin) const
     {
         return (((reduceOptions & UnorderedReduce)
@@ -140,6 +159,44 @@ class ReduceKernel
         }
     }
 
+    void reduceInParallel(ReduceFunctor &reduce, const IntermediateResults<T> &result)
+    {
+        if (reduceOptions & OrderedReduce) {
+            ReduceResultType blockResult = ReduceResultType();
+            reduceResult(reduce, blockResult, result);
+
+            std::lock_guard<QMutex> locker(mutex);
+            blockResults.insert(result.begin, std::move(blockResult));
+        } else {
+            // a thread runs one reduction at a time, so its result can be
+            // updated without holding the lock
+            ReduceResultType *threadResult;
+            {
+                std::lock_guard<QMutex> locker(mutex);
+                threadResult = &threadResults[QThread::currentThread()];
+            }
+            reduceResult(reduce, *threadResult, result);
+        }
+    }
+
+    // combines the partial results pairwise, as a tree, into r
+    template <typename Map>
+    void reduceTree(ReduceFunctor &reduce, ReduceResultType &r, Map &map)
+    {
+        QList<ReduceResultType> results;
+        results.reserve(map.size());
+        for (auto it = map.begin(); it != map.end(); ++it)
+            results.append(std::move(it.value()));
+        map.clear();
+
+        for (qsizetype step = 1; step < results.size(); step *= 2) {
+            for (qsizetype i = 0; i + step < results.size(); i += 2 * step)
+                std::invoke(reduce, results[i], qAsConst(results[i + step]));
+        }
+        if (!results.isEmpty())
+            std::invoke(reduce, r, qAsConst(results.first()));
+    }
+
 public:
     ReduceKernel(QThreadPool *pool, ReduceOptions _reduceOptions)
         : reduceOptions(_reduceOptions), progress(0), resultsMapSize(0),
@@ -150,6 +207,13 @@ public:
                    ReduceResultType &r,
                    const IntermediateResults<T> &result)
     {
+        if constexpr (canReduceInParallel) {
+            if (reduceOptions & ParallelReduce) {
+                reduceInParallel(reduce, result);
+                return;
+            }
+        }
+
         std::unique_lock<QMutex> locker(mutex);
         if (!canReduce(result.begin)) {
             ++resultsMapSize;
@@ -208,6 +272,15 @@ public:
     // final reduction
     void finish(ReduceFunctor &reduce, ReduceResultType &r)
     {
+        if constexpr (canReduceInParallel) {
+            if (reduceOptions & ParallelReduce) {
+                if (reduceOptions & OrderedReduce)
+                    reduceTree(reduce, r, blockResults);
+                else
+                    reduceTree(reduce, r, threadResults);
+                return;
+            }
+        }
         reduceResults(reduce, r, resultsMap);
     }
 
@@ -61,3 +61,14 @@ HelloWorldTask *hello = new HelloWorldTask();
 // QThreadPool takes ownership and deletes 'hello' automatically
 QThreadPool::globalInstance()->start(hello);
 //! [0]
+
+//! [1]
+QList<QThreadPool *> pools;
+for (int node = 0; node < QThread::numaNodeCount(); ++node) {
+    QThreadPool *pool = new QThreadPool;
+    pool->setNumaNode(node);
+    pool->setMaxThreadCount(QThread::numaNodeCpus(node).size());
+    pool->setThreadName(QStringLiteral("Worker (node %1)").arg(node));
+    pools.append(pool);
+}
+//! [1]
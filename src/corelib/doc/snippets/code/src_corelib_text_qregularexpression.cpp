@@ -374,4 +374,29 @@ QRegularExpression re(R"(\d\d \w+)");
 //! [35]
 }
 
+{
+//! [36]
+QRegularExpressionSet classifier({ R"(\berror\b)", R"(\bwarning\b)", R"(disk \S+ full)" },
+                                 QRegularExpression::CaseInsensitiveOption);
+const QList<qsizetype> indexes = classifier.matchingIndexes(u"ERROR: disk /var full");
+// indexes == { 0, 2 }
+//! [36]
+}
+
+{
+//! [37]
+QFile file("server.log");
+if (!file.open(QIODevice::ReadOnly))
+    return;
+const QByteArray log = file.readAll();
+
+QRegularExpression re(R"(^(\S+) ERROR (.*)$)", QRegularExpression::MultilineOption);
+for (const QRegularExpressionMatch &match : re.globalMatch(QUtf8StringView(log))) {
+    QUtf8StringView component = match.capturedUtf8View(1); // points into log
+    qsizetype position = match.capturedStart(); // in bytes
+    // ...
+}
+//! [37]
+}
+
 }
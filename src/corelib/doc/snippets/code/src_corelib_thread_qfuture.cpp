@@ -283,3 +283,15 @@ auto future = QtConcurrent::run([] {
    // Update UI elements
 });
 //! [19]
+
+//! [20]
+QFutureWatcher<Sample> watcher;
+QObject::connect(&watcher, &QFutureWatcherBase::resultsReadyAt, [&] {
+    for (const Sample &sample : watcher.future().takeReadyResults())
+        process(sample);
+});
+watcher.setFuture(QtConcurrent::run([](QPromise<Sample> &promise) {
+    while (Sample sample = readSample())
+        promise.addResult(sample);
+}));
+//! [20]
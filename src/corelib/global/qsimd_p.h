@@ -232,7 +232,12 @@
 //
 // macOS's fat binaries support the "x86_64h" sub-architecture and the GNU libc
 // ELF loader also supports a "haswell/" subdir (e.g., /usr/lib/haswell).
-#  define QT_FUNCTION_TARGET_STRING_ARCH_HASWELL    "arch=haswell"
+//
+// The target strings list the features explicitly: GCC does not enable the
+// ISA extensions implied by "arch=" in a target attribute, so intrinsics
+// would fail to inline in such functions. They are also limited to the
+// features checked by the CpuFeatureArch constants below.
+#  define QT_FUNCTION_TARGET_STRING_ARCH_HASWELL    "avx2,bmi,bmi2,f16c,fma,popcnt"
 #  if defined(__AVX2__) && defined(__BMI__) && defined(__BMI2__) && defined(__F16C__) && \
     defined(__FMA__) && defined(__LZCNT__) && defined(__RDRND__)
 #    define __haswell__       1
@@ -255,6 +260,23 @@ static const quint64 CpuFeatureArchHaswell    = 0
         | CpuFeatureAVX2
         | CpuFeatureBMI
         | CpuFeatureBMI2;
+
+// Skylake AVX512 sub-architecture
+//
+// The Intel Xeon Scalable processors (codenamed "Skylake-SP") introduced the
+// AVX512 subsets that matter for integer code: F, CD, DQ, BW and VL. BW adds
+// the byte and word instructions and VL allows using the mask registers with
+// 128- and 256-bit vectors. Every later Intel and AMD processor with AVX512
+// supports at least these subsets.
+#  define QT_FUNCTION_TARGET_STRING_ARCH_SKYLAKE_AVX512 \
+    QT_FUNCTION_TARGET_STRING_ARCH_HASWELL ",avx512f,avx512cd,avx512dq,avx512bw,avx512vl"
+static const quint64 CpuFeatureArchSkylakeAvx512 = 0
+        | CpuFeatureArchHaswell
+        | CpuFeatureAVX512F
+        | CpuFeatureAVX512CD
+        | CpuFeatureAVX512DQ
+        | CpuFeatureAVX512BW
+        | CpuFeatureAVX512VL;
 QT_END_NAMESPACE
 
 #endif  /* Q_PROCESSOR_X86 */
@@ -61,6 +61,7 @@
 #include <qthread.h>
 #include <qthreadstorage.h>
 #include <private/qthread_p.h>
+#include <private/qeventloopstatistics_p.h>
 #if QT_CONFIG(thread)
 #include <qthreadpool.h>
 #endif
@@ -340,7 +341,8 @@ bool QCoreApplicationPrivate::is_app_closing = false;
 Q_CORE_EXPORT uint qGlobalPostedEventsCount()
 {
     QThreadData *currentThreadData = QThreadData::current();
-    return currentThreadData->postEventList.size() - currentThreadData->postEventList.startOffset;
+    return currentThreadData->postEventList.size() - currentThreadData->postEventList.startOffset
+            + currentThreadData->postEventList.inbox.size();
 }
 
 QAbstractEventDispatcher *QCoreApplicationPrivate::eventDispatcher = nullptr;
@@ -488,6 +490,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
 
         // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
         const auto locker = qt_scoped_lock(thisThreadData->postEventList.mutex);
+        drainPostEventInbox(thisThreadData);
         for (int i = 0; i < thisThreadData->postEventList.size(); ++i) {
             const QPostEvent &pe = thisThreadData->postEventList.at(i);
             if (pe.event) {
@@ -1035,6 +1038,7 @@ bool QCoreApplication::notifyInternal2(QObject *receiver, QEvent *event)
     QObjectPrivate *d = receiver->d_func();
     QThreadData *threadData = d->threadData;
     QScopedScopeLevelCounter scopeLevelCounter(threadData);
+    QEventHandlerTimer handlerTimer(threadData, receiver, event);
     if (!selfRequired)
         return doNotify(receiver, event);
     return self->notify(receiver, event);
@@ -1137,8 +1141,11 @@ bool QCoreApplicationPrivate::sendThroughApplicationEventFilters(QObject *receiv
 
     if (extraData) {
         // application event filters are only called for objects in the GUI thread
-        for (int i = 0; i < extraData->eventFilters.size(); ++i) {
-            QObject *obj = extraData->eventFilters.at(i);
+        // look the list up again after each filter, which may have
+        // installed or removed event filters
+        const QEvent::Type type = event->type();
+        for (int i = 0; i < extraData->eventFiltersFor(type).size(); ++i) {
+            QObject *obj = extraData->eventFiltersFor(type).at(i);
             if (!obj)
                 continue;
             if (obj->d_func()->threadData != threadData) {
@@ -1155,8 +1162,9 @@ bool QCoreApplicationPrivate::sendThroughApplicationEventFilters(QObject *receiv
 bool QCoreApplicationPrivate::sendThroughObjectEventFilters(QObject *receiver, QEvent *event)
 {
     if (receiver != QCoreApplication::instance() && receiver->d_func()->extraData) {
-        for (int i = 0; i < receiver->d_func()->extraData->eventFilters.size(); ++i) {
-            QObject *obj = receiver->d_func()->extraData->eventFilters.at(i);
+        const QEvent::Type type = event->type();
+        for (int i = 0; i < receiver->d_func()->extraData->eventFiltersFor(type).size(); ++i) {
+            QObject *obj = receiver->d_func()->extraData->eventFiltersFor(type).at(i);
             if (!obj)
                 continue;
             if (obj->d_func()->threadData != receiver->d_func()->threadData) {
@@ -1488,6 +1496,58 @@ QCoreApplicationPrivate::QPostEventListLocker QCoreApplicationPrivate::lockThrea
     return locker;
 }
 
+/*!
+    \internal
+
+    Moves the events that were posted to \a data without locking (see
+    postEvent()) into its sorted post event list, in the order they were
+    posted. The caller must hold the list's mutex.
+
+    An event whose receiver has meanwhile been moved to another thread is
+    handed over to that thread's inbox instead.
+*/
+void QCoreApplicationPrivate::drainPostEventInbox(QThreadData *data)
+{
+    QPostEventInbox::Node *node = data->postEventList.inbox.takeAll();
+    if (!node)
+        return;
+
+    // the inbox is a stack, restore the posting order
+    QPostEventInbox::Node *pending = nullptr;
+    while (node) {
+        QPostEventInbox::Node *next = node->next;
+        node->next = pending;
+        pending = node;
+        node = next;
+    }
+
+    while (pending) {
+        QPostEventInbox::Node *next = pending->next;
+        const QPostEvent &pe = pending->event;
+        QObjectPrivate *receiverPrivate = QObjectPrivate::get(pe.receiver);
+        // stable while we hold the mutex: moveToThread() locks it too
+        QThreadData *receiverData = receiverPrivate->threadData.loadRelaxed();
+
+        if (receiverData == data) {
+            data->postEventList.addEvent(pe);
+            ++receiverPrivate->postedEvents;
+            receiverPrivate->inboxPostedEvents.deref();
+            delete pending;
+        } else if (receiverData) {
+            receiverData->postEventList.inbox.push(pending);
+            if (QAbstractEventDispatcher *dispatcher = receiverData->eventDispatcher.loadAcquire())
+                dispatcher->wakeUp();
+        } else {
+            // receiver is being destroyed
+            receiverPrivate->inboxPostedEvents.deref();
+            pe.event->m_posted = false;
+            delete pe.event;
+            delete pending;
+        }
+        pending = next;
+    }
+}
+
 /*!
     \since 4.3
 
@@ -1523,6 +1583,14 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         return;
     }
 
+    // Queued invocations are never compressed, so they can skip the post
+    // event list mutex, which is heavily contended when many threads feed
+    // one receiving thread.
+    if (event->type() == QEvent::MetaCall
+        && QCoreApplicationPrivate::postEventLockFree(receiver, event, priority)) {
+        return;
+    }
+
     auto locker = QCoreApplicationPrivate::lockThreadPostEventList(receiver);
     if (!locker.threadData) {
         // posting during destruction? just delete the event to prevent a leak
@@ -1532,6 +1600,9 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
 
     QThreadData *data = locker.threadData;
 
+    // keep the posting order with respect to events in the inbox
+    QCoreApplicationPrivate::drainPostEventInbox(data);
+
     // if this is one of the compressible events, do compression
     if (receiver->d_func()->postedEvents
         && self && self->compressEvent(event, receiver, &data->postEventList)) {
@@ -1580,6 +1651,65 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         dispatcher->wakeUp();
 }
 
+/*!
+    \internal
+
+    Posts \a event to \a receiver by pushing it onto the inbox of the
+    receiver's thread, without taking the post event list mutex. Returns
+    \c false, without taking ownership of \a event, if the receiver is being
+    moved to another thread; the event must then be posted with the mutex.
+
+    \a receiver is not used after the event was pushed, as the receiving
+    thread may already have delivered the event and deleted the receiver.
+*/
+bool QCoreApplicationPrivate::postEventLockFree(QObject *receiver, QEvent *event, int priority)
+{
+    auto &threadData = QObjectPrivate::get(receiver)->threadData;
+    QThreadData *data = threadData.loadAcquire();
+    if (!data) {
+        // posting during destruction? just delete the event to prevent a leak
+        delete event;
+        return true;
+    }
+
+    // delete the event on exceptions to protect against memory leaks till the event is
+    // properly owned by the inbox
+    QScopedPointer<QEvent> eventDeleter(event);
+    auto node = new QPostEventInbox::Node{ QPostEvent(receiver, event, priority), nullptr };
+    eventDeleter.take();
+
+    // Announce the push, then check that the receiver still belongs to the
+    // thread. This pairs with QObject::moveToThread(), which switches the
+    // thread first and then waits for announced pushes: either it forwards
+    // our event, or we see the new thread and fall back to the mutex.
+    QPostEventInbox &inbox = data->postEventList.inbox;
+    inbox.pushers.ref();
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (threadData.loadRelaxed() != data) {
+        inbox.pushers.deref();
+        delete node;
+        return false;
+    }
+
+    // keeps data alive once the receiver may be gone
+    data->ref();
+
+    // account for the event before it becomes visible, so that a consumer
+    // draining the inbox never sees the counter drop below zero; only
+    // QObjectData::postedEvents is protected by the mutex
+    Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
+    event->m_posted = true;
+    QObjectPrivate::get(receiver)->inboxPostedEvents.ref();
+    inbox.push(node);
+    inbox.pushers.deref();
+
+    QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
+    if (dispatcher)
+        dispatcher->wakeUp();
+    data->deref();
+    return true;
+}
+
 /*!
   \internal
   Returns \c true if \a event was compressed away (possibly deleted) and should not be added to the list.
@@ -1677,6 +1807,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     ++data->postEventList.recursion;
 
     auto locker = qt_unique_lock(data->postEventList.mutex);
+    drainPostEventInbox(data);
 
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
@@ -1690,6 +1821,9 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
 
     data->canWait = true;
 
+    if (QEventLoopStatisticsData *stats = QEventLoopStatisticsData::active(data))
+        stats->recordPostedEventQueueDepth(data->postEventList.size() - data->postEventList.startOffset);
+
     // okay. here is the tricky loop. be careful about optimizing
     // this, it looks the way it does for good reasons.
     int startOffset = data->postEventList.startOffset;
@@ -1831,6 +1965,7 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
 {
     auto locker = QCoreApplicationPrivate::lockThreadPostEventList(receiver);
     QThreadData *data = locker.threadData;
+    QCoreApplicationPrivate::drainPostEventInbox(data);
 
     // the QObject destructor calls this function directly.  this can
     // happen while the event loop is in the middle of posting events,
@@ -1894,6 +2029,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     const auto locker = qt_scoped_lock(data->postEventList.mutex);
+    drainPostEventInbox(data);
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
@@ -2051,6 +2187,7 @@ bool QCoreApplication::installTranslator(QTranslator *translationFile)
     {
         QWriteLocker locker(&d->translateMutex);
         d->translators.prepend(translationFile);
+        d->translatorsChanged();
     }
 
 #ifndef QT_NO_TRANSLATION_BUILDER
@@ -2085,6 +2222,7 @@ bool QCoreApplication::removeTranslator(QTranslator *translationFile)
     QCoreApplicationPrivate *d = self->d_func();
     QWriteLocker locker(&d->translateMutex);
     if (d->translators.removeAll(translationFile)) {
+        d->translatorsChanged();
 #ifndef QT_NO_QOBJECT
         locker.unlock();
         if (!self->closingDown()) {
@@ -2097,6 +2235,32 @@ bool QCoreApplication::removeTranslator(QTranslator *translationFile)
     return false;
 }
 
+/*!
+    \internal
+    Must be called with translateMutex locked for writing.
+*/
+void QCoreApplicationPrivate::translatorsChanged()
+{
+    translationCacheEnabled = std::all_of(translators.cbegin(), translators.cend(),
+                                          &QCoreApplicationPrivate::isTranslationCacheable);
+    QMutexLocker cacheLocker(&translationCacheMutex);
+    translationCache.clear();
+}
+
+/*!
+    \internal
+    Called by QTranslator when \a translator has been unloaded or loaded.
+*/
+void QCoreApplicationPrivate::translatorContentsChanged(QTranslator *translator)
+{
+    if (!QCoreApplication::self)
+        return;
+    QCoreApplicationPrivate *d = QCoreApplication::self->d_func();
+    QWriteLocker locker(&d->translateMutex);
+    if (d->translators.contains(translator))
+        d->translatorsChanged(); // load() may have made it cacheable
+}
+
 static void replacePercentN(QString *result, int n)
 {
     if (n >= 0) {
@@ -2155,6 +2319,12 @@ static void replacePercentN(QString *result, int n)
     This function is not virtual. You can use alternative translation
     techniques by subclassing \l QTranslator.
 
+    As long as only QTranslator objects, and no objects of subclasses of it,
+    are installed, the results of this function are cached until a
+    translator is installed, removed or loaded again. Strings that are
+    translated repeatedly then need only one lookup, no matter how many
+    translators are installed.
+
     \sa QObject::tr(), installTranslator(), removeTranslator(), translate()
 */
 QString QCoreApplication::translate(const char *context, const char *sourceText,
@@ -2169,13 +2339,48 @@ QString QCoreApplication::translate(const char *context, const char *sourceText,
         QCoreApplicationPrivate *d = self->d_func();
         QReadLocker locker(&d->translateMutex);
         if (!d->translators.isEmpty()) {
-            QList<QTranslator*>::ConstIterator it;
-            QTranslator *translationFile;
-            for (it = d->translators.constBegin(); it != d->translators.constEnd(); ++it) {
-                translationFile = *it;
-                result = translationFile->translate(context, sourceText, disambiguation, n);
-                if (!result.isNull())
-                    break;
+            // With many translators installed, most of them have to be
+            // searched in vain for every string. Remember the outcome
+            // instead, the same strings tend to be translated over and over.
+            const bool useCache = d->translationCacheEnabled;
+            const QTranslationCacheKey key = {
+                QByteArray::fromRawData(context, context ? qstrlen(context) : 0),
+                QByteArray::fromRawData(sourceText, qstrlen(sourceText)),
+                QByteArray::fromRawData(disambiguation, disambiguation ? qstrlen(disambiguation) : 0),
+                n
+            };
+            // the translation is cached before replacePercentN(), which
+            // depends on n and on the default locale at the time of the call
+            bool cached = false;
+            if (useCache) {
+                QMutexLocker cacheLocker(&d->translationCacheMutex);
+                if (const QString *translation = d->translationCache.object(key)) {
+                    result = *translation;
+                    cached = true;
+                }
+            }
+
+            if (!cached) {
+                QList<QTranslator*>::ConstIterator it;
+                QTranslator *translationFile;
+                for (it = d->translators.constBegin(); it != d->translators.constEnd(); ++it) {
+                    translationFile = *it;
+                    result = translationFile->translate(context, sourceText, disambiguation, n);
+                    if (!result.isNull())
+                        break;
+                }
+
+                if (useCache) {
+                    // the key refers to the caller's strings, store a copy
+                    QTranslationCacheKey ownedKey = {
+                        QByteArray(key.context.constData(), key.context.size()),
+                        QByteArray(key.sourceText.constData(), key.sourceText.size()),
+                        QByteArray(key.disambiguation.constData(), key.disambiguation.size()),
+                        n
+                    };
+                    QMutexLocker cacheLocker(&d->translationCacheMutex);
+                    d->translationCache.insert(std::move(ownedKey), new QString(result));
+                }
             }
         }
     }
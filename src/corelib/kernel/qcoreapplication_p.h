@@ -56,6 +56,10 @@
 #include "QtCore/qcommandlineoption.h"
 #endif
 #include "QtCore/qtranslator.h"
+#ifndef QT_NO_TRANSLATION
+#include "QtCore/qcache.h"
+#include "QtCore/qmutex.h"
+#endif
 #if QT_CONFIG(settings)
 #include "QtCore/qsettings.h"
 #endif
@@ -72,6 +76,26 @@ QT_BEGIN_NAMESPACE
 
 typedef QList<QTranslator*> QTranslatorList;
 
+#ifndef QT_NO_TRANSLATION
+struct QTranslationCacheKey
+{
+    QByteArray context;
+    QByteArray sourceText;
+    QByteArray disambiguation;
+    int n;
+
+    friend bool operator==(const QTranslationCacheKey &lhs, const QTranslationCacheKey &rhs) noexcept
+    {
+        return lhs.n == rhs.n && lhs.sourceText == rhs.sourceText
+                && lhs.context == rhs.context && lhs.disambiguation == rhs.disambiguation;
+    }
+    friend size_t qHash(const QTranslationCacheKey &key, size_t seed = 0) noexcept
+    {
+        return qHashMulti(seed, key.context, key.sourceText, key.disambiguation, key.n);
+    }
+};
+#endif
+
 class QAbstractEventDispatcher;
 
 #ifndef QT_NO_QOBJECT
@@ -156,6 +180,8 @@ public:
         void unlock() { locker.unlock(); }
     };
     static QPostEventListLocker lockThreadPostEventList(QObject *object);
+    static void drainPostEventInbox(QThreadData *data);
+    static bool postEventLockFree(QObject *receiver, QEvent *event, int priority);
 #endif // QT_NO_QOBJECT
 
     int &argc;
@@ -170,6 +196,18 @@ public:
     QTranslatorList translators;
     QReadWriteLock translateMutex;
     static bool isTranslatorInstalled(QTranslator *translator);
+
+    // Results of translate() across all installed translators. Only used
+    // while all of them are plain QTranslators, whose contents only change
+    // through load() (see isTranslationCacheable()). Protected by
+    // translationCacheMutex for lookups, and only cleared while
+    // translateMutex is locked for writing.
+    QMutex translationCacheMutex;
+    QCache<QTranslationCacheKey, QString> translationCache{4096};
+    bool translationCacheEnabled = true;
+    void translatorsChanged();
+    static void translatorContentsChanged(QTranslator *translator);
+    static bool isTranslationCacheable(const QTranslator *translator);
 #endif
 
     QCoreApplicationPrivate::Type application_type;
@@ -50,6 +50,7 @@
 #include <private/qthread_p.h>
 #include <private/qcoreapplication_p.h>
 #include <private/qcore_unix_p.h>
+#include <private/qeventloopstatistics_p.h>
 
 #include <errno.h>
 #include <stdio.h>
@@ -59,6 +60,11 @@
 #  include <sys/eventfd.h>
 #endif
 
+#if QT_CONFIG(epoll)
+#  include <sys/epoll.h>
+#  include <limits>
+#endif
+
 // VxWorks doesn't correctly set the _POSIX_... options
 #if defined(Q_OS_VXWORKS)
 #  if defined(_POSIX_MONOTONIC_CLOCK) && (_POSIX_MONOTONIC_CLOCK <= 0)
@@ -226,14 +232,206 @@ QEventDispatcherUNIXPrivate::QEventDispatcherUNIXPrivate()
 {
     if (Q_UNLIKELY(threadPipe.init() == false))
         qFatal("QEventDispatcherUNIXPrivate(): Cannot continue without a thread pipe");
+
+#if QT_CONFIG(epoll)
+    if (qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_EPOLL") > 0)
+        initEpoll();
+#endif
 }
 
 QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
 {
+#if QT_CONFIG(epoll)
+    if (epollFd >= 0)
+        qt_safe_close(epollFd);
+#endif
+
     // cleanup timers
     qDeleteAll(timerList);
 }
 
+#if QT_CONFIG(epoll)
+static uint pollToEpollEvents(short events)
+{
+    uint result = 0;
+    if (events & POLLIN)
+        result |= EPOLLIN;
+    if (events & POLLOUT)
+        result |= EPOLLOUT;
+    if (events & POLLPRI)
+        result |= EPOLLPRI;
+    return result;
+}
+
+static short epollToPollEvents(uint events)
+{
+    short result = 0;
+    if (events & EPOLLIN)
+        result |= POLLIN;
+    if (events & EPOLLOUT)
+        result |= POLLOUT;
+    if (events & EPOLLPRI)
+        result |= POLLPRI;
+    if (events & EPOLLERR)
+        result |= POLLERR;
+    if (events & EPOLLHUP)
+        result |= POLLHUP;
+    return result;
+}
+
+bool QEventDispatcherUNIXPrivate::initEpoll()
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd == -1) {
+        perror("QEventDispatcherUNIXPrivate: Unable to create epoll instance");
+        return false;
+    }
+
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = threadPipe.fds[0];
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, threadPipe.fds[0], &ev) == -1) {
+        perror("QEventDispatcherUNIXPrivate: Unable to watch the thread pipe with epoll");
+        qt_safe_close(epollFd);
+        epollFd = -1;
+        return false;
+    }
+
+    return true;
+}
+
+/*
+    Keeps the kernel interest set in sync with socketNotifiers. \a oldEvents
+    and \a newEvents are the poll(2) event masks of \a fd before and after the
+    change; an empty \a newEvents removes the descriptor.
+*/
+void QEventDispatcherUNIXPrivate::updateEpollInterest(int fd, short oldEvents, short newEvents)
+{
+    Q_ASSERT(epollFd >= 0);
+
+    const auto fallback = epollFallbackFds.indexOf(fd);
+    if (fallback != -1) {
+        if (!newEvents)
+            epollFallbackFds.remove(fallback);
+        return;
+    }
+
+    epoll_event ev = {};
+    ev.events = pollToEpollEvents(newEvents);
+    ev.data.fd = fd;
+
+    if (!newEvents) {
+        // If the descriptor was closed before its notifier was disabled, the
+        // registration cannot be removed by descriptor anymore, yet epoll
+        // keeps it as long as the open file description is referenced
+        // elsewhere (through dup() or fork()).
+        if (epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, &ev) == -1)
+            rebuildEpollInterest();
+        return;
+    }
+
+    int op = oldEvents ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    int ret = epoll_ctl(epollFd, op, fd, &ev);
+    if (ret == -1 && (errno == EEXIST || errno == ENOENT)) {
+        // the descriptor was closed and reused behind our back
+        op = (op == EPOLL_CTL_ADD) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+        ret = epoll_ctl(epollFd, op, fd, &ev);
+    }
+
+    // Regular files (EPERM) and invalid descriptors (EBADF) cannot be watched
+    // by epoll; poll(2) reports them as always ready or as POLLNVAL, so keep
+    // checking them that way to preserve the notifier semantics.
+    if (ret == -1)
+        epollFallbackFds.append(fd);
+}
+
+/*
+    Replaces the epoll instance and registers the current socketNotifiers
+    again. This is the only way to drop an interest whose descriptor was
+    closed before its notifier was disabled. If a new instance cannot be
+    created, the dispatcher falls back to poll(2).
+*/
+void QEventDispatcherUNIXPrivate::rebuildEpollInterest()
+{
+    const int oldEpollFd = std::exchange(epollFd, -1);
+    qt_safe_close(oldEpollFd);
+    epollFallbackFds.clear();
+    if (!initEpoll())
+        return;
+
+    for (auto it = socketNotifiers.cbegin(); it != socketNotifiers.cend(); ++it) {
+        if (const short events = it.value().events())
+            updateEpollInterest(it.key(), 0, events);
+    }
+}
+
+/*
+    Waits on the epoll interest set and fills pollfds with only the ready
+    descriptors, so that markPendingSocketNotifiers() does work proportional to
+    the number of events rather than the number of registered notifiers.
+*/
+int QEventDispatcherUNIXPrivate::epollWait(timespec *tm)
+{
+    Q_ASSERT(epollFd >= 0);
+
+    pollfds.clear();
+
+    // Descriptors epoll cannot watch are checked without blocking; only if
+    // one of them is ready must the wait below not block either.
+    timespec zero = { 0, 0 };
+    if (!epollFallbackFds.isEmpty()) {
+        for (int fd : qAsConst(epollFallbackFds))
+            pollfds.append(qt_make_pollfd(fd, socketNotifiers.value(fd).events()));
+        const int ready = qt_safe_poll(pollfds.data(), pollfds.size(), &zero);
+        if (ready == -1)
+            perror("qt_safe_poll");
+        else if (ready > 0)
+            tm = &zero;
+    }
+
+    int timeout = -1;
+    if (tm) {
+        // round up so that we never wake before the next timer is due
+        const qint64 msecs = qint64(tm->tv_sec) * 1000 + (tm->tv_nsec + 999999) / 1000000;
+        timeout = int(qMin(msecs, qint64(std::numeric_limits<int>::max())));
+    }
+
+    enum { MaxEvents = 256 };
+    epoll_event events[MaxEvents];
+    const int count = epoll_wait(epollFd, events, MaxEvents, timeout);
+    if (count == -1) {
+        if (errno != EINTR)
+            perror("epoll_wait");
+        return 0;
+    }
+
+    int nevents = 0;
+    bool staleInterest = false;
+    for (int i = 0; i < count; ++i) {
+        const int fd = events[i].data.fd;
+        const short revents = epollToPollEvents(events[i].events);
+        if (fd == threadPipe.fds[0]) {
+            pollfd pfd = qt_make_pollfd(fd, POLLIN);
+            pfd.revents = revents;
+            nevents += threadPipe.check(pfd);
+        } else if (!socketNotifiers.contains(fd)) {
+            // registered for a descriptor that was closed while its file
+            // stayed open; being level-triggered, it would be reported again
+            staleInterest = true;
+        } else {
+            pollfd pfd = qt_make_pollfd(fd, 0);
+            pfd.revents = revents;
+            pollfds.append(pfd);
+        }
+    }
+
+    if (staleInterest)
+        rebuildEpollInterest();
+
+    return nevents;
+}
+#endif // QT_CONFIG(epoll)
+
 void QEventDispatcherUNIXPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
 {
     Q_ASSERT(notifier);
@@ -256,7 +454,8 @@ void QEventDispatcherUNIXPrivate::markPendingSocketNotifiers()
             continue;
 
         auto it = socketNotifiers.find(pfd.fd);
-        Q_ASSERT(it != socketNotifiers.end());
+        if (it == socketNotifiers.end())
+            continue;
 
         const QSocketNotifierSetUNIX &sn_set = it.value();
 
@@ -411,7 +610,16 @@ void QEventDispatcherUNIX::registerSocketNotifier(QSocketNotifier *notifier)
         qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
                  Q_FUNC_INFO, sockfd, socketType(type));
 
+#if QT_CONFIG(epoll)
+    const short oldEvents = sn_set.events();
+#endif
+
     sn_set.notifiers[type] = notifier;
+
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0 && sn_set.events() != oldEvents)
+        d->updateEpollInterest(sockfd, oldEvents, sn_set.events());
+#endif
 }
 
 void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
@@ -450,8 +658,17 @@ void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
         return;
     }
 
+#if QT_CONFIG(epoll)
+    const short oldEvents = sn_set.events();
+#endif
+
     sn_set.notifiers[type] = nullptr;
 
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0)
+        d->updateEpollInterest(sockfd, oldEvents, sn_set.events());
+#endif
+
     if (sn_set.isEmpty())
         d->socketNotifiers.erase(i);
 }
@@ -461,10 +678,12 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     Q_D(QEventDispatcherUNIX);
     d->interrupt.storeRelaxed(0);
 
+    auto threadData = d->threadData.loadRelaxed();
+    QEventLoopIterationTimer iterationTimer(threadData);
+
     // we are awake, broadcast it
     emit awake();
 
-    auto threadData = d->threadData.loadRelaxed();
     QCoreApplicationPrivate::sendPostedEvents(nullptr, 0, threadData);
 
     const bool include_timers = (flags & QEventLoop::X11ExcludeTimers) == 0;
@@ -487,6 +706,22 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     if (!canWait || (include_timers && d->timerList.timerWait(wait_tm)))
         tm = &wait_tm;
 
+    int nevents = 0;
+
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0 && include_notifiers) {
+        iterationTimer.beginWait();
+        nevents += d->epollWait(tm);
+        iterationTimer.endWait();
+        nevents += d->activateSocketNotifiers();
+
+        if (include_timers)
+            nevents += d->activateTimers();
+
+        return (nevents > 0);
+    }
+#endif
+
     d->pollfds.clear();
     d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
 
@@ -497,9 +732,11 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     // This must be last, as it's popped off the end below
     d->pollfds.append(d->threadPipe.prepare());
 
-    int nevents = 0;
+    iterationTimer.beginWait();
+    const int pollResult = qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm);
+    iterationTimer.endWait();
 
-    switch (qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm)) {
+    switch (pollResult) {
     case -1:
         perror("qt_safe_poll");
         break;
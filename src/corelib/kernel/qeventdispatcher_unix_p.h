@@ -138,6 +138,13 @@ public:
     int activateSocketNotifiers();
     void setSocketNotifierPending(QSocketNotifier *notifier);
 
+#if QT_CONFIG(epoll)
+    bool initEpoll();
+    void updateEpollInterest(int fd, short oldEvents, short newEvents);
+    void rebuildEpollInterest();
+    int epollWait(timespec *tm);
+#endif
+
     QThreadPipe threadPipe;
     QList<pollfd> pollfds;
 
@@ -146,6 +153,13 @@ public:
 
     QTimerInfoList timerList;
     QAtomicInt interrupt; // bool
+
+#if QT_CONFIG(epoll)
+    // persistent kernel interest set, -1 when the poll(2) backend is in use
+    int epollFd = -1;
+    // descriptors epoll refused (e.g. regular files), still checked with poll(2)
+    QList<int> epollFallbackFds;
+#endif
 };
 
 inline QSocketNotifierSetUNIX::QSocketNotifierSetUNIX() noexcept
@@ -0,0 +1,178 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qeventloopstatistics_p.h"
+
+#include <qtcore_tracepoints_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QEventLoopStatistics
+    \inmodule QtCore
+    \internal
+
+    \brief The QEventLoopStatistics class reports how busy the event loop
+    of a thread is.
+
+    Recording is off by default and costs a single relaxed atomic load
+    per delivered event and per event loop iteration in that state. Once
+    enabled with setEnabled(), the owning thread records
+
+    \list
+    \li the number of event dispatcher iterations and the time spent
+        blocked waiting for events (idle) versus processing them (busy);
+    \li the number of pending posted events each time the posted event
+        queue is processed;
+    \li how late timers fire compared to their scheduled timeout;
+    \li the time spent in QCoreApplication::notify(), bucketed by event
+        type and by the class of the receiver.
+    \endlist
+
+    Handler times are inclusive: an event sent from within another
+    event's handler is counted for both. Iteration and idle times are
+    only recorded by the event dispatchers that support it, currently
+    QEventDispatcherUNIX.
+
+    The same measurements are emitted through the
+    \c QEventLoopStatistics_* tracepoints while recording is enabled.
+
+    snapshot() may be called from any thread.
+*/
+
+/*!
+    Enables or disables recording of event loop statistics for
+    \a thread, according to \a enable. Previously recorded values are
+    kept; use reset() to clear them.
+*/
+void QEventLoopStatistics::setEnabled(QThread *thread, bool enable)
+{
+    QThreadData *data = QThreadData::get2(thread);
+    QEventLoopStatisticsData *stats = data->loopStatistics.loadAcquire();
+    if (!stats) {
+        if (!enable)
+            return;
+        stats = new QEventLoopStatisticsData;
+        if (!data->loopStatistics.testAndSetOrdered(nullptr, stats)) {
+            // lost the race against another thread
+            delete std::exchange(stats, data->loopStatistics.loadAcquire());
+        }
+    }
+    stats->enabled.storeRelaxed(enable);
+}
+
+/*!
+    Returns \c true if event loop statistics are being recorded for
+    \a thread.
+*/
+bool QEventLoopStatistics::isEnabled(QThread *thread)
+{
+    return QEventLoopStatisticsData::active(QThreadData::get2(thread)) != nullptr;
+}
+
+/*!
+    Returns the statistics recorded so far for \a thread.
+*/
+QEventLoopStatistics QEventLoopStatistics::snapshot(QThread *thread)
+{
+    QEventLoopStatisticsData *stats = QThreadData::get2(thread)->loopStatistics.loadAcquire();
+    if (!stats)
+        return QEventLoopStatistics();
+
+    QMutexLocker locker(&stats->mutex);
+    return stats->statistics;
+}
+
+/*!
+    Clears the statistics recorded so far for \a thread.
+*/
+void QEventLoopStatistics::reset(QThread *thread)
+{
+    QEventLoopStatisticsData *stats = QThreadData::get2(thread)->loopStatistics.loadAcquire();
+    if (!stats)
+        return;
+
+    QMutexLocker locker(&stats->mutex);
+    stats->statistics = QEventLoopStatistics();
+}
+
+void QEventLoopStatisticsData::recordIteration(qint64 busyNSecs, qint64 idleNSecs)
+{
+    Q_TRACE(QEventLoopStatistics_iteration, busyNSecs, idleNSecs);
+    QMutexLocker locker(&mutex);
+    ++statistics.iterations;
+    statistics.busyNSecs += busyNSecs;
+    statistics.idleNSecs += idleNSecs;
+}
+
+void QEventLoopStatisticsData::recordHandler(int type, const char *className, qint64 nsecs)
+{
+    Q_TRACE(QEventLoopStatistics_handler, type, className, nsecs);
+    QMutexLocker locker(&mutex);
+    statistics.eventTypes[type].add(nsecs);
+
+    // the class name may belong to a plugin that is unloaded later on, so
+    // only look it up in place and store a copy
+    auto &receiverClasses = statistics.receiverClasses;
+    auto it = receiverClasses.find(QByteArray::fromRawData(className, qstrlen(className)));
+    if (it == receiverClasses.end())
+        it = receiverClasses.insert(QByteArray(className), QEventLoopStatistics::Handler());
+    it->add(nsecs);
+}
+
+void QEventLoopStatisticsData::recordPostedEventQueueDepth(int depth)
+{
+    Q_TRACE(QEventLoopStatistics_postedEventQueueDepth, depth);
+    QMutexLocker locker(&mutex);
+    statistics.postedEventQueueDepth = depth;
+    statistics.maxPostedEventQueueDepth = qMax(statistics.maxPostedEventQueueDepth, depth);
+}
+
+void QEventLoopStatisticsData::recordTimerLateness(int timerId, qint64 latenessNSecs)
+{
+    Q_UNUSED(timerId); // only used by the tracepoint
+    Q_TRACE(QEventLoopStatistics_timerLateness, timerId, latenessNSecs);
+    QMutexLocker locker(&mutex);
+    ++statistics.timerActivations;
+    statistics.totalTimerLatenessNSecs += latenessNSecs;
+    statistics.maxTimerLatenessNSecs = qMax(statistics.maxTimerLatenessNSecs, latenessNSecs);
+}
+
+QT_END_NAMESPACE
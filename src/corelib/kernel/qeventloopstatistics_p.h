@@ -0,0 +1,189 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QEVENTLOOPSTATISTICS_P_H
+#define QEVENTLOOPSTATISTICS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/private/qthread_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QThread;
+
+class Q_CORE_EXPORT QEventLoopStatistics
+{
+public:
+    struct Handler
+    {
+        quint64 count = 0;
+        qint64 totalNSecs = 0;
+        qint64 maxNSecs = 0;
+
+        void add(qint64 nsecs)
+        {
+            ++count;
+            totalNSecs += nsecs;
+            maxNSecs = qMax(maxNSecs, nsecs);
+        }
+    };
+
+    quint64 iterations = 0;
+    qint64 busyNSecs = 0;
+    qint64 idleNSecs = 0;
+
+    int postedEventQueueDepth = 0;
+    int maxPostedEventQueueDepth = 0;
+
+    quint64 timerActivations = 0;
+    qint64 totalTimerLatenessNSecs = 0;
+    qint64 maxTimerLatenessNSecs = 0;
+
+    QHash<int, Handler> eventTypes;
+    QHash<QByteArray, Handler> receiverClasses;
+
+    static void setEnabled(QThread *thread, bool enable);
+    static bool isEnabled(QThread *thread);
+    static QEventLoopStatistics snapshot(QThread *thread);
+    static void reset(QThread *thread);
+};
+
+class QEventLoopStatisticsData
+{
+public:
+    QAtomicInt enabled;
+    QMutex mutex;
+    QEventLoopStatistics statistics;
+
+    static QEventLoopStatisticsData *active(QThreadData *data)
+    {
+        QEventLoopStatisticsData *stats = data->loopStatistics.loadRelaxed();
+        return Q_UNLIKELY(stats && stats->enabled.loadRelaxed()) ? stats : nullptr;
+    }
+
+    void recordIteration(qint64 busyNSecs, qint64 idleNSecs);
+    void recordHandler(int type, const char *className, qint64 nsecs);
+    void recordPostedEventQueueDepth(int depth);
+    void recordTimerLateness(int timerId, qint64 latenessNSecs);
+};
+
+// Times one QCoreApplication::notify() call, including nested deliveries.
+class QEventHandlerTimer
+{
+    Q_DISABLE_COPY_MOVE(QEventHandlerTimer)
+
+    QEventLoopStatisticsData *stats;
+    // the receiver may be gone by the time the handler returns
+    const char *className = nullptr;
+    int type = 0;
+    QElapsedTimer timer;
+
+public:
+    QEventHandlerTimer(QThreadData *data, QObject *receiver, QEvent *event)
+        : stats(QEventLoopStatisticsData::active(data))
+    {
+        if (Q_UNLIKELY(stats)) {
+            className = receiver->metaObject()->className();
+            type = event->type();
+            timer.start();
+        }
+    }
+    ~QEventHandlerTimer()
+    {
+        if (Q_UNLIKELY(stats))
+            stats->recordHandler(type, className, timer.nsecsElapsed());
+    }
+};
+
+// Times one event dispatcher iteration, split into the time spent blocked
+// waiting for events and the time spent processing them.
+class QEventLoopIterationTimer
+{
+    Q_DISABLE_COPY_MOVE(QEventLoopIterationTimer)
+
+    QEventLoopStatisticsData *stats;
+    qint64 idleNSecs = 0;
+    QElapsedTimer iteration;
+    QElapsedTimer wait;
+
+public:
+    explicit QEventLoopIterationTimer(QThreadData *data)
+        : stats(QEventLoopStatisticsData::active(data))
+    {
+        if (Q_UNLIKELY(stats))
+            iteration.start();
+    }
+    ~QEventLoopIterationTimer()
+    {
+        if (Q_UNLIKELY(stats)) {
+            const qint64 total = iteration.nsecsElapsed();
+            stats->recordIteration(total - idleNSecs, idleNSecs);
+        }
+    }
+
+    void beginWait()
+    {
+        if (Q_UNLIKELY(stats))
+            wait.start();
+    }
+    void endWait()
+    {
+        if (Q_UNLIKELY(stats))
+            idleNSecs += wait.nsecsElapsed();
+    }
+};
+
+QT_END_NAMESPACE
+
+#endif // QEVENTLOOPSTATISTICS_P_H
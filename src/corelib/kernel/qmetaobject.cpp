@@ -62,6 +62,8 @@
 #include "private/qmetaobject_moc_p.h"
 
 #include <ctype.h>
+#include <memory>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -638,6 +640,174 @@ inline int QMetaObjectPrivate::indexOfMethodRelative(const QMetaObject **baseObj
 }
 
 
+namespace {
+// Maps the signatures of all methods of a meta-object, including the
+// inherited ones, to their absolute index.
+struct QMetaMethodIndex
+{
+    explicit QMetaMethodIndex(const QMetaObject *mo);
+
+    // A plugin may be unloaded and another meta-object loaded at the same
+    // address, so remember what this index was built from.
+    bool isFor(const QMetaObject *mo) const
+    {
+        return mo->d.data == data && mo->d.stringdata == stringdata
+                && mo->superClass() == superdata;
+    }
+
+    const QMetaObject *metaObject;
+    const QMetaObject *superdata;
+    const uint *data;
+    const uint *stringdata;
+    QHash<QByteArray, int> methods;
+};
+
+QMetaMethodIndex::QMetaMethodIndex(const QMetaObject *mo)
+    : metaObject(mo), superdata(mo->d.superdata), data(mo->d.data), stringdata(mo->d.stringdata)
+{
+    const int count = mo->methodCount();
+    QHash<QPair<QByteArray, int>, int> lastOverload;
+    methods.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const QMetaMethod method = mo->method(i);
+        // later, i.e. more derived, declarations win like in indexOfMethodRelative()
+        methods.insert(method.methodSignature(), i);
+        lastOverload.insert(qMakePair(method.name(), method.parameterCount()), i);
+    }
+
+    // indexOfMethodRelative() compares argument types by id where it can, so
+    // a later overload with the same name and argument count might match a
+    // differently spelled signature too. Leave those to the full lookup.
+    for (auto it = methods.begin(); it != methods.end();) {
+        const QMetaMethod method = mo->method(it.value());
+        if (lastOverload.value(qMakePair(method.name(), method.parameterCount())) != it.value())
+            it = methods.erase(it);
+        else
+            ++it;
+    }
+}
+
+// Whether mo was generated by moc, and therefore lives as long as the
+// library defining it. Meta-objects built at runtime come and go, and an
+// index kept for each of them until exit would grow without bound:
+// QMetaObjectBuilder::toMetaObject() places the data right behind the
+// meta-object, and QtDBus, like QMetaObjectBuilder by default, does not
+// provide a static metacall function.
+static bool isMocGenerated(const QMetaObject *mo)
+{
+    return mo->d.static_metacall
+            && mo->d.data != reinterpret_cast<const uint *>(mo + 1);
+}
+
+// Insert-only hash table from meta-object to QMetaMethodIndex. Lookups do
+// not lock; tables that were replaced when growing, and indexes that were
+// replaced because they became stale, are kept alive until exit since
+// concurrent readers may still use them. Only moc generated meta-objects
+// are indexed, so a stale index is only left behind by unloaded plugins.
+class QMetaMethodIndexRegistry
+{
+    struct Table
+    {
+        explicit Table(size_t capacity)
+            : buckets(new QAtomicPointer<QMetaMethodIndex>[capacity]), mask(capacity - 1)
+        {}
+
+        std::unique_ptr<QAtomicPointer<QMetaMethodIndex>[]> buckets;
+        size_t mask;
+    };
+
+public:
+    const QMetaMethodIndex *find(const QMetaObject *mo) const
+    {
+        const Table *t = table.loadAcquire();
+        if (!t)
+            return nullptr;
+        for (size_t i = qHash(mo) & t->mask; ; i = (i + 1) & t->mask) {
+            const QMetaMethodIndex *index = t->buckets[i].loadAcquire();
+            if (!index || index->metaObject == mo)
+                return index;
+        }
+    }
+
+    const QMetaMethodIndex *insert(const QMetaObject *mo)
+    {
+        QMutexLocker locker(&mutex);
+        if (const QMetaMethodIndex *index = find(mo); index && index->isFor(mo))
+            return index; // another thread was faster
+
+        Table *t = table.loadRelaxed();
+        if (!t || 2 * (count + 1) > t->mask + 1)
+            t = grow(t);
+        indexes.push_back(std::make_unique<QMetaMethodIndex>(mo));
+        place(t, indexes.back().get());
+        return indexes.back().get();
+    }
+
+private:
+    void place(Table *t, QMetaMethodIndex *index)
+    {
+        for (size_t i = qHash(index->metaObject) & t->mask; ; i = (i + 1) & t->mask) {
+            const QMetaMethodIndex *current = t->buckets[i].loadRelaxed();
+            if (!current || current->metaObject == index->metaObject) {
+                if (!current)
+                    ++count;
+                t->buckets[i].storeRelease(index);
+                return;
+            }
+        }
+    }
+
+    Table *grow(Table *old)
+    {
+        tables.push_back(std::make_unique<Table>(old ? 2 * (old->mask + 1) : 64));
+        Table *t = tables.back().get();
+        count = 0;
+        if (old) {
+            for (size_t i = 0; i <= old->mask; ++i) {
+                if (QMetaMethodIndex *index = old->buckets[i].loadRelaxed())
+                    place(t, index);
+            }
+        }
+        table.storeRelease(t);
+        return t;
+    }
+
+    QAtomicPointer<Table> table;
+    QMutex mutex;
+    size_t count = 0;
+    std::vector<std::unique_ptr<Table>> tables;
+    std::vector<std::unique_ptr<QMetaMethodIndex>> indexes;
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QMetaMethodIndexRegistry, metaMethodIndexRegistry)
+
+/*!
+    \internal
+
+    Returns the absolute index of the method with the normalized
+    \a signature in \a m, using an index of all method signatures that is
+    built on first use and shared between threads. Returns -1 if the
+    signature is not in the index; the caller must then fall back to
+    indexOfMethodRelative(), which also matches signatures that spell
+    argument types differently.
+*/
+int QMetaObjectPrivate::cachedIndexOfMethod(const QMetaObject *m, const char *signature)
+{
+    // the methods of these can change at any time
+    if (priv(m->d.data)->flags & DynamicMetaObject)
+        return -1;
+    if (!isMocGenerated(m))
+        return -1;
+    QMetaMethodIndexRegistry *registry = metaMethodIndexRegistry();
+    if (!registry)
+        return -1;
+    const QMetaMethodIndex *index = registry->find(m);
+    if (!index || !index->isFor(m))
+        index = registry->insert(m);
+    return index->methods.value(QByteArray::fromRawData(signature, int(qstrlen(signature))), -1);
+}
+
 /*!
     \since 4.5
 
@@ -669,6 +839,9 @@ int QMetaObject::indexOfMethod(const char *method) const
     const QMetaObject *m = this;
     int i;
     Q_ASSERT(priv(m->d.data)->revision >= 7);
+    i = QMetaObjectPrivate::cachedIndexOfMethod(m, method);
+    if (i >= 0)
+        return i;
     QArgumentTypeArray types;
     QByteArray name = QMetaObjectPrivate::decodeMethodSignature(method, types);
     i = QMetaObjectPrivate::indexOfMethodRelative<0>(&m, name, types.size(), types.constData());
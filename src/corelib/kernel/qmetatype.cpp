@@ -42,7 +42,7 @@
 #include "qobjectdefs.h"
 #include "qdatetime.h"
 #include "qbytearray.h"
-#include "qreadwritelock.h"
+#include "qmutex.h"
 #include "qstring.h"
 #include "qstringlist.h"
 #include "qlist.h"
@@ -87,9 +87,13 @@
 # include "qline.h"
 #endif
 
+#include <atomic>
 #include <bitset>
+#include <memory>
 #include <new>
+#include <optional>
 #include <cstring>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -104,18 +108,241 @@ struct DefinedTypesFilter {
     };
 };
 
+// Hash table for the registries below, which are looked up far more often
+// than they are modified. Lookups never lock; modifications must be
+// serialized by the owner.
+//
+// Readers hold a ReadGuard while they use a node, which increments one of
+// a few padded counters. Nodes and bucket arrays that modifications unlink
+// are retired, and freed by a later modification once every counter has
+// been seen at zero after they were unlinked: a reader that was not counted
+// then can only have started afterwards, when they were no longer
+// reachable. Modifications never wait for readers, so a converter may
+// register another one while it is running.
+template <typename Key, typename T>
+class QMetaTypeReadMostlyHash
+{
+    struct Node
+    {
+        Key key;
+        T value;
+    };
+
+    struct Table
+    {
+        explicit Table(size_t capacity)
+            : buckets(new QAtomicPointer<Node>[capacity]), mask(capacity - 1)
+        {}
+
+        std::unique_ptr<QAtomicPointer<Node>[]> buckets;
+        size_t mask;
+    };
+
+    static constexpr int ReaderStripes = 16;
+    struct alignas(64) ReaderCount
+    {
+        QAtomicInt count;
+    };
+
+public:
+    Q_DISABLE_COPY_MOVE(QMetaTypeReadMostlyHash)
+    QMetaTypeReadMostlyHash() = default;
+
+    ~QMetaTypeReadMostlyHash()
+    {
+        if (Table *t = table.loadRelaxed()) {
+            for (size_t i = 0; i <= t->mask; ++i) {
+                Node *node = t->buckets[i].loadRelaxed();
+                if (node != &removed)
+                    delete node;
+            }
+            delete t;
+        }
+    }
+
+    class ReadGuard
+    {
+        Q_DISABLE_COPY_MOVE(ReadGuard)
+        QAtomicInt &count;
+    public:
+        explicit ReadGuard(const QMetaTypeReadMostlyHash &hash)
+            : count(hash.readerCountForCurrentThread())
+        { count.ref(); }
+        ~ReadGuard()
+        { count.deref(); }
+    };
+
+    // The returned pointer may only be used while holding a ReadGuard, or
+    // by the thread doing modifications.
+    const T *find(const Key &key) const
+    {
+        const Table *t = table.loadAcquire();
+        if (!t)
+            return nullptr;
+        for (size_t i = qHash(key) & t->mask; ; i = (i + 1) & t->mask) {
+            const Node *node = t->buckets[i].loadAcquire();
+            if (!node)
+                return nullptr;
+            if (node != &removed && node->key == key)
+                return &node->value;
+        }
+    }
+
+    T value(const Key &key) const
+    {
+        const ReadGuard guard(*this);
+        const T *v = find(key);
+        return v ? *v : T();
+    }
+
+    bool insert(const Key &key, const T &value)
+    {
+        if (find(key))
+            return false;
+        reclaim();
+        Table *t = table.loadRelaxed();
+        if (!t || 2 * (used + 1) > t->mask + 1)
+            t = rehash(t);
+        place(t, new Node{ key, value });
+        ++live;
+        return true;
+    }
+
+    template <typename Predicate>
+    void removeIf(Predicate pred)
+    {
+        Table *t = table.loadRelaxed();
+        if (!t)
+            return;
+        for (size_t i = 0; i <= t->mask; ++i) {
+            Node *node = t->buckets[i].loadRelaxed();
+            if (node && node != &removed && pred(node->key, node->value)) {
+                t->buckets[i].storeRelease(&removed);
+                retiredNodes.emplace_back(node);
+                --live;
+            }
+        }
+        reclaim();
+    }
+
+    void remove(const Key &key)
+    {
+        removeIf([&key](const Key &k, const T &) { return k == key; });
+    }
+
+    // for the auto test
+    size_t retiredCount() const
+    { return retiredNodes.size() + retiredTables.size(); }
+
+private:
+    QAtomicInt &readerCountForCurrentThread() const
+    {
+        // spread the threads over the counters, so that they do not all
+        // contend on the same cache line
+        static thread_local const char marker = 0;
+        return readers[(quintptr(&marker) >> 6) % ReaderStripes].count;
+    }
+
+    void reclaim()
+    {
+        if (retiredNodes.empty() && retiredTables.empty())
+            return;
+        // orders the unlinking before the checks below, against the
+        // ordered increment in ReadGuard
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (const ReaderCount &reader : readers) {
+            if (reader.count.loadAcquire())
+                return;
+        }
+        retiredNodes.clear();
+        retiredTables.clear();
+    }
+
+    void place(Table *t, Node *node)
+    {
+        for (size_t i = qHash(node->key) & t->mask; ; i = (i + 1) & t->mask) {
+            const Node *current = t->buckets[i].loadRelaxed();
+            if (!current || current == &removed) {
+                if (!current)
+                    ++used;
+                t->buckets[i].storeRelease(node);
+                return;
+            }
+        }
+    }
+
+    Table *rehash(Table *old)
+    {
+        size_t capacity = 16;
+        while (capacity < 4 * (live + 1))
+            capacity *= 2;
+        Table *t = new Table(capacity);
+        used = 0;
+        if (old) {
+            for (size_t i = 0; i <= old->mask; ++i) {
+                Node *node = old->buckets[i].loadRelaxed();
+                if (node && node != &removed)
+                    place(t, node);
+            }
+            retiredTables.emplace_back(old);
+        }
+        table.storeRelease(t);
+        return t;
+    }
+
+    QAtomicPointer<Table> table;
+    Node removed = {};
+    size_t used = 0;    // buckets that are not empty, including removed ones
+    size_t live = 0;
+    mutable ReaderCount readers[ReaderStripes];
+    std::vector<std::unique_ptr<Node>> retiredNodes;
+    std::vector<std::unique_ptr<Table>> retiredTables;
+};
+
 struct QMetaTypeCustomRegistry
 {
-    QReadWriteLock lock;
-    QList<const QtPrivate::QMetaTypeInterface *> registry;
-    QHash<QByteArray, const QtPrivate::QMetaTypeInterface *> aliases;
+    // Only serializes modifications, lookups by id or name do not lock.
+    QMutex lock;
+    QMetaTypeReadMostlyHash<QByteArray, const QtPrivate::QMetaTypeInterface *> aliases;
     // index of first empty (unregistered) type in registry, if any.
     int firstEmpty = 0;
+    int size = 0;
+
+    // The registered types by index, i.e. id - QMetaType::User - 1. They
+    // are stored in chunks that never move once allocated.
+    static constexpr int ChunkSize = 1024;
+    static constexpr int MaxChunks = 1024;
+    using Entry = QAtomicPointer<const QtPrivate::QMetaTypeInterface>;
+    QAtomicPointer<Entry> chunks[MaxChunks];
+
+    ~QMetaTypeCustomRegistry()
+    {
+        for (auto &chunk : chunks)
+            delete[] chunk.loadRelaxed();
+    }
+
+    const QtPrivate::QMetaTypeInterface *at(int idx) const
+    {
+        if (idx < 0 || idx >= ChunkSize * MaxChunks)
+            return nullptr;
+        const Entry *chunk = chunks[idx / ChunkSize].loadAcquire();
+        return chunk ? chunk[idx % ChunkSize].loadAcquire() : nullptr;
+    }
+
+    Entry &entry(int idx)
+    {
+        Entry *chunk = chunks[idx / ChunkSize].loadRelaxed();
+        if (!chunk) {
+            chunk = new Entry[ChunkSize];
+            chunks[idx / ChunkSize].storeRelease(chunk);
+        }
+        return chunk[idx % ChunkSize];
+    }
 
     int registerCustomType(const QtPrivate::QMetaTypeInterface *ti)
     {
         {
-            QWriteLocker l(&lock);
+            QMutexLocker l(&lock);
             if (ti->typeId)
                 return ti->typeId;
             QByteArray name =
@@ -127,17 +354,14 @@ struct QMetaTypeCustomRegistry
                 ti->typeId.storeRelaxed(ti2->typeId.loadRelaxed());
                 return ti2->typeId;
             }
-            aliases[name] = ti;
-            int size = registry.size();
-            while (firstEmpty < size && registry[firstEmpty])
+            aliases.insert(name, ti);
+            while (firstEmpty < size && at(firstEmpty))
                 ++firstEmpty;
-            if (firstEmpty < size) {
-                registry[firstEmpty] = ti;
-                ++firstEmpty;
-            } else {
-                registry.append(ti);
-                firstEmpty = registry.size();
-            }
+            if (firstEmpty == ChunkSize * MaxChunks)
+                qFatal("QMetaType: Too many custom types registered");
+            entry(firstEmpty).storeRelease(ti);
+            ++firstEmpty;
+            size = std::max(size, firstEmpty);
             ti->typeId = firstEmpty + QMetaType::User;
         }
         if (ti->legacyRegisterOp)
@@ -150,28 +374,23 @@ struct QMetaTypeCustomRegistry
         if (!id)
             return;
         Q_ASSERT(id > QMetaType::User);
-        QWriteLocker l(&lock);
+        QMutexLocker l(&lock);
         int idx = id - QMetaType::User - 1;
-        auto &ti = registry[idx];
+        const QtPrivate::QMetaTypeInterface *ti = at(idx);
 
         // We must unregister all names.
-        auto it = aliases.begin();
-        while (it != aliases.end()) {
-            if (it.value() == ti)
-                it = aliases.erase(it);
-            else
-                ++it;
-        }
+        aliases.removeIf([ti](const QByteArray &, const QtPrivate::QMetaTypeInterface *iface) {
+            return iface == ti;
+        });
 
-        ti = nullptr;
+        entry(idx).storeRelease(nullptr);
 
         firstEmpty = std::min(firstEmpty, idx);
     }
 
-    const QtPrivate::QMetaTypeInterface *getCustomType(int id)
+    const QtPrivate::QMetaTypeInterface *getCustomType(int id) const
     {
-        QReadLocker l(&lock);
-        return registry.value(id - QMetaType::User - 1);
+        return at(id - QMetaType::User - 1);
     }
 };
 
@@ -1520,47 +1739,53 @@ static const QMetaTypeModuleHelper *qModuleHelperForType(int type)
     return nullptr;
 }
 
+// Converter and view functions per (from, to) pair. Looking a function up
+// and calling it does not lock, and the function stays valid during the
+// call even if it is unregistered concurrently.
 template<typename T, typename Key>
 class QMetaTypeFunctionRegistry
 {
 public:
-    ~QMetaTypeFunctionRegistry()
+    bool contains(Key k) const
     {
-        const QWriteLocker locker(&lock);
-        map.clear();
+        const typename Map::ReadGuard guard(map);
+        return map.find(k) != nullptr;
     }
 
-    bool contains(Key k) const
+    bool insertIfNotContains(Key k, const T &f)
     {
-        const QReadLocker locker(&lock);
-        return map.contains(k);
+        const QMutexLocker locker(&lock);
+        return map.insert(k, f);
     }
 
-    bool insertIfNotContains(Key k, const T &f)
+    // Returns the result of the function registered for \a k, or
+    // std::nullopt if there is none.
+    template <typename From, typename To>
+    std::optional<bool> call(Key k, From from, To to) const
     {
-        const QWriteLocker locker(&lock);
-        if (map.contains(k))
-            return false;
-        map.insert(k, f);
-        return true;
+        const typename Map::ReadGuard guard(map);
+        if (const T *f = map.find(k))
+            return (*f)(from, to);
+        return std::nullopt;
     }
 
-    const T *function(Key k) const
+    // for the auto test
+    size_t retiredCount() const
     {
-        const QReadLocker locker(&lock);
-        auto it = map.find(k);
-        return it == map.end() ? nullptr : std::addressof(*it);
+        const QMutexLocker locker(&lock);
+        return map.retiredCount();
     }
 
     void remove(int from, int to)
     {
         const Key k(from, to);
-        const QWriteLocker locker(&lock);
+        const QMutexLocker locker(&lock);
         map.remove(k);
     }
 private:
-    mutable QReadWriteLock lock;
-    QHash<Key, T> map;
+    using Map = QMetaTypeReadMostlyHash<Key, T>;
+    mutable QMutex lock;
+    Map map;
 };
 
 typedef QMetaTypeFunctionRegistry<QMetaType::ConverterFunction,QPair<int,int> >
@@ -1568,6 +1793,14 @@ QMetaTypeConverterRegistry;
 
 Q_GLOBAL_STATIC(QMetaTypeConverterRegistry, customTypesConversionRegistry)
 
+#ifdef QT_BUILD_INTERNAL
+// unlinked converter entries that have not been freed yet
+Q_AUTOTEST_EXPORT size_t qt_metaTypeConverterRegistryRetiredCount()
+{
+    return customTypesConversionRegistry()->retiredCount();
+}
+#endif
+
 using QMetaTypeMutableViewRegistry
         = QMetaTypeFunctionRegistry<QMetaType::MutableViewFunction, QPair<int,int>>;
 Q_GLOBAL_STATIC(QMetaTypeMutableViewRegistry, customTypesMutableViewRegistry)
@@ -1920,14 +2153,12 @@ static bool convertIterableToVariantHash(QMetaType fromType, const void *from, v
 
 static bool convertIterableToVariantPair(QMetaType fromType, const void *from, void *to)
 {
-    const QMetaType::ConverterFunction * const f =
-        customTypesConversionRegistry()->function(qMakePair(fromType.id(),
-                                                            qMetaTypeId<QtMetaTypePrivate::QPairVariantInterfaceImpl>()));
-    if (!f)
-        return false;
-
     QtMetaTypePrivate::QPairVariantInterfaceImpl pi;
-    (*f)(from, &pi);
+    if (!customTypesConversionRegistry()->call(qMakePair(fromType.id(),
+                                                         qMetaTypeId<QtMetaTypePrivate::QPairVariantInterfaceImpl>()),
+                                               from, &pi)) {
+        return false;
+    }
 
     QVariant v1(pi._metaType_first);
     void *dataPtr;
@@ -2184,10 +2415,8 @@ bool QMetaType::convert(QMetaType fromType, const void *from, QMetaType toType,
         if (moduleHelper->convert(from, fromTypeId, to, toTypeId))
             return true;
     }
-    const QMetaType::ConverterFunction * const f =
-        customTypesConversionRegistry()->function(qMakePair(fromTypeId, toTypeId));
-    if (f)
-        return (*f)(from, to);
+    if (auto result = customTypesConversionRegistry()->call(qMakePair(fromTypeId, toTypeId), from, to))
+        return *result;
 
     if (fromType.flags() & QMetaType::IsEnumeration)
         return convertFromEnum(fromType, from, toType, to);
@@ -2240,10 +2469,8 @@ bool QMetaType::view(QMetaType fromType, void *from, QMetaType toType, void *to)
     int fromTypeId = fromType.id();
     int toTypeId = toType.id();
 
-    const QMetaType::MutableViewFunction * const f =
-        customTypesMutableViewRegistry()->function(qMakePair(fromTypeId, toTypeId));
-    if (f)
-        return (*f)(from, to);
+    if (auto result = customTypesMutableViewRegistry()->call(qMakePair(fromTypeId, toTypeId), from, to))
+        return *result;
 
 #ifndef QT_BOOTSTRAPPED
     if (toTypeId == qMetaTypeId<QSequentialIterable>())
@@ -2283,9 +2510,7 @@ bool QMetaType::canView(QMetaType fromType, QMetaType toType)
     if (fromTypeId == UnknownType || toTypeId == UnknownType)
         return false;
 
-    const MutableViewFunction * const f =
-        customTypesMutableViewRegistry()->function(qMakePair(fromTypeId, toTypeId));
-    if (f)
+    if (customTypesMutableViewRegistry()->contains(qMakePair(fromTypeId, toTypeId)))
         return true;
 
 #ifndef QT_BOOTSTRAPPED
@@ -2388,9 +2613,7 @@ bool QMetaType::canConvert(QMetaType fromType, QMetaType toType)
         if (moduleHelper->convert(nullptr, fromTypeId, nullptr, toTypeId))
             return true;
     }
-    const ConverterFunction * const f =
-        customTypesConversionRegistry()->function(qMakePair(fromTypeId, toTypeId));
-    if (f)
+    if (customTypesConversionRegistry()->contains(qMakePair(fromTypeId, toTypeId)))
         return true;
 
 #ifndef QT_BOOTSTRAPPED
@@ -2515,18 +2738,14 @@ static inline int qMetaTypeStaticType(const char *typeName, int length)
 
 /*
     Similar to QMetaType::type(), but only looks in the custom set of
-    types, and doesn't lock the mutex.
+    types.
 
 */
 static int qMetaTypeCustomType_unlocked(const char *typeName, int length)
 {
     if (auto reg = customTypeRegistry()) {
-#if QT_CONFIG(thread)
-        Q_ASSERT(!reg->lock.tryLockForWrite());
-#endif
-        if (auto ti = reg->aliases.value(QByteArray(typeName, length), nullptr)) {
+        if (auto ti = reg->aliases.value(QByteArray::fromRawData(typeName, length)))
             return ti->typeId;
-        }
     }
     return QMetaType::UnknownType;
 }
@@ -2544,11 +2763,8 @@ void QMetaType::registerNormalizedTypedef(const NS(QByteArray) & normalizedTypeN
     if (!metaType.isValid())
         return;
     if (auto reg = customTypeRegistry()) {
-        QWriteLocker lock(&reg->lock);
-        auto &al = reg->aliases[normalizedTypeName];
-        if (al)
-            return;
-        al = metaType.d_ptr;
+        QMutexLocker lock(&reg->lock);
+        reg->aliases.insert(normalizedTypeName, metaType.d_ptr);
     }
 }
 
@@ -2570,7 +2786,6 @@ static inline int qMetaTypeTypeImpl(const char *typeName, int length)
         return QMetaType::UnknownType;
     int type = qMetaTypeStaticType(typeName, length);
     if (type == QMetaType::UnknownType) {
-        QReadLocker locker(&customTypeRegistry()->lock);
         type = qMetaTypeCustomType_unlocked(typeName, length);
 #ifndef QT_NO_QOBJECT
         if ((type == QMetaType::UnknownType) && tryNormalizedType) {
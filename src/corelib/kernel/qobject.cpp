@@ -158,6 +158,18 @@ static inline QBasicMutex *signalSlotLock(const QObject *o)
     return &_q_ObjectMutexPool[uint(quintptr(o)) % sizeof(_q_ObjectMutexPool)/sizeof(QBasicMutex)];
 }
 
+static QBasicMutex _q_CoalescedCallMutexPool[31];
+
+/**
+ * \internal
+ * mutex to be locked when accessing the pending call of a coalesced connection;
+ * it is never held while running user code
+ */
+static inline QBasicMutex *coalescedCallLock(const QObjectPrivate::Connection *c)
+{
+    return &_q_CoalescedCallMutexPool[uint(quintptr(c)) % sizeof(_q_CoalescedCallMutexPool)/sizeof(QBasicMutex)];
+}
+
 #if QT_VERSION < 0x60000
 extern "C" Q_CORE_EXPORT void qt_addObject(QObject *)
 {}
@@ -224,7 +236,7 @@ QObjectPrivate::~QObjectPrivate()
         }
     }
 
-    if (postedEvents)
+    if (postedEvents || inboxPostedEvents.loadAcquire())
         QCoreApplication::removePostedEvents(q_ptr, 0);
 
     thisThreadData->deref();
@@ -592,6 +604,8 @@ QMetaCallEvent::QMetaCallEvent(QtPrivate::QSlotObjectBase *slotO,
  */
 QMetaCallEvent::~QMetaCallEvent()
 {
+    if (coalescedConnection_)
+        releaseCoalescedConnection();
     if (d.nargs_) {
         QMetaType *t = types();
         for (int i = 0; i < d.nargs_; ++i) {
@@ -610,6 +624,11 @@ QMetaCallEvent::~QMetaCallEvent()
  */
 void QMetaCallEvent::placeMetaCall(QObject *object)
 {
+    // from now on, emissions of a coalesced connection queue a new call
+    // instead of updating our arguments
+    if (coalescedConnection_)
+        releaseCoalescedConnection();
+
     if (d.slotObj_) {
         d.slotObj_->call(object, d.args_);
     } else if (d.callFunction_ && d.method_offset_ <= object->metaObject()->methodOffset()) {
@@ -620,6 +639,37 @@ void QMetaCallEvent::placeMetaCall(QObject *object)
     }
 }
 
+/*!
+    \internal
+
+    Makes this event the pending call of the coalesced connection \a c, so
+    that further emissions replace its arguments until it is delivered. Must
+    be called with coalescedCallLock(c) held.
+ */
+void QMetaCallEvent::setCoalescedConnection(QObjectPrivate::Connection *c)
+{
+    Q_ASSERT(!coalescedConnection_);
+    Q_ASSERT(!c->pendingCall);
+    c->ref();
+    c->pendingCall = this;
+    coalescedConnection_ = c;
+}
+
+/*!
+    \internal
+ */
+void QMetaCallEvent::releaseCoalescedConnection()
+{
+    QObjectPrivate::Connection *c = coalescedConnection_;
+    coalescedConnection_ = nullptr;
+    {
+        QBasicMutexLocker locker(coalescedCallLock(c));
+        if (c->pendingCall == this)
+            c->pendingCall = nullptr;
+    }
+    c->deref();
+}
+
 /*!
     \class QSignalBlocker
     \brief Exception-safe wrapper around QObject::blockSignals().
@@ -1576,9 +1626,20 @@ void QObject::moveToThread(QThread *targetThread)
     // keep currentData alive (since we've got it locked)
     currentData->ref();
 
+    // pick up events posted without the lock, so they move along
+    QCoreApplicationPrivate::drainPostEventInbox(currentData);
+
     // move the object
     d_func()->setThreadData_helper(currentData, targetData);
 
+    // Events pushed by threads that checked the receiver's thread before it
+    // changed may still land in the inbox; wait for them and forward them
+    // (see QCoreApplicationPrivate::postEventLockFree()).
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (currentData->postEventList.inbox.pushers.loadAcquire())
+        QThread::yieldCurrentThread();
+    QCoreApplicationPrivate::drainPostEventInbox(currentData);
+
     locker.unlock();
 
     // now currentData can commit suicide if it wants to
@@ -2173,6 +2234,104 @@ void QObject::installEventFilter(QObject *obj)
     d->extraData->eventFilters.removeAll((QObject *)nullptr);
     d->extraData->eventFilters.removeAll(obj);
     d->extraData->eventFilters.prepend(obj);
+    if (!d->extraData->eventFilterTypes.isEmpty()) {
+        d->extraData->eventFilterTypes.remove(obj);
+        d->extraData->rebuildEventFilterTables();
+    }
+}
+
+/*!
+    \since 6.1
+    \overload
+
+    Installs an event filter \a filterObj on this object that is only
+    activated for events whose type is contained in \a eventTypes. The
+    list holds QEvent::Type values, including types returned by
+    QEvent::registerEventType().
+
+    Events of any other type are delivered without calling
+    \a filterObj's eventFilter() function at all, so a filter that is
+    only interested in a few event types does not add overhead to the
+    delivery of unrelated events. This matters most for filters
+    installed on the application object, which are otherwise consulted
+    for every event sent to every object in the main thread.
+
+    The relative activation order of all filters installed on this
+    object, whether restricted to some event types or not, is the same
+    as for installEventFilter(): the filter that was installed last is
+    activated first. Installing an already installed filter again
+    replaces its set of event types.
+
+    If \a eventTypes is empty, this function behaves like
+    installEventFilter(QObject *).
+
+    \sa removeEventFilter(), eventFilter()
+*/
+void QObject::installEventFilter(QObject *obj, const QList<int> &eventTypes)
+{
+    Q_D(QObject);
+    if (eventTypes.isEmpty()) {
+        installEventFilter(obj);
+        return;
+    }
+    if (!obj)
+        return;
+    if (d->threadData != obj->d_func()->threadData) {
+        qWarning("QObject::installEventFilter(): Cannot filter events for objects in a different thread.");
+        return;
+    }
+
+    if (!d->extraData)
+        d->extraData = new QObjectPrivate::ExtraData;
+
+    d->extraData->eventFilters.removeAll((QObject *)nullptr);
+    d->extraData->eventFilters.removeAll(obj);
+    d->extraData->eventFilters.prepend(obj);
+    d->extraData->eventFilterTypes.insert(obj, eventTypes);
+    d->extraData->rebuildEventFilterTables();
+}
+
+/*!
+    \internal
+
+    Recomputes the per-event-type filter lists from eventFilters and
+    eventFilterTypes, keeping the activation order of eventFilters.
+*/
+void QObjectPrivate::ExtraData::rebuildEventFilterTables()
+{
+    eventFiltersByType.clear();
+    untypedEventFilters.clear();
+
+    // forget about filters that were deleted or removed
+    QHash<QObject *, QList<int>> liveTypes;
+    for (const QPointer<QObject> &filter : qAsConst(eventFilters)) {
+        const auto it = eventFilterTypes.constFind(filter.data());
+        if (filter && it != eventFilterTypes.cend())
+            liveTypes.insert(it.key(), it.value());
+    }
+    eventFilterTypes.swap(liveTypes);
+    if (eventFilterTypes.isEmpty())
+        return;
+
+    for (const QPointer<QObject> &filter : qAsConst(eventFilters)) {
+        if (!filter)
+            continue;
+        const auto it = eventFilterTypes.constFind(filter.data());
+        if (it == eventFilterTypes.cend()) {
+            // applies to every type, including those with their own table
+            untypedEventFilters.append(filter);
+            for (auto &list : eventFiltersByType)
+                list.append(filter);
+            continue;
+        }
+        for (int type : it.value()) {
+            auto list = eventFiltersByType.find(type);
+            if (list == eventFiltersByType.end())
+                list = eventFiltersByType.insert(type, untypedEventFilters);
+            if (!list->contains(filter))
+                list->append(filter);
+        }
+    }
 }
 
 /*!
@@ -2196,6 +2355,20 @@ void QObject::removeEventFilter(QObject *obj)
             if (d->extraData->eventFilters.at(i) == obj)
                 d->extraData->eventFilters[i] = nullptr;
         }
+        // the dispatch tables may be iterated right now, so only clear
+        // the entries; they are compacted on the next installation
+        if (!d->extraData->eventFilterTypes.isEmpty()) {
+            for (int i = 0; i < d->extraData->untypedEventFilters.count(); ++i) {
+                if (d->extraData->untypedEventFilters.at(i) == obj)
+                    d->extraData->untypedEventFilters[i] = nullptr;
+            }
+            for (auto &list : d->extraData->eventFiltersByType) {
+                for (int i = 0; i < list.count(); ++i) {
+                    if (list.at(i) == obj)
+                        list[i] = nullptr;
+                }
+            }
+        }
     }
 }
 
@@ -3340,6 +3513,9 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
 
+    const bool isCoalesced = type & Qt::CoalescedConnection;
+    type &= ~Qt::CoalescedConnection;
+
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
 
@@ -3357,6 +3533,7 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     c->argumentTypes.storeRelaxed(types);
     c->callFunction = callFunction;
     c->isSingleShot = isSingleShot;
+    c->isCoalesced = isCoalesced;
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
 
@@ -3623,6 +3800,64 @@ void QMetaObject::connectSlotsByName(QObject *o)
     }
 }
 
+/*
+    Returns a new event for a queued call of \a c, with the argument types
+    set up but the arguments themselves (except for the return value) left
+    for the caller to fill in.
+*/
+static QMetaCallEvent *newQueuedCallEvent(QObject *sender, int signal, QObjectPrivate::Connection *c,
+                                          int nargs, const int *argumentTypes)
+{
+    QMetaCallEvent *ev = c->isSlotObject ?
+        new QMetaCallEvent(c->slotObj, sender, signal, nargs) :
+        new QMetaCallEvent(c->method_offset, c->method_relative, c->callFunction, sender, signal, nargs);
+
+    void **args = ev->args();
+    QMetaType *types = ev->types();
+
+    types[0] = QMetaType(); // return type
+    args[0] = nullptr; // return value
+
+    for (int n = 1; n < nargs; ++n)
+        types[n] = QMetaType(argumentTypes[n - 1]);
+
+    return ev;
+}
+
+/*
+    Returns the event to post for an emission of the coalesced connection \a c,
+    or \nullptr if a call of \a c is still pending and has been given the new
+    arguments instead.
+*/
+static QMetaCallEvent *coalesceQueuedCall(QObject *sender, int signal, QObjectPrivate::Connection *c,
+                                          int nargs, const int *argumentTypes, void **argv)
+{
+    // copying may run user code, so do it before taking the lock
+    QVarLengthArray<void *, 8> copies(nargs);
+    for (int n = 1; n < nargs; ++n)
+        copies[n] = QMetaType(argumentTypes[n - 1]).create(argv[n]);
+
+    QBasicMutexLocker locker(coalescedCallLock(c));
+    if (QMetaCallEvent *pending = c->pendingCall) {
+        void **args = pending->args();
+        for (int n = 1; n < nargs; ++n)
+            qSwap(args[n], copies[n]);
+        locker.unlock();
+
+        // now holds the replaced arguments
+        for (int n = 1; n < nargs; ++n)
+            QMetaType(argumentTypes[n - 1]).destroy(copies[n]);
+        return nullptr;
+    }
+
+    QMetaCallEvent *ev = newQueuedCallEvent(sender, signal, c, nargs, argumentTypes);
+    void **args = ev->args();
+    for (int n = 1; n < nargs; ++n)
+        args[n] = copies[n];
+    ev->setCoalescedConnection(c);
+    return ev;
+}
+
 /*!
     \internal
 
@@ -3658,20 +3893,20 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
         c->slotObj->ref();
     locker.unlock();
 
-    QMetaCallEvent *ev = c->isSlotObject ?
-        new QMetaCallEvent(c->slotObj, sender, signal, nargs) :
-        new QMetaCallEvent(c->method_offset, c->method_relative, c->callFunction, sender, signal, nargs);
-
-    void **args = ev->args();
-    QMetaType *types = ev->types();
-
-    types[0] = QMetaType(); // return type
-    args[0] = nullptr; // return value
-
-    if (nargs > 1) {
-        for (int n = 1; n < nargs; ++n)
-            types[n] = QMetaType(argumentTypes[n - 1]);
-
+    QMetaCallEvent *ev = nullptr;
+    if (c->isCoalesced) {
+        ev = coalesceQueuedCall(sender, signal, c, nargs, argumentTypes, argv);
+        if (!ev) {
+            // the arguments went to the call that is still pending
+            locker.relock();
+            if (c->isSlotObject)
+                c->slotObj->destroyIfLastRef();
+            return;
+        }
+    } else {
+        ev = newQueuedCallEvent(sender, signal, c, nargs, argumentTypes);
+        void **args = ev->args();
+        QMetaType *types = ev->types();
         for (int n = 1; n < nargs; ++n)
             args[n] = types[n].create(argv[n]);
     }
@@ -4924,6 +5159,9 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
 
+    const bool isCoalesced = type & Qt::CoalescedConnection;
+    type &= ~Qt::CoalescedConnection;
+
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
 
@@ -4942,6 +5180,7 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
         c->ownArgumentTypes = false;
     }
     c->isSingleShot = isSingleShot;
+    c->isCoalesced = isCoalesced;
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
     QMetaObject::Connection ret(c.release());
@@ -190,6 +190,7 @@ public:
 
     void setParent(QObject *parent);
     void installEventFilter(QObject *filterObj);
+    void installEventFilter(QObject *filterObj, const QList<int> &eventTypes);
     void removeEventFilter(QObject *obj);
 
     static QMetaObject::Connection connect(const QObject *sender, const char *signal,
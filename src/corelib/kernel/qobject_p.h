@@ -54,6 +54,7 @@
 
 #include <QtCore/private/qglobal_p.h>
 #include "QtCore/qcoreevent.h"
+#include "QtCore/qhash.h"
 #include "QtCore/qlist.h"
 #include "QtCore/qobject.h"
 #include "QtCore/qpointer.h"
@@ -67,6 +68,7 @@ QT_BEGIN_NAMESPACE
 class QVariant;
 class QThreadData;
 class QObjectConnectionListVector;
+class QMetaCallEvent;
 namespace QtSharedPointer { struct ExternalRefCountData; }
 
 /* for Qt Test */
@@ -109,6 +111,22 @@ public:
         QList<int> runningTimers;
         QList<QPointer<QObject>> eventFilters;
         QString objectName;
+
+        // Filters installed for a restricted set of event types. The dispatch
+        // tables hold, per event type, every filter that applies to it in
+        // activation order; untypedEventFilters serves all other types.
+        QHash<QObject *, QList<int>> eventFilterTypes;
+        QHash<int, QList<QPointer<QObject>>> eventFiltersByType;
+        QList<QPointer<QObject>> untypedEventFilters;
+
+        void rebuildEventFilterTables();
+        const QList<QPointer<QObject>> &eventFiltersFor(int type) const
+        {
+            if (eventFilterTypes.isEmpty())
+                return eventFilters;
+            const auto it = eventFiltersByType.constFind(type);
+            return it == eventFiltersByType.cend() ? untypedEventFilters : *it;
+        }
     };
 
     typedef void (*StaticMetaCallFunction)(QObject *, QMetaObject::Call, int, void **);
@@ -159,6 +177,9 @@ public:
         ushort isSlotObject : 1;
         ushort ownArgumentTypes : 1;
         ushort isSingleShot : 1;
+        ushort isCoalesced : 1;
+        // queued call of a coalesced connection that has not been delivered yet
+        QMetaCallEvent *pendingCall = nullptr;
         Connection() : ref_(2), ownArgumentTypes(true) {
             //ref_ is 2 for the use in the internal lists, and for the use in QMetaObject::Connection
         }
@@ -390,6 +411,10 @@ public:
     // these objects are all used to indicate that a QObject was deleted
     // plus QPointer, which keeps a separate list
     QAtomicPointer<QtSharedPointer::ExternalRefCountData> sharedRefcount;
+
+    // events posted to this object that are still in the inbox of a post
+    // event list; they move into QObjectData::postedEvents when drained
+    QAtomicInt inboxPostedEvents;
 };
 
 Q_DECLARE_TYPEINFO(QObjectPrivate::ConnectionList, Q_RELOCATABLE_TYPE);
@@ -562,8 +587,11 @@ public:
 
     virtual void placeMetaCall(QObject *object) override;
 
+    void setCoalescedConnection(QObjectPrivate::Connection *c);
+
 private:
     inline void allocArgs();
+    void releaseCoalescedConnection();
 
     struct Data {
         QtPrivate::QSlotObjectBase *slotObj_;
@@ -573,6 +601,7 @@ private:
         ushort method_offset_;
         ushort method_relative_;
     } d;
+    QObjectPrivate::Connection *coalescedConnection_ = nullptr;
     // preallocate enough space for three arguments
     alignas(void *) char prealloc_[3 * sizeof(void *) + 3 * sizeof(QMetaType)];
 };
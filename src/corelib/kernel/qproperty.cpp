@@ -40,9 +40,12 @@
 #include "qproperty.h"
 #include "qproperty_p.h"
 
+#include <qhash.h>
 #include <qscopedvaluerollback.h>
 #include <QScopeGuard>
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 using namespace QtPrivate;
@@ -125,6 +128,62 @@ void QPropertyBindingPrivate::markDirtyAndNotifyObservers()
         staticObserverCallback(propertyDataPtr);
 }
 
+/*!
+    \internal
+    Marks this binding and everything depending on it dirty on behalf of a
+    property update group, without evaluating anything. Bindings that were
+    not dirty yet are appended to \a pending, so that their observers can be
+    notified once the group ends.
+*/
+void QPropertyBindingPrivate::markDirtyDeferred(std::vector<QPropertyBindingPrivatePtr> *pending)
+{
+    if (dirty)
+        return;
+    dirty = true;
+    if (!pendingGroupNotification) {
+        pendingGroupNotification = true;
+        pending->emplace_back(this);
+    }
+    if (firstObserver)
+        firstObserver.markDirtyDeferred(pending);
+}
+
+/*!
+    \internal
+    Delivers the notifications held back by markDirtyDeferred(). Bindings
+    nobody listens to are left dirty and stay lazily evaluated.
+*/
+void QPropertyBindingPrivate::notifyDeferred()
+{
+    if (!pendingGroupNotification)
+        return;
+    pendingGroupNotification = false;
+    bool changed = changedInGroup;
+    changedInGroup = false;
+    if (!propertyDataPtr)
+        return;
+
+    if (dirty) {
+        bool hasChangeHandler = false;
+        for (auto observer = firstObserver; observer && !hasChangeHandler; observer = observer.nextObserver())
+            hasChangeHandler = observer.ptr->next.tag() == QPropertyObserver::ObserverNotifiesChangeHandler;
+        if (!hasChangeHandler && !hasStaticObserver && !requiresEagerEvaluation())
+            return;
+        if (evaluateIfDirtyAndReturnTrueIfValueChanged(propertyDataPtr))
+            changed = true;
+    }
+    if (!changed)
+        return;
+
+    eagerlyUpdating = true;
+    QScopeGuard guard([&](){eagerlyUpdating = false;});
+    // Dependent bindings were marked dirty along with this one.
+    if (firstObserver)
+        firstObserver.notifyChangeHandlers(propertyDataPtr);
+    if (hasStaticObserver)
+        staticObserverCallback(propertyDataPtr);
+}
+
 bool QPropertyBindingPrivate::evaluateIfDirtyAndReturnTrueIfValueChanged_helper(const QUntypedPropertyData *data, QBindingStatus *status)
 {
     Q_ASSERT(dirty);
@@ -161,6 +220,8 @@ bool QPropertyBindingPrivate::evaluateIfDirtyAndReturnTrueIfValueChanged_helper(
     }
 
     dirty = false;
+    if (changed && pendingGroupNotification)
+        changedInGroup = true;
     return changed;
 }
 
@@ -374,8 +435,172 @@ void QPropertyBindingData::registerWithCurrentlyEvaluatingBinding_helper(Binding
     dependencyObserver.observeProperty(d);
 }
 
+namespace {
+struct QPropertyUpdateGroup
+{
+    struct PendingProperty
+    {
+        QUntypedPropertyData *property;
+        const QPropertyBindingData *bindingData;
+        QPropertyObserverCallback callback;
+    };
+
+    int nesting = 0;
+    QList<PendingProperty> properties;
+    QHash<QUntypedPropertyData *, qsizetype> propertyIndex;
+    std::vector<QPropertyBindingPrivatePtr> bindings;
+};
+}
+
+// Not owning, trivially constructible so that checking it is cheap.
+static thread_local QPropertyUpdateGroup *currentPropertyUpdateGroup = nullptr;
+
+static void deferNotification(QPropertyUpdateGroup *group, QUntypedPropertyData *property,
+                              const QPropertyBindingData *bindingData,
+                              QPropertyObserverCallback callback)
+{
+    auto it = group->propertyIndex.constFind(property);
+    if (it == group->propertyIndex.constEnd()) {
+        group->propertyIndex.insert(property, group->properties.size());
+        group->properties.append({ property, bindingData, callback });
+    } else {
+        auto &pending = group->properties[*it];
+        if (bindingData)
+            pending.bindingData = bindingData;
+        if (callback)
+            pending.callback = callback;
+    }
+
+    if (bindingData) {
+        QPropertyBindingDataPointer d{bindingData};
+        if (QPropertyObserverPointer observer = d.firstObserver())
+            observer.markDirtyDeferred(&group->bindings);
+    }
+}
+
+bool QtPrivate::deferNotificationToPropertyUpdateGroup(QUntypedPropertyData *property,
+                                                       const QPropertyBindingData *bindingData,
+                                                       QPropertyObserverCallback callback)
+{
+    QPropertyUpdateGroup *group = currentPropertyUpdateGroup;
+    if (!group)
+        return false;
+    deferNotification(group, property, bindingData, callback);
+    return true;
+}
+
+/*!
+    \since 6.1
+    \relates QProperty
+
+    Marks the beginning of a property update group. Inside this group,
+    changing a property neither immediately updates any dependent
+    properties nor triggers change notifications. Those are instead
+    deferred until the group is ended by a call to endPropertyUpdateGroup.
+
+    Dependent bindings are only marked dirty while the group is open. When
+    the group ends, every binding that was dirtied is evaluated at most once,
+    and only if a change handler, a notification signal or a compat property
+    needs its value. Change handlers and notification signals are called at
+    most once per property, no matter how often it was written or how many
+    of its dependencies changed. This avoids repeatedly re-evaluating shared
+    dependents when several properties of an object are updated at once.
+
+    Groups can be nested. In that case, the deferral ends only after the
+    outermost group has been ended.
+
+    \note Change notifications are only sent after all property values
+    affected by the group have been updated to their new values. This
+    allows re-establishing a class invariant if multiple properties need to be
+    updated, preventing any external observer from noticing an inconsistent
+    state.
+
+    \note Properties that are written inside a group must outlive it.
+
+    \sa Qt::endPropertyUpdateGroup, QScopedPropertyUpdateGroup
+*/
+void Qt::beginPropertyUpdateGroup()
+{
+    if (!currentPropertyUpdateGroup)
+        currentPropertyUpdateGroup = new QPropertyUpdateGroup;
+    ++currentPropertyUpdateGroup->nesting;
+}
+
+/*!
+    \since 6.1
+    \relates QProperty
+
+    Ends a property update group. If the outermost group has been ended,
+    the deferred binding evaluations and notifications happen now.
+
+    \warning Calling endPropertyUpdateGroup without a preceding call to
+    beginPropertyUpdateGroup results in undefined behavior.
+
+    \sa Qt::beginPropertyUpdateGroup, QScopedPropertyUpdateGroup
+*/
+void Qt::endPropertyUpdateGroup()
+{
+    QPropertyUpdateGroup *group = currentPropertyUpdateGroup;
+    Q_ASSERT_X(group, "endPropertyUpdateGroup",
+               "endPropertyUpdateGroup called without any preceding beginPropertyUpdateGroup");
+    if (--group->nesting)
+        return;
+
+    // Notifications below may open a new group, or write properties that
+    // must not be deferred to this one any more.
+    std::unique_ptr<QPropertyUpdateGroup> finished(group);
+    currentPropertyUpdateGroup = nullptr;
+
+    // Dependent bindings were already marked dirty while the group was open,
+    // so only change handlers and notification signals are left to call.
+    for (const auto &pending : qAsConst(finished->properties)) {
+        if (pending.bindingData) {
+            QPropertyBindingDataPointer d{pending.bindingData};
+            if (QPropertyObserverPointer observer = d.firstObserver())
+                observer.notifyChangeHandlers(pending.property);
+        }
+        if (pending.callback)
+            pending.callback(pending.property);
+    }
+    // Then evaluate the dirty bindings somebody is interested in, once each.
+    for (const auto &binding : finished->bindings)
+        static_cast<QPropertyBindingPrivate *>(binding.data())->notifyDeferred();
+}
+
+/*!
+    \class QScopedPropertyUpdateGroup
+    \inmodule QtCore
+    \ingroup tools
+    \since 6.1
+
+    \brief RAII class around Qt::beginPropertyUpdateGroup()/Qt::endPropertyUpdateGroup().
+
+    This class calls Qt::beginPropertyUpdateGroup() in its constructor and
+    Qt::endPropertyUpdateGroup() in its destructor, making sure the latter
+    function is reliably called even in the presence of early returns or
+    thrown exceptions.
+
+    \sa Qt::beginPropertyUpdateGroup(), Qt::endPropertyUpdateGroup(), QProperty
+*/
+
+/*!
+    \fn QScopedPropertyUpdateGroup::QScopedPropertyUpdateGroup()
+
+    Calls Qt::beginPropertyUpdateGroup().
+*/
+
+/*!
+    \fn QScopedPropertyUpdateGroup::~QScopedPropertyUpdateGroup()
+
+    Calls Qt::endPropertyUpdateGroup().
+*/
+
 void QPropertyBindingData::notifyObservers(QUntypedPropertyData *propertyDataPtr) const
 {
+    if (QPropertyUpdateGroup *group = currentPropertyUpdateGroup) {
+        deferNotification(group, propertyDataPtr, this, nullptr);
+        return;
+    }
     QPropertyBindingDataPointer d{this};
     if (QPropertyObserverPointer observer = d.firstObserver())
         observer.notify(d.bindingPtr(), propertyDataPtr);
@@ -586,6 +811,39 @@ void QPropertyObserverPointer::notify(QPropertyBindingPrivate *triggeringBinding
     }
 }
 
+/*! \internal
+  Like notify() with a value known to have changed, but only calls change
+  handlers and leaves dependent bindings alone.
+ */
+void QPropertyObserverPointer::notifyChangeHandlers(QUntypedPropertyData *propertyDataPtr)
+{
+    auto observer = const_cast<QPropertyObserver*>(ptr);
+    while (observer) {
+        QPropertyObserver *next = observer->next.data();
+        if (QPropertyObserver::ObserverTag(observer->next.tag()) == QPropertyObserver::ObserverNotifiesChangeHandler) {
+            auto handlerToCall = observer->changeHandler;
+            // prevent recursion
+            if (next && next->next.tag() == QPropertyObserver::ObserverIsPlaceholder) {
+                observer = next->next.data();
+                continue;
+            }
+            QPropertyObserverNodeProtector protector(observer);
+            handlerToCall(observer, propertyDataPtr);
+            next = protector.next();
+        }
+        observer = next;
+    }
+}
+
+void QPropertyObserverPointer::markDirtyDeferred(std::vector<QPropertyBindingPrivatePtr> *pending)
+{
+    // Only flags are changed, so the list cannot be modified while walking it.
+    for (auto observer = *this; observer; observer = observer.nextObserver()) {
+        if (observer.ptr->next.tag() == QPropertyObserver::ObserverNotifiesBinding)
+            observer.ptr->bindingToMarkDirty->markDirtyDeferred(pending);
+    }
+}
+
 void QPropertyObserverPointer::observeProperty(QPropertyBindingDataPointer property)
 {
     if (ptr->prev)
@@ -50,11 +50,13 @@
 #include <QtCore/qpropertyprivate.h>
 
 #if __has_include(<source_location>) && __cplusplus >= 202002L && !defined(Q_CLANG_QDOC)
-#include <experimental/source_location>
+#include <source_location>
+#define QT_SOURCE_LOCATION_NAMESPACE std
 #define QT_PROPERTY_COLLECT_BINDING_LOCATION
 #define QT_PROPERTY_DEFAULT_BINDING_LOCATION QPropertyBindingSourceLocation(std::source_location::current())
 #elif __has_include(<experimental/source_location>) && __cplusplus >= 201703L && !defined(Q_CLANG_QDOC)
 #include <experimental/source_location>
+#define QT_SOURCE_LOCATION_NAMESPACE std::experimental
 #define QT_PROPERTY_COLLECT_BINDING_LOCATION
 #define QT_PROPERTY_DEFAULT_BINDING_LOCATION QPropertyBindingSourceLocation(std::experimental::source_location::current())
 #else
@@ -97,7 +99,7 @@ struct Q_CORE_EXPORT QPropertyBindingSourceLocation
     quint32 column = 0;
     QPropertyBindingSourceLocation() = default;
 #ifdef QT_PROPERTY_COLLECT_BINDING_LOCATION
-    QPropertyBindingSourceLocation(const std::experimental::source_location &cppLocation)
+    QPropertyBindingSourceLocation(const QT_SOURCE_LOCATION_NAMESPACE::source_location &cppLocation)
     {
         fileName = cppLocation.file_name();
         functionName = cppLocation.function_name();
@@ -197,8 +199,21 @@ namespace Qt {
     {
         return QPropertyBinding<std::invoke_result_t<Functor>>(std::forward<Functor>(f), location);
     }
+
+    Q_CORE_EXPORT void beginPropertyUpdateGroup();
+    Q_CORE_EXPORT void endPropertyUpdateGroup();
 }
 
+class QScopedPropertyUpdateGroup
+{
+    Q_DISABLE_COPY_MOVE(QScopedPropertyUpdateGroup)
+public:
+    QScopedPropertyUpdateGroup()
+    { Qt::beginPropertyUpdateGroup(); }
+    ~QScopedPropertyUpdateGroup() noexcept(false)
+    { Qt::endPropertyUpdateGroup(); }
+};
+
 struct QPropertyObserverPrivate;
 struct QPropertyObserverPointer;
 class QPropertyObserver;
@@ -830,6 +845,10 @@ namespace QtPrivate {
 
 struct BindingEvaluationState;
 struct CompatPropertySafePoint;
+
+Q_CORE_EXPORT bool deferNotificationToPropertyUpdateGroup(QUntypedPropertyData *property,
+                                                          const QPropertyBindingData *bindingData,
+                                                          QPropertyObserverCallback callback);
 }
 
 struct QBindingStatus
@@ -1061,6 +1080,10 @@ public:
 private:
     void notify(const QtPrivate::QPropertyBindingData *binding)
     {
+        if constexpr (HasSignal) {
+            if (QtPrivate::deferNotificationToPropertyUpdateGroup(this, binding, &signalCallBack))
+                return;
+        }
         if (binding)
             binding->notifyObservers(this);
         if constexpr (HasSignal)
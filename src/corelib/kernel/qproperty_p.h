@@ -109,6 +109,8 @@ struct QPropertyObserverPointer
     void setAliasedProperty(QUntypedPropertyData *propertyPtr);
 
     void notify(QPropertyBindingPrivate *triggeringBinding, QUntypedPropertyData *propertyDataPtr, bool knownToHaveChanged = false);
+    void notifyChangeHandlers(QUntypedPropertyData *propertyDataPtr);
+    void markDirtyDeferred(std::vector<QPropertyBindingPrivatePtr> *pending);
     void observeProperty(QPropertyBindingDataPointer property);
 
     explicit operator bool() const { return ptr != nullptr; }
@@ -181,6 +183,10 @@ private:
     // used to detect binding loops for eagerly evaluated properties
     bool eagerlyUpdating:1;
     bool isQQmlPropertyBinding:1;
+    // dirtied within a property update group, notification is still pending
+    bool pendingGroupNotification:1;
+    // evaluated to a different value while the notification was pending
+    bool changedInGroup:1;
 
     const QtPrivate::BindingFunctionVTable *vtable;
 
@@ -238,6 +244,8 @@ public:
         : hasBindingWrapper(false)
         , eagerlyUpdating(false)
         , isQQmlPropertyBinding(isQQmlPropertyBinding)
+        , pendingGroupNotification(false)
+        , changedInGroup(false)
         , vtable(vtable)
         , location(location)
         , metaType(metaType)
@@ -305,6 +313,8 @@ public:
     void unlinkAndDeref();
 
     void markDirtyAndNotifyObservers();
+    void markDirtyDeferred(std::vector<QPropertyBindingPrivatePtr> *pending);
+    void notifyDeferred();
     bool evaluateIfDirtyAndReturnTrueIfValueChanged(const QUntypedPropertyData *data, QBindingStatus *status = nullptr)
     {
         if (!dirty)
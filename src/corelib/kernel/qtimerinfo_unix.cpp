@@ -45,6 +45,7 @@
 #include "private/qtimerinfo_unix_p.h"
 #include "private/qobject_p.h"
 #include "private/qabstracteventdispatcher_p.h"
+#include "private/qeventloopstatistics_p.h"
 
 #ifdef QTIMERINFO_DEBUG
 #  include <QDebug>
@@ -53,6 +54,8 @@
 
 #include <sys/times.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 Q_CORE_EXPORT bool qt_disable_lowpriority_timers=false;
@@ -84,6 +87,7 @@ QTimerInfoList::QTimerInfoList()
 #endif
 
     firstTimerInfo = nullptr;
+    nextSequence = 0;
 }
 
 timespec QTimerInfoList::updateCurrentTime()
@@ -170,18 +174,126 @@ void QTimerInfoList::repairTimersIfNeeded()
 
 #endif
 
+static inline bool timerLessThan(const QTimerInfo *t1, const QTimerInfo *t2)
+{
+    if (t1->timeout < t2->timeout)
+        return true;
+    if (t2->timeout < t1->timeout)
+        return false;
+    return t1->sequence < t2->sequence;
+}
+
+void QTimerInfoList::heapSiftUp(qsizetype index)
+{
+    QTimerInfo *ti = at(index);
+    while (index > 0) {
+        const qsizetype parent = (index - 1) / 2;
+        QTimerInfo *p = at(parent);
+        if (!timerLessThan(ti, p))
+            break;
+        (*this)[index] = p;
+        p->heapIndex = index;
+        index = parent;
+    }
+    (*this)[index] = ti;
+    ti->heapIndex = index;
+}
+
+void QTimerInfoList::heapSiftDown(qsizetype index)
+{
+    QTimerInfo *ti = at(index);
+    const qsizetype n = size();
+    for (;;) {
+        qsizetype child = 2 * index + 1;
+        if (child >= n)
+            break;
+        if (child + 1 < n && timerLessThan(at(child + 1), at(child)))
+            ++child;
+        QTimerInfo *c = at(child);
+        if (!timerLessThan(c, ti))
+            break;
+        (*this)[index] = c;
+        c->heapIndex = index;
+        index = child;
+    }
+    (*this)[index] = ti;
+    ti->heapIndex = index;
+}
+
+/*
+  remove timer info from the heap, without touching the lookup tables
+*/
+void QTimerInfoList::heapRemove(QTimerInfo *ti)
+{
+    const qsizetype index = ti->heapIndex;
+    Q_ASSERT(at(index) == ti);
+
+    QTimerInfo *last = takeLast();
+    if (last == ti)
+        return;
+
+    (*this)[index] = last;
+    last->heapIndex = index;
+    heapSiftUp(index);
+    heapSiftDown(last->heapIndex);
+}
+
 /*
   insert timer info into list
 */
 void QTimerInfoList::timerInsert(QTimerInfo *ti)
 {
-    int index = size();
-    while (index--) {
-        const QTimerInfo * const t = at(index);
-        if (!(ti->timeout < t->timeout))
-            break;
-    }
-    insert(index+1, ti);
+    // timers with the same timeout fire in the order they were (re)inserted
+    ti->sequence = nextSequence++;
+    append(ti);
+    heapSiftUp(size() - 1);
+}
+
+/*
+  remove timer info from the list and the lookup tables, and delete it
+*/
+void QTimerInfoList::timerRemove(QTimerInfo *ti)
+{
+    heapRemove(ti);
+    timersById.remove(ti->id);
+    if (ti == firstTimerInfo)
+        firstTimerInfo = nullptr;
+    if (ti->activateRef)
+        *(ti->activateRef) = nullptr;
+    delete ti;
+}
+
+/*
+  Returns the earliest timer in the subtree rooted at \a index that is not
+  currently being activated. Only timers whose events are being delivered
+  are active, so this descends no further than the few active entries at the
+  top of the heap.
+*/
+QTimerInfo *QTimerInfoList::firstInactiveTimer(qsizetype index) const
+{
+    if (index >= size())
+        return nullptr;
+
+    QTimerInfo *t = at(index);
+    if (!t->activateRef)
+        return t;
+
+    QTimerInfo *left = firstInactiveTimer(2 * index + 1);
+    QTimerInfo *right = firstInactiveTimer(2 * index + 2);
+    if (!left || !right)
+        return left ? left : right;
+    return timerLessThan(right, left) ? right : left;
+}
+
+/*
+  Returns how many timers in the subtree rooted at \a index have expired.
+*/
+qsizetype QTimerInfoList::expiredTimerCount(qsizetype index, const timespec &currentTime) const
+{
+    if (index >= size() || currentTime < at(index)->timeout)
+        return 0;
+    return 1 + expiredTimerCount(2 * index + 1, currentTime)
+             + expiredTimerCount(2 * index + 2, currentTime);
 }
 
 inline timespec &operator+=(timespec &t1, int ms)
@@ -385,13 +497,7 @@ bool QTimerInfoList::timerWait(timespec &tm)
     repairTimersIfNeeded();
 
     // Find first waiting timer not already active
-    QTimerInfo *t = nullptr;
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (!(*it)->activateRef) {
-            t = *it;
-            break;
-        }
-    }
+    QTimerInfo *t = firstInactiveTimer(0);
 
     if (!t)
       return false;
@@ -419,16 +525,13 @@ int QTimerInfoList::timerRemainingTime(int timerId)
     repairTimersIfNeeded();
     timespec tm = {0, 0};
 
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            if (currentTime < t->timeout) {
-                // time to wait
-                tm = roundToMillisecond(t->timeout - currentTime);
-                return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
-            } else {
-                return 0;
-            }
+    if (QTimerInfo *t = timersById.value(timerId)) {
+        if (currentTime < t->timeout) {
+            // time to wait
+            tm = roundToMillisecond(t->timeout - currentTime);
+            return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
+        } else {
+            return 0;
         }
     }
 
@@ -490,6 +593,8 @@ void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType t
     }
 
     timerInsert(t);
+    timersById.insert(timerId, t);
+    timersByObject.insert(object, t);
 
 #ifdef QTIMERINFO_DEBUG
     t->expected = expected;
@@ -503,57 +608,43 @@ void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType t
 
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
-    // set timer inactive
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            // found it
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = nullptr;
-            if (t->activateRef)
-                *(t->activateRef) = nullptr;
-            delete t;
-            return true;
-        }
-    }
-    // id not found
-    return false;
+    QTimerInfo *t = timersById.value(timerId);
+    if (!t)
+        return false; // id not found
+
+    timersByObject.remove(t->obj, t);
+    timerRemove(t);
+    return true;
 }
 
 bool QTimerInfoList::unregisterTimers(QObject *object)
 {
     if (isEmpty())
         return false;
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->obj == object) {
-            // object found
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = nullptr;
-            if (t->activateRef)
-                *(t->activateRef) = nullptr;
-            delete t;
-            // move back one so that we don't skip the new current item
-            --i;
-        }
-    }
+    const auto range = timersByObject.equal_range(object);
+    for (auto it = range.first; it != range.second; ++it)
+        timerRemove(it.value());
+    timersByObject.remove(object);
     return true;
 }
 
 QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObject *object) const
 {
+    // report the timers in the order they will fire
+    QList<const QTimerInfo *> timers;
+    const auto range = timersByObject.equal_range(object);
+    for (auto it = range.first; it != range.second; ++it)
+        timers << it.value();
+    std::sort(timers.begin(), timers.end(), timerLessThan);
+
     QList<QAbstractEventDispatcher::TimerInfo> list;
-    for (int i = 0; i < count(); ++i) {
-        const QTimerInfo * const t = at(i);
-        if (t->obj == object) {
-            list << QAbstractEventDispatcher::TimerInfo(t->id,
-                                                        (t->timerType == Qt::VeryCoarseTimer
-                                                         ? t->interval * 1000
-                                                         : t->interval),
-                                                        t->timerType);
-        }
+    list.reserve(timers.size());
+    for (const QTimerInfo *t : qAsConst(timers)) {
+        list << QAbstractEventDispatcher::TimerInfo(t->id,
+                                                    (t->timerType == Qt::VeryCoarseTimer
+                                                     ? t->interval * 1000
+                                                     : t->interval),
+                                                    t->timerType);
     }
     return list;
 }
@@ -566,7 +657,7 @@ int QTimerInfoList::activateTimers()
     if (qt_disable_lowpriority_timers || isEmpty())
         return 0; // nothing to do
 
-    int n_act = 0, maxCount = 0;
+    int n_act = 0;
     firstTimerInfo = nullptr;
 
     timespec currentTime = updateCurrentTime();
@@ -575,11 +666,9 @@ int QTimerInfoList::activateTimers()
 
 
     // Find out how many timer have expired
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (currentTime < (*it)->timeout)
-            break;
-        maxCount++;
-    }
+    qsizetype maxCount = expiredTimerCount(0, currentTime);
+
+    QEventLoopStatisticsData *stats = maxCount ? QEventLoopStatisticsData::active(QThreadData::current()) : nullptr;
 
     //fire the timers.
     while (maxCount--) {
@@ -601,7 +690,7 @@ int QTimerInfoList::activateTimers()
         }
 
         // remove from list
-        removeFirst();
+        heapRemove(currentTimerInfo);
 
 #ifdef QTIMERINFO_DEBUG
         float diff;
@@ -623,6 +712,12 @@ int QTimerInfoList::activateTimers()
                 << "avg error" << (currentTimerInfo->cumulativeError / currentTimerInfo->count);
 #endif
 
+        if (Q_UNLIKELY(stats)) {
+            const timespec late = currentTime - currentTimerInfo->timeout;
+            stats->recordTimerLateness(currentTimerInfo->id,
+                                       late.tv_sec * Q_INT64_C(1000000000) + late.tv_nsec);
+        }
+
         // determine next timeout time
         calculateNextTimeout(currentTimerInfo, currentTime);
 
@@ -56,6 +56,7 @@
 // #define QTIMERINFO_DEBUG
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
 
 #include <sys/time.h> // struct timeval
 
@@ -69,6 +70,8 @@ struct QTimerInfo {
     timespec timeout;  // - when to actually fire
     QObject *obj;     // - object to receive event
     QTimerInfo **activateRef; // - ref from activateTimers
+    qsizetype heapIndex; // - position in the QTimerInfoList heap
+    quint64 sequence; // - insertion order, breaks ties between equal timeouts
 
 #ifdef QTIMERINFO_DEBUG
     timeval expected; // when timer is expected to fire
@@ -77,6 +80,9 @@ struct QTimerInfo {
 #endif
 };
 
+// The list is kept as a binary min-heap ordered by timeout (and insertion
+// order for equal timeouts), so constFirst() is always the next timer to fire
+// and registering, unregistering or restarting a timer is O(log n).
 class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
 {
 #if ((_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC)) || defined(QT_BOOTSTRAPPED)
@@ -92,6 +98,18 @@ class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
     // state variables used by activateTimers()
     QTimerInfo *firstTimerInfo;
 
+    // lookup tables, so that finding a timer does not require a heap scan
+    QHash<int, QTimerInfo *> timersById;
+    QMultiHash<QObject *, QTimerInfo *> timersByObject;
+    quint64 nextSequence;
+
+    void heapSiftUp(qsizetype index);
+    void heapSiftDown(qsizetype index);
+    void heapRemove(QTimerInfo *ti);
+    void timerRemove(QTimerInfo *ti);
+    QTimerInfo *firstInactiveTimer(qsizetype index) const;
+    qsizetype expiredTimerCount(qsizetype index, const timespec &currentTime) const;
+
 public:
     QTimerInfoList();
 
@@ -72,6 +72,7 @@
 
 #include <vector>
 #include <memory>
+#include <typeinfo>
 
 QT_BEGIN_NAMESPACE
 
@@ -322,6 +323,9 @@ public:
     QString language;
     QString filePath;
 
+    // set by load(); see QCoreApplicationPrivate::isTranslationCacheable()
+    bool loadCalled = false;
+
     bool do_load(const QString &filename, const QString &directory);
     bool do_load(const uchar *data, qsizetype len, const QString &directory);
     QString do_translate(const char *context, const char *sourceText, const char *comment,
@@ -874,6 +878,9 @@ bool QTranslatorPrivate::do_load(const uchar *data, qsizetype len, const QString
         numerusRulesLength = 0;
     }
 
+    // translations may have been looked up while we were still empty
+    loadCalled = true;
+    QCoreApplicationPrivate::translatorContentsChanged(q_func());
     return ok;
 }
 
@@ -1051,6 +1058,28 @@ searchDependencies:
     This function works with stripped translator files.
 */
 
+/*!
+    \internal
+
+    Returns \c true if QCoreApplication::translate() may cache results while
+    \a translator is installed. That is only the case for translators that
+    use the translate() implementation of QTranslator itself on data set by
+    load(), since load() and unloading notify the cache. Subclasses may
+    reimplement translate(), whether or not they use Q_OBJECT, so they are
+    excluded by their dynamic type; without RTTI nothing is cached.
+*/
+bool QCoreApplicationPrivate::isTranslationCacheable(const QTranslator *translator)
+{
+#ifdef __cpp_rtti
+    if (typeid(*translator) != typeid(QTranslator))
+        return false;
+    return static_cast<const QTranslatorPrivate *>(QObjectPrivate::get(translator))->loadCalled;
+#else
+    Q_UNUSED(translator);
+    return false;
+#endif
+}
+
 void QTranslatorPrivate::clear()
 {
     Q_Q(QTranslator);
@@ -1082,6 +1111,7 @@ void QTranslatorPrivate::clear()
     language.clear();
     filePath.clear();
 
+    QCoreApplicationPrivate::translatorContentsChanged(q);
     if (QCoreApplicationPrivate::isTranslatorInstalled(q))
         QCoreApplication::postEvent(QCoreApplication::instance(),
                                     new QEvent(QEvent::LanguageChange));
@@ -41,6 +41,7 @@
 
 #include "qregularexpression.h"
 
+#include <QtCore/qcache.h>
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qhashfunctions.h>
 #include <QtCore/qlist.h>
@@ -417,6 +418,36 @@ QT_BEGIN_NAMESPACE
     text) would have been \c{"abcabc"}; by matching only against the leading
     \c{"abc"} we instead get a partial match.
 
+    \section1 Compiled Patterns
+
+    QRegularExpression compiles its pattern (and JIT compiles it, see
+    \l{Debugging Code that Uses QRegularExpression}) when it is first used
+    for matching, or when optimize() is called. The compiled pattern is
+    shared by all the QRegularExpression objects with the same pattern and
+    pattern options, and a process-wide cache keeps the most recently used
+    compiled patterns after the last of those objects is destroyed. Creating
+    the same QRegularExpression again, for instance in a function that is
+    called repeatedly, therefore doesn't compile the pattern again.
+
+    To find out which of many patterns match a string, use
+    QRegularExpressionSet.
+
+    \section1 Matching UTF-8 Data
+
+    QRegularExpression can also match UTF-8 data, passed as a
+    QUtf8StringView or a QByteArrayView, without converting it to UTF-16
+    first: the pattern is compiled a second time, for UTF-8, when such data
+    is matched for the first time. This is useful, for instance, to search
+    large UTF-8 files:
+
+    \snippet code/src_corelib_text_qregularexpression.cpp 37
+
+    The offsets used and reported when matching UTF-8 data, such as the
+    starting offset of the match and
+    \l{QRegularExpressionMatch::}{capturedStart()}, are in bytes; the captured
+    substrings are available as views into the subject through
+    \l{QRegularExpressionMatch::}{capturedUtf8View()}.
+
     \section1 Error Handling
 
     It is possible for a QRegularExpression object to be invalid because of
@@ -684,8 +715,8 @@ QT_BEGIN_NAMESPACE
         This enum value has been introduced in Qt 6.0.
 
     \value DontCheckSubjectStringMatchOption
-        The subject string is not checked for UTF-16 validity before
-        attempting a match. Use this option with extreme caution, as
+        The subject string is not checked for UTF-16 (or, when matching UTF-8
+        data, UTF-8) validity before attempting a match. Use this option with extreme caution, as
         attempting to match an invalid string may crash the program and/or
         constitute a security issue. This enum value has been introduced in
         Qt 5.4.
@@ -731,6 +762,117 @@ static int convertToPcreOptions(QRegularExpression::MatchOptions matchOptions)
     return options;
 }
 
+template <typename Pcre2> class QPcreJitStackPointer;
+
+/*
+    The parts of the PCRE2 API needed to match, for the 16-bit library (used
+    to match QString and QStringView subjects) and for the 8-bit library
+    (used to match UTF-8 subjects), so that the matching code can be written
+    once for both.
+*/
+struct QPcre2Utf16
+{
+    typedef char16_t CodeUnit;
+    typedef pcre2_code_16 Code;
+    typedef pcre2_match_context_16 MatchContext;
+    typedef pcre2_match_data_16 MatchData;
+    typedef pcre2_jit_stack_16 JitStack;
+    typedef pcre2_jit_callback_16 JitCallback;
+
+    // a code unit that can't start a character
+    static bool isTrailingUnit(CodeUnit unit) { return QChar::isLowSurrogate(unit); }
+
+    static int patternInfo(const Code *code, uint32_t what, void *where)
+    { return pcre2_pattern_info_16(code, what, where); }
+    static JitStack *createJitStack(PCRE2_SIZE startSize, PCRE2_SIZE maxSize)
+    { return pcre2_jit_stack_create_16(startSize, maxSize, nullptr); }
+    static void freeJitStack(JitStack *stack) { pcre2_jit_stack_free_16(stack); }
+    static MatchContext *createMatchContext(JitCallback callback)
+    {
+        MatchContext *context = pcre2_match_context_create_16(nullptr);
+        pcre2_jit_stack_assign_16(context, callback, nullptr);
+        return context;
+    }
+    static void freeMatchContext(MatchContext *context) { pcre2_match_context_free_16(context); }
+    static MatchData *createMatchData(const Code *code)
+    { return pcre2_match_data_create_from_pattern_16(code, nullptr); }
+    static void freeMatchData(MatchData *matchData) { pcre2_match_data_free_16(matchData); }
+    static PCRE2_SIZE *ovector(MatchData *matchData) { return pcre2_get_ovector_pointer_16(matchData); }
+    static int match(const Code *code, const CodeUnit *subject, qsizetype length,
+                     qsizetype startOffset, int options,
+                     MatchData *matchData, MatchContext *matchContext)
+    {
+        return pcre2_match_16(code, reinterpret_cast<PCRE2_SPTR16>(subject), length,
+                              startOffset, options, matchData, matchContext);
+    }
+
+    static QThreadStorage<QPcreJitStackPointer<QPcre2Utf16> *> *jitStacks();
+};
+
+struct QPcre2Utf8
+{
+    typedef uchar CodeUnit;
+    typedef pcre2_code_8 Code;
+    typedef pcre2_match_context_8 MatchContext;
+    typedef pcre2_match_data_8 MatchData;
+    typedef pcre2_jit_stack_8 JitStack;
+    typedef pcre2_jit_callback_8 JitCallback;
+
+    // a code unit that can't start a character
+    static bool isTrailingUnit(CodeUnit unit) { return (unit & 0xc0) == 0x80; }
+
+    static int patternInfo(const Code *code, uint32_t what, void *where)
+    { return pcre2_pattern_info_8(code, what, where); }
+    static JitStack *createJitStack(PCRE2_SIZE startSize, PCRE2_SIZE maxSize)
+    { return pcre2_jit_stack_create_8(startSize, maxSize, nullptr); }
+    static void freeJitStack(JitStack *stack) { pcre2_jit_stack_free_8(stack); }
+    static MatchContext *createMatchContext(JitCallback callback)
+    {
+        MatchContext *context = pcre2_match_context_create_8(nullptr);
+        pcre2_jit_stack_assign_8(context, callback, nullptr);
+        return context;
+    }
+    static void freeMatchContext(MatchContext *context) { pcre2_match_context_free_8(context); }
+    static MatchData *createMatchData(const Code *code)
+    { return pcre2_match_data_create_from_pattern_8(code, nullptr); }
+    static void freeMatchData(MatchData *matchData) { pcre2_match_data_free_8(matchData); }
+    static PCRE2_SIZE *ovector(MatchData *matchData) { return pcre2_get_ovector_pointer_8(matchData); }
+    static int match(const Code *code, const CodeUnit *subject, qsizetype length,
+                     qsizetype startOffset, int options,
+                     MatchData *matchData, MatchContext *matchContext)
+    {
+        return pcre2_match_8(code, reinterpret_cast<PCRE2_SPTR8>(subject), length,
+                             startOffset, options, matchData, matchContext);
+    }
+
+    static QThreadStorage<QPcreJitStackPointer<QPcre2Utf8> *> *jitStacks();
+};
+
+/*
+    The code of a compiled pattern. It's shared by all the QRegularExpression
+    objects with the same pattern and pattern options (see compilePattern()):
+    PCRE2 allows several threads to match using the same compiled (and JIT
+    compiled) pattern, as long as nobody modifies it.
+
+    Only one of the two pointers is set, depending on the PCRE2 library that
+    compiled the pattern.
+*/
+struct QPcreCompiledPattern : QSharedData
+{
+    Q_DISABLE_COPY_MOVE(QPcreCompiledPattern)
+
+    explicit QPcreCompiledPattern(pcre2_code_16 *code) : code(code), utf8Code(nullptr) {}
+    explicit QPcreCompiledPattern(pcre2_code_8 *utf8Code) : code(nullptr), utf8Code(utf8Code) {}
+    ~QPcreCompiledPattern()
+    {
+        pcre2_code_free_16(code);
+        pcre2_code_free_8(utf8Code);
+    }
+
+    pcre2_code_16 *const code;
+    pcre2_code_8 *const utf8Code;
+};
+
 struct QRegularExpressionPrivate : QSharedData
 {
     QRegularExpressionPrivate();
@@ -739,6 +881,7 @@ struct QRegularExpressionPrivate : QSharedData
 
     void cleanCompiledPattern();
     void compilePattern();
+    void compileUtf8Pattern();
     void getPatternInfo();
     void optimizePattern();
 
@@ -752,6 +895,15 @@ struct QRegularExpressionPrivate : QSharedData
                  CheckSubjectStringOption checkSubjectStringOption = CheckSubjectString,
                  const QRegularExpressionMatchPrivate *previous = nullptr) const;
 
+    template <typename Pcre2>
+    void doMatchImpl(QRegularExpressionMatchPrivate *priv,
+                     const typename Pcre2::Code *code,
+                     const typename Pcre2::CodeUnit *subject,
+                     qsizetype subjectLength,
+                     qsizetype offset,
+                     CheckSubjectStringOption checkSubjectStringOption,
+                     const QRegularExpressionMatchPrivate *previous) const;
+
     int captureIndexForName(QStringView name) const;
 
     // sizeof(QSharedData) == 4, so start our members with an enum
@@ -763,10 +915,16 @@ struct QRegularExpressionPrivate : QSharedData
     // (right after a detach happened).
     mutable QMutex mutex;
 
-    // The PCRE code pointer is reference-counted by the QRegularExpressionPrivate
-    // objects themselves; when the private is copied (i.e. a detach happened)
-    // it is set to nullptr
+    // The PCRE code is reference-counted by sharedCompiledPattern, which may
+    // be shared with other QRegularExpressionPrivate objects and with the
+    // compiled pattern cache; compiledPattern points to the code itself.
+    // When the private is copied (i.e. a detach happened) they are reset
+    QExplicitlySharedDataPointer<QPcreCompiledPattern> sharedCompiledPattern;
     pcre2_code_16 *compiledPattern;
+    // The same, for the pattern compiled by the 8-bit PCRE2 library, which is
+    // only needed to match UTF-8 subjects (see compileUtf8Pattern())
+    QExplicitlySharedDataPointer<QPcreCompiledPattern> sharedCompiledUtf8Pattern;
+    pcre2_code_8 *compiledUtf8Pattern;
     int errorCode;
     qsizetype errorOffset;
     int capturingCount;
@@ -781,6 +939,10 @@ struct QRegularExpressionMatchPrivate : QSharedData
                                    QStringView subject,
                                    QRegularExpression::MatchType matchType,
                                    QRegularExpression::MatchOptions matchOptions);
+    QRegularExpressionMatchPrivate(const QRegularExpression &re,
+                                   QUtf8StringView subjectUtf8,
+                                   QRegularExpression::MatchType matchType,
+                                   QRegularExpression::MatchOptions matchOptions);
 
     QRegularExpressionMatch nextMatch() const;
 
@@ -792,6 +954,12 @@ struct QRegularExpressionMatchPrivate : QSharedData
     const QString subjectStorage;
     const QStringView subject;
 
+    // if we've been asked to match over UTF-8 data, we match upon
+    // subjectUtf8 instead (which is never copied), and all the
+    // offsets are in bytes
+    const QUtf8StringView subjectUtf8;
+    const bool subjectIsUtf8 = false;
+
     const QRegularExpression::MatchType matchType;
     const QRegularExpression::MatchOptions matchOptions;
 
@@ -836,7 +1004,10 @@ QRegularExpressionPrivate::QRegularExpressionPrivate()
       patternOptions(),
       pattern(),
       mutex(),
+      sharedCompiledPattern(),
       compiledPattern(nullptr),
+      sharedCompiledUtf8Pattern(),
+      compiledUtf8Pattern(nullptr),
       errorCode(0),
       errorOffset(-1),
       capturingCount(0),
@@ -857,8 +1028,8 @@ QRegularExpressionPrivate::~QRegularExpressionPrivate()
     \internal
 
     Copies the private, which means copying only the pattern and the pattern
-    options. The compiledPattern pointer is NOT copied (we
-    do not own it any more), and in general all the members set when
+    options. The compiled pattern is NOT copied (the copy will find it
+    again in the cache when needed), and in general all the members set when
     compiling a pattern are set to default values. isDirty is set back to true
     so that the pattern has to be recompiled again.
 */
@@ -867,7 +1038,10 @@ QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPri
       patternOptions(other.patternOptions),
       pattern(other.pattern),
       mutex(),
+      sharedCompiledPattern(),
       compiledPattern(nullptr),
+      sharedCompiledUtf8Pattern(),
+      compiledUtf8Pattern(nullptr),
       errorCode(0),
       errorOffset(-1),
       capturingCount(0),
@@ -881,16 +1055,72 @@ QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPri
 */
 void QRegularExpressionPrivate::cleanCompiledPattern()
 {
-    pcre2_code_free_16(compiledPattern);
+    sharedCompiledPattern.reset();
     compiledPattern = nullptr;
+    sharedCompiledUtf8Pattern.reset();
+    compiledUtf8Pattern = nullptr;
     errorCode = 0;
     errorOffset = -1;
     capturingCount = 0;
     usingCrLfNewlines = false;
 }
 
+namespace {
+struct QRegularExpressionCacheKey
+{
+    QString pattern;
+    QRegularExpression::PatternOptions patternOptions;
+    bool utf8 = false;  // compiled by the 8-bit library
+
+    friend bool operator==(const QRegularExpressionCacheKey &lhs, const QRegularExpressionCacheKey &rhs) noexcept
+    {
+        return lhs.patternOptions == rhs.patternOptions && lhs.utf8 == rhs.utf8
+                && lhs.pattern == rhs.pattern;
+    }
+
+    friend size_t qHash(const QRegularExpressionCacheKey &key, size_t seed = 0) noexcept
+    {
+        return qHashMulti(seed, key.pattern, key.patternOptions, key.utf8);
+    }
+};
+} // unnamed namespace
+
+// The cost of a cache entry is the size in bytes of its compiled and JIT
+// compiled code; this bounds the memory used by patterns that are kept alive
+// only by the cache.
+enum { CompiledPatternCacheMaxCost = 8 * 1024 * 1024 };
+
+typedef QCache<QRegularExpressionCacheKey, QExplicitlySharedDataPointer<QPcreCompiledPattern>> CompiledPatternCache;
+Q_GLOBAL_STATIC_WITH_ARGS(CompiledPatternCache, compiledPatternCache, (CompiledPatternCacheMaxCost))
+static QBasicMutex compiledPatternCacheMutex;
+
+static QExplicitlySharedDataPointer<QPcreCompiledPattern> cachedCompiledPattern(const QRegularExpressionCacheKey &key)
+{
+    const QMutexLocker cacheLock(&compiledPatternCacheMutex);
+    if (CompiledPatternCache *cache = compiledPatternCache()) {
+        if (const auto cached = cache->object(key))
+            return *cached;
+    }
+    return QExplicitlySharedDataPointer<QPcreCompiledPattern>();
+}
+
+static void cacheCompiledPattern(const QRegularExpressionCacheKey &key,
+                                 const QExplicitlySharedDataPointer<QPcreCompiledPattern> &compiled,
+                                 size_t cost)
+{
+    const QMutexLocker cacheLock(&compiledPatternCacheMutex);
+    if (CompiledPatternCache *cache = compiledPatternCache())
+        cache->insert(key, new QExplicitlySharedDataPointer<QPcreCompiledPattern>(compiled), qsizetype(cost));
+}
+
 /*!
     \internal
+
+    Compiles the pattern, unless it's already compiled. Creating the same
+    QRegularExpression over and over again is a common idiom, so the compiled
+    (and JIT compiled) code is looked up in a process-wide cache keyed by the
+    pattern and the pattern options first, and stored there after compiling
+    it. Patterns with errors aren't cached.
 */
 void QRegularExpressionPrivate::compilePattern()
 {
@@ -902,6 +1132,14 @@ void QRegularExpressionPrivate::compilePattern()
     isDirty = false;
     cleanCompiledPattern();
 
+    const QRegularExpressionCacheKey key = { pattern, patternOptions };
+    sharedCompiledPattern = cachedCompiledPattern(key);
+    if (sharedCompiledPattern) {
+        compiledPattern = sharedCompiledPattern->code;
+        getPatternInfo();
+        return;
+    }
+
     int options = convertToPcreOptions(patternOptions);
     options |= PCRE2_UTF;
 
@@ -921,8 +1159,15 @@ void QRegularExpressionPrivate::compilePattern()
         errorCode = 0;
     }
 
+    sharedCompiledPattern = new QPcreCompiledPattern(compiledPattern);
     optimizePattern();
     getPatternInfo();
+
+    size_t size = 0;
+    size_t jitSize = 0;
+    pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_SIZE, &size);
+    pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_JITSIZE, &jitSize);
+    cacheCompiledPattern(key, sharedCompiledPattern, size + jitSize);
 }
 
 /*!
@@ -955,9 +1200,10 @@ void QRegularExpressionPrivate::getPatternInfo()
 
 
 /*
-    Simple "smartpointer" wrapper around a pcre2_jit_stack_16, to be used with
-    QThreadStorage.
+    Simple "smartpointer" wrapper around a pcre2_jit_stack_16 (or a
+    pcre2_jit_stack_8), to be used with QThreadStorage.
 */
+template <typename Pcre2>
 class QPcreJitStackPointer
 {
     Q_DISABLE_COPY(QPcreJitStackPointer)
@@ -970,7 +1216,7 @@ public:
     {
         // The default JIT stack size in PCRE is 32K,
         // we allocate from 32K up to 512K.
-        stack = pcre2_jit_stack_create_16(32 * 1024, 512 * 1024, nullptr);
+        stack = Pcre2::createJitStack(32 * 1024, 512 * 1024);
     }
     /*!
         \internal
@@ -978,21 +1224,33 @@ public:
     ~QPcreJitStackPointer()
     {
         if (stack)
-            pcre2_jit_stack_free_16(stack);
+            Pcre2::freeJitStack(stack);
     }
 
-    pcre2_jit_stack_16 *stack;
+    typename Pcre2::JitStack *stack;
 };
 
-Q_GLOBAL_STATIC(QThreadStorage<QPcreJitStackPointer *>, jitStacks)
+Q_GLOBAL_STATIC(QThreadStorage<QPcreJitStackPointer<QPcre2Utf16> *>, utf16JitStacks)
+Q_GLOBAL_STATIC(QThreadStorage<QPcreJitStackPointer<QPcre2Utf8> *>, utf8JitStacks)
+
+QThreadStorage<QPcreJitStackPointer<QPcre2Utf16> *> *QPcre2Utf16::jitStacks()
+{
+    return utf16JitStacks();
+}
+
+QThreadStorage<QPcreJitStackPointer<QPcre2Utf8> *> *QPcre2Utf8::jitStacks()
+{
+    return utf8JitStacks();
+}
 
 /*!
     \internal
 */
-static pcre2_jit_stack_16 *qtPcreCallback(void *)
+template <typename Pcre2>
+static typename Pcre2::JitStack *qtPcreCallback(void *)
 {
-    if (jitStacks()->hasLocalData())
-        return jitStacks()->localData()->stack;
+    if (Pcre2::jitStacks()->hasLocalData())
+        return Pcre2::jitStacks()->localData()->stack;
 
     return nullptr;
 }
@@ -1037,6 +1295,64 @@ void QRegularExpressionPrivate::optimizePattern()
     pcre2_jit_compile_16(compiledPattern, PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_SOFT | PCRE2_JIT_PARTIAL_HARD);
 }
 
+/*!
+    \internal
+
+    Compiles (and JIT compiles) the pattern with the 8-bit PCRE2 library, so
+    that UTF-8 subjects can be matched without converting them to UTF-16,
+    unless it's already compiled. This is only done when a UTF-8 subject is
+    matched for the first time; the code is cached like the 16-bit one.
+
+    The pattern is compiled for UTF-16 first, which also reports any error
+    in it.
+*/
+void QRegularExpressionPrivate::compileUtf8Pattern()
+{
+    compilePattern();
+
+    const QMutexLocker lock(&mutex);
+
+    if (!compiledPattern || compiledUtf8Pattern)
+        return;
+
+    const QRegularExpressionCacheKey key = { pattern, patternOptions, true };
+    sharedCompiledUtf8Pattern = cachedCompiledPattern(key);
+    if (sharedCompiledUtf8Pattern) {
+        compiledUtf8Pattern = sharedCompiledUtf8Pattern->utf8Code;
+        return;
+    }
+
+    int options = convertToPcreOptions(patternOptions);
+    options |= PCRE2_UTF;
+
+    const QByteArray utf8Pattern = pattern.toUtf8();
+    int utf8ErrorCode;
+    PCRE2_SIZE utf8ErrorOffset;
+    compiledUtf8Pattern = pcre2_compile_8(reinterpret_cast<PCRE2_SPTR8>(utf8Pattern.constData()),
+                                          utf8Pattern.size(),
+                                          options,
+                                          &utf8ErrorCode,
+                                          &utf8ErrorOffset,
+                                          nullptr);
+
+    // the same pattern compiled for UTF-16, so this can only fail
+    // because of memory or internal limits
+    if (!compiledUtf8Pattern)
+        return;
+
+    sharedCompiledUtf8Pattern = new QPcreCompiledPattern(compiledUtf8Pattern);
+
+    static const bool enableJit = isJitEnabled();
+    if (enableJit)
+        pcre2_jit_compile_8(compiledUtf8Pattern, PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_SOFT | PCRE2_JIT_PARTIAL_HARD);
+
+    size_t size = 0;
+    size_t jitSize = 0;
+    pcre2_pattern_info_8(compiledUtf8Pattern, PCRE2_INFO_SIZE, &size);
+    pcre2_pattern_info_8(compiledUtf8Pattern, PCRE2_INFO_JITSIZE, &jitSize);
+    cacheCompiledPattern(key, sharedCompiledUtf8Pattern, size + jitSize);
+}
+
 /*!
     \internal
 
@@ -1075,25 +1391,26 @@ int QRegularExpressionPrivate::captureIndexForName(QStringView name) const
 /*!
     \internal
 
-    This is a simple wrapper for pcre2_match_16 for handling the case in which the
-    JIT runs out of memory. In that case, we allocate a thread-local JIT stack
-    and re-run pcre2_match_16.
+    This is a simple wrapper for pcre2_match_16 (or pcre2_match_8) for handling
+    the case in which the JIT runs out of memory. In that case, we allocate a
+    thread-local JIT stack and re-run the match.
 */
-static int safe_pcre2_match_16(const pcre2_code_16 *code,
-                               PCRE2_SPTR16 subject, qsizetype length,
-                               qsizetype startOffset, int options,
-                               pcre2_match_data_16 *matchData,
-                               pcre2_match_context_16 *matchContext)
+template <typename Pcre2>
+static int safe_pcre2_match(const typename Pcre2::Code *code,
+                            const typename Pcre2::CodeUnit *subject, qsizetype length,
+                            qsizetype startOffset, int options,
+                            typename Pcre2::MatchData *matchData,
+                            typename Pcre2::MatchContext *matchContext)
 {
-    int result = pcre2_match_16(code, subject, length,
-                                startOffset, options, matchData, matchContext);
+    int result = Pcre2::match(code, subject, length,
+                              startOffset, options, matchData, matchContext);
 
-    if (result == PCRE2_ERROR_JIT_STACKLIMIT && !jitStacks()->hasLocalData()) {
-        QPcreJitStackPointer *p = new QPcreJitStackPointer;
-        jitStacks()->setLocalData(p);
+    if (result == PCRE2_ERROR_JIT_STACKLIMIT && !Pcre2::jitStacks()->hasLocalData()) {
+        auto p = new QPcreJitStackPointer<Pcre2>;
+        Pcre2::jitStacks()->setLocalData(p);
 
-        result = pcre2_match_16(code, subject, length,
-                                startOffset, options, matchData, matchContext);
+        result = Pcre2::match(code, subject, length,
+                              startOffset, options, matchData, matchContext);
     }
 
     return result;
@@ -1126,6 +1443,10 @@ static int safe_pcre2_match_16(const pcre2_code_16 *code,
     match. We also have the problem of detecting the current newline format: if
     the new advanced offset is pointing to the beginning of a CRLF sequence, we
     must advance over it.
+
+    UTF-8 subjects are matched by the 8-bit PCRE2 library, which must have
+    compiled the pattern (see compileUtf8Pattern()); the offsets are then in
+    bytes.
 */
 void QRegularExpressionPrivate::doMatch(QRegularExpressionMatchPrivate *priv,
                                         qsizetype offset,
@@ -1135,15 +1456,43 @@ void QRegularExpressionPrivate::doMatch(QRegularExpressionMatchPrivate *priv,
     Q_ASSERT(priv);
     Q_ASSUME(priv != previous);
 
-    const qsizetype subjectLength = priv->subject.size();
+    if (priv->subjectIsUtf8) {
+        // PCRE2 rejects a null subject, even an empty one
+        const QUtf8StringView subject = priv->subjectUtf8;
+        const char *subjectData = subject.isNull() ? "" : reinterpret_cast<const char *>(subject.data());
+        doMatchImpl<QPcre2Utf8>(priv, compiledUtf8Pattern,
+                                reinterpret_cast<const uchar *>(subjectData), subject.size(),
+                                offset, checkSubjectStringOption, previous);
+    } else {
+        doMatchImpl<QPcre2Utf16>(priv, compiledPattern,
+                                 priv->subject.utf16(), priv->subject.size(),
+                                 offset, checkSubjectStringOption, previous);
+    }
+}
+
+/*!
+    \internal
 
+    Performs the match described in doMatch() on \a subject, of length \a
+    subjectLength, with the \a code compiled by the PCRE2 library described
+    by \c{Pcre2}.
+*/
+template <typename Pcre2>
+void QRegularExpressionPrivate::doMatchImpl(QRegularExpressionMatchPrivate *priv,
+                                            const typename Pcre2::Code *code,
+                                            const typename Pcre2::CodeUnit *subject,
+                                            qsizetype subjectLength,
+                                            qsizetype offset,
+                                            CheckSubjectStringOption checkSubjectStringOption,
+                                            const QRegularExpressionMatchPrivate *previous) const
+{
     if (offset < 0)
         offset += subjectLength;
 
     if (offset < 0 || offset > subjectLength)
         return;
 
-    if (Q_UNLIKELY(!compiledPattern)) {
+    if (Q_UNLIKELY(!code)) {
         qWarning("QRegularExpressionPrivate::doMatch(): called on an invalid QRegularExpression object");
         return;
     }
@@ -1170,42 +1519,40 @@ void QRegularExpressionPrivate::doMatch(QRegularExpressionMatchPrivate *priv,
         previousMatchWasEmpty = true;
     }
 
-    pcre2_match_context_16 *matchContext = pcre2_match_context_create_16(nullptr);
-    pcre2_jit_stack_assign_16(matchContext, &qtPcreCallback, nullptr);
-    pcre2_match_data_16 *matchData = pcre2_match_data_create_from_pattern_16(compiledPattern, nullptr);
-
-    const char16_t * const subjectUtf16 = priv->subject.utf16();
+    typename Pcre2::MatchContext *matchContext = Pcre2::createMatchContext(&qtPcreCallback<Pcre2>);
+    typename Pcre2::MatchData *matchData = Pcre2::createMatchData(code);
 
     int result;
 
     if (!previousMatchWasEmpty) {
-        result = safe_pcre2_match_16(compiledPattern,
-                                     reinterpret_cast<PCRE2_SPTR16>(subjectUtf16), subjectLength,
-                                     offset, pcreOptions,
-                                     matchData, matchContext);
+        result = safe_pcre2_match<Pcre2>(code,
+                                         subject, subjectLength,
+                                         offset, pcreOptions,
+                                         matchData, matchContext);
     } else {
-        result = safe_pcre2_match_16(compiledPattern,
-                                     reinterpret_cast<PCRE2_SPTR16>(subjectUtf16), subjectLength,
-                                     offset, pcreOptions | PCRE2_NOTEMPTY_ATSTART | PCRE2_ANCHORED,
-                                     matchData, matchContext);
+        result = safe_pcre2_match<Pcre2>(code,
+                                         subject, subjectLength,
+                                         offset, pcreOptions | PCRE2_NOTEMPTY_ATSTART | PCRE2_ANCHORED,
+                                         matchData, matchContext);
 
         if (result == PCRE2_ERROR_NOMATCH) {
             ++offset;
 
             if (usingCrLfNewlines
                     && offset < subjectLength
-                    && subjectUtf16[offset - 1] == QLatin1Char('\r')
-                    && subjectUtf16[offset] == QLatin1Char('\n')) {
-                ++offset;
-            } else if (offset < subjectLength
-                       && QChar::isLowSurrogate(subjectUtf16[offset])) {
+                    && subject[offset - 1] == '\r'
+                    && subject[offset] == '\n') {
                 ++offset;
+            } else {
+                // advance to the start of the next character
+                while (offset < subjectLength && Pcre2::isTrailingUnit(subject[offset]))
+                    ++offset;
             }
 
-            result = safe_pcre2_match_16(compiledPattern,
-                                         reinterpret_cast<PCRE2_SPTR16>(subjectUtf16), subjectLength,
-                                         offset, pcreOptions,
-                                         matchData, matchContext);
+            result = safe_pcre2_match<Pcre2>(code,
+                                             subject, subjectLength,
+                                             offset, pcreOptions,
+                                             matchData, matchContext);
         }
     }
 
@@ -1244,7 +1591,7 @@ void QRegularExpressionPrivate::doMatch(QRegularExpressionMatchPrivate *priv,
 
     // copy the captured substrings offsets, if any
     if (priv->capturedCount) {
-        PCRE2_SIZE *ovector = pcre2_get_ovector_pointer_16(matchData);
+        PCRE2_SIZE *ovector = Pcre2::ovector(matchData);
         qsizetype *const capturedOffsets = priv->capturedOffsets.data();
 
         for (int i = 0; i < priv->capturedCount * 2; ++i)
@@ -1263,13 +1610,24 @@ void QRegularExpressionPrivate::doMatch(QRegularExpressionMatchPrivate *priv,
         // (Eventually, we could expose the lookbehind info in a future patch.)
         if (result == PCRE2_ERROR_PARTIAL) {
             unsigned int maximumLookBehind;
-            pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_MAXLOOKBEHIND, &maximumLookBehind);
-            capturedOffsets[0] -= maximumLookBehind;
+            Pcre2::patternInfo(code, PCRE2_INFO_MAXLOOKBEHIND, &maximumLookBehind);
+            if constexpr (std::is_same_v<Pcre2, QPcre2Utf8>) {
+                // the lookbehind is in characters, not code units: step
+                // back over whole UTF-8 sequences so that the partial match
+                // starts where PCRE1 would have started it
+                for (; maximumLookBehind && capturedOffsets[0] > 0; --maximumLookBehind) {
+                    do {
+                        --capturedOffsets[0];
+                    } while (capturedOffsets[0] > 0 && Pcre2::isTrailingUnit(subject[capturedOffsets[0]]));
+                }
+            } else {
+                capturedOffsets[0] -= maximumLookBehind;
+            }
         }
     }
 
-    pcre2_match_data_free_16(matchData);
-    pcre2_match_context_free_16(matchContext);
+    Pcre2::freeMatchData(matchData);
+    Pcre2::freeMatchContext(matchContext);
 }
 
 /*!
@@ -1288,6 +1646,21 @@ QRegularExpressionMatchPrivate::QRegularExpressionMatchPrivate(const QRegularExp
 {
 }
 
+/*!
+    \internal
+*/
+QRegularExpressionMatchPrivate::QRegularExpressionMatchPrivate(const QRegularExpression &re,
+                                                               QUtf8StringView subjectUtf8,
+                                                               QRegularExpression::MatchType matchType,
+                                                               QRegularExpression::MatchOptions matchOptions)
+    : regularExpression(re),
+      subjectUtf8(subjectUtf8),
+      subjectIsUtf8(true),
+      matchType(matchType),
+      matchOptions(matchOptions)
+{
+}
+
 /*!
     \internal
 */
@@ -1296,11 +1669,16 @@ QRegularExpressionMatch QRegularExpressionMatchPrivate::nextMatch() const
     Q_ASSERT(isValid);
     Q_ASSERT(hasMatch || hasPartialMatch);
 
-    auto nextPrivate = new QRegularExpressionMatchPrivate(regularExpression,
-                                                          subjectStorage,
-                                                          subject,
-                                                          matchType,
-                                                          matchOptions);
+    auto nextPrivate = subjectIsUtf8
+            ? new QRegularExpressionMatchPrivate(regularExpression,
+                                                 subjectUtf8,
+                                                 matchType,
+                                                 matchOptions)
+            : new QRegularExpressionMatchPrivate(regularExpression,
+                                                 subjectStorage,
+                                                 subject,
+                                                 matchType,
+                                                 matchOptions);
 
     // Note the DontCheckSubjectString passed for the check of the subject string:
     // if we're advancing a match on the same subject,
@@ -1710,13 +2088,101 @@ QRegularExpressionMatchIterator QRegularExpression::globalMatch(QStringView subj
     return QRegularExpressionMatchIterator(*priv);
 }
 
+/*!
+    \fn QRegularExpressionMatch QRegularExpression::match(QUtf8StringView subjectView, qsizetype offset, MatchType matchType, MatchOptions matchOptions) const
+    \fn QRegularExpressionMatch QRegularExpression::match(QByteArrayView subjectView, qsizetype offset, MatchType matchType, MatchOptions matchOptions) const
+    \since 6.1
+    \overload
+
+    Attempts to match the regular expression against the UTF-8 data viewed
+    by \a subjectView, starting at the byte position \a offset inside the
+    subject, using a match of type \a matchType and honoring the given \a
+    matchOptions.
+
+    The subject is not converted to UTF-16: the offsets reported by the
+    returned QRegularExpressionMatch object are in bytes, and the captured
+    substrings are available as views into the subject through
+    QRegularExpressionMatch::capturedUtf8View().
+
+    \note These overloads are only selected by QUtf8StringView and
+    QByteArrayView arguments. Other arguments, for instance a QByteArray,
+    are converted to QString as usual.
+
+    \note The data referenced by \a subjectView must remain valid as long
+    as there are QRegularExpressionMatch objects using it.
+
+    \sa QRegularExpressionMatch, {normal matching}, {Matching UTF-8 Data}
+*/
+
+/*!
+    \internal
+
+    Implements the UTF-8 overloads of match().
+*/
+QRegularExpressionMatch QRegularExpression::matchUtf8(QUtf8StringView subjectView,
+                                                      qsizetype offset,
+                                                      MatchType matchType,
+                                                      MatchOptions matchOptions) const
+{
+    d.data()->compileUtf8Pattern();
+    auto priv = new QRegularExpressionMatchPrivate(*this,
+                                                   subjectView,
+                                                   matchType,
+                                                   matchOptions);
+    d->doMatch(priv, offset);
+    return QRegularExpressionMatch(*priv);
+}
+
+/*!
+    \fn QRegularExpressionMatchIterator QRegularExpression::globalMatch(QUtf8StringView subjectView, qsizetype offset, MatchType matchType, MatchOptions matchOptions) const
+    \fn QRegularExpressionMatchIterator QRegularExpression::globalMatch(QByteArrayView subjectView, qsizetype offset, MatchType matchType, MatchOptions matchOptions) const
+    \since 6.1
+    \overload
+
+    Attempts to perform a global match of the regular expression against the
+    UTF-8 data viewed by \a subjectView, starting at the byte position \a
+    offset inside the subject, using a match of type \a matchType and
+    honoring the given \a matchOptions.
+
+    The returned QRegularExpressionMatchIterator is positioned before the
+    first match result (if any). As with match(), the subject is not
+    converted to UTF-16 and the offsets of the matches are in bytes.
+
+    \note The data referenced by \a subjectView must remain valid as
+    long as there are QRegularExpressionMatchIterator or
+    QRegularExpressionMatch objects using it.
+
+    \sa QRegularExpressionMatchIterator, {global matching}, {Matching UTF-8 Data}
+*/
+
+/*!
+    \internal
+
+    Implements the UTF-8 overloads of globalMatch().
+*/
+QRegularExpressionMatchIterator QRegularExpression::globalMatchUtf8(QUtf8StringView subjectView,
+                                                                    qsizetype offset,
+                                                                    MatchType matchType,
+                                                                    MatchOptions matchOptions) const
+{
+    QRegularExpressionMatchIteratorPrivate *priv =
+            new QRegularExpressionMatchIteratorPrivate(*this,
+                                                       matchType,
+                                                       matchOptions,
+                                                       matchUtf8(subjectView, offset, matchType, matchOptions));
+
+    return QRegularExpressionMatchIterator(*priv);
+}
+
 /*!
     \since 5.4
 
     Compiles the pattern immediately, including JIT compiling it (if
-    the JIT is enabled) for optimization.
+    the JIT is enabled) for optimization. If a QRegularExpression with the
+    same pattern and pattern options has been compiled recently, its
+    compiled pattern is reused.
 
-    \sa isValid(), {Debugging Code that Uses QRegularExpression}
+    \sa isValid(), {Compiled Patterns}, {Debugging Code that Uses QRegularExpression}
 */
 void QRegularExpression::optimize() const
 {
@@ -2182,11 +2648,15 @@ int QRegularExpressionMatch::lastCapturedIndex() const
     \note The implicit capturing group number 0 captures the substring matched
     by the entire pattern.
 
-    \sa capturedView(), lastCapturedIndex(), capturedStart(), capturedEnd(),
-    capturedLength(), QString::isNull()
+    \note If the subject was UTF-8 data, the substring is converted to UTF-16.
+
+    \sa capturedView(), capturedUtf8View(), lastCapturedIndex(), capturedStart(),
+    capturedEnd(), capturedLength(), QString::isNull()
 */
 QString QRegularExpressionMatch::captured(int nth) const
 {
+    if (d->subjectIsUtf8)
+        return capturedUtf8View(nth).toString();
     return capturedView(nth).toString();
 }
 
@@ -2196,7 +2666,9 @@ QString QRegularExpressionMatch::captured(int nth) const
     Returns a view of the substring captured by the \a nth capturing group.
 
     If the \a nth capturing group did not capture a string, or if there is no
-    such capturing group, returns a null QStringView.
+    such capturing group, returns a null QStringView. A null QStringView is
+    also returned if the subject was UTF-8 data; use capturedUtf8View()
+    instead.
 
     \note The implicit capturing group number 0 captures the substring matched
     by the entire pattern.
@@ -2206,7 +2678,7 @@ QString QRegularExpressionMatch::captured(int nth) const
 */
 QStringView QRegularExpressionMatch::capturedView(int nth) const
 {
-    if (nth < 0 || nth > lastCapturedIndex())
+    if (d->subjectIsUtf8 || nth < 0 || nth > lastCapturedIndex())
         return QStringView();
 
     qsizetype start = capturedStart(nth);
@@ -2248,6 +2720,8 @@ QString QRegularExpressionMatch::captured(QStringView name) const
         return QString();
     }
 
+    if (d->subjectIsUtf8)
+        return capturedUtf8View(name).toString();
     return capturedView(name).toString();
 }
 
@@ -2275,6 +2749,60 @@ QStringView QRegularExpressionMatch::capturedView(QStringView name) const
     return capturedView(nth);
 }
 
+/*!
+    \since 6.1
+
+    Returns a view of the UTF-8 substring captured by the \a nth capturing
+    group, if the subject was UTF-8 data (see QRegularExpression::match()).
+    The view points into the subject.
+
+    If the \a nth capturing group did not capture a string, if there is no
+    such capturing group, or if the subject was not UTF-8 data, returns a
+    null QUtf8StringView.
+
+    \note The implicit capturing group number 0 captures the substring matched
+    by the entire pattern.
+
+    \sa captured(), capturedView(), capturedStart(), capturedEnd(),
+    capturedLength(), {QRegularExpression#Matching UTF-8 Data}{Matching UTF-8 Data}
+*/
+QUtf8StringView QRegularExpressionMatch::capturedUtf8View(int nth) const
+{
+    if (!d->subjectIsUtf8 || nth < 0 || nth > lastCapturedIndex())
+        return QUtf8StringView();
+
+    qsizetype start = capturedStart(nth);
+
+    if (start == -1) // didn't capture
+        return QUtf8StringView();
+
+    return d->subjectUtf8.mid(start, capturedLength(nth));
+}
+
+/*!
+    \since 6.1
+
+    Returns a view of the UTF-8 substring captured by the capturing group
+    named \a name, if the subject was UTF-8 data.
+
+    If the named capturing group \a name did not capture a string, if there
+    is no capturing group named \a name, or if the subject was not UTF-8
+    data, returns a null QUtf8StringView.
+
+    \sa captured(), capturedStart(), capturedEnd(), capturedLength()
+*/
+QUtf8StringView QRegularExpressionMatch::capturedUtf8View(QStringView name) const
+{
+    if (name.isEmpty()) {
+        qWarning("QRegularExpressionMatch::capturedUtf8View: empty capturing group name passed");
+        return QUtf8StringView();
+    }
+    int nth = d->regularExpression.d->captureIndexForName(name);
+    if (nth == -1)
+        return QUtf8StringView();
+    return capturedUtf8View(nth);
+}
+
 /*!
     Returns a list of all strings captured by capturing groups, in the order
     the groups themselves appear in the pattern string. The list includes the
@@ -2666,6 +3194,437 @@ QtPrivate::QRegularExpressionMatchIteratorRangeBasedForIterator begin(const QReg
   \internal
 */
 
+namespace {
+// A set of 256 code units (or of classes of code units, see below)
+struct QCodeUnitBitmap
+{
+    quint64 bits[4] = {};
+
+    void set(uint unit) { bits[unit / 64] |= Q_UINT64_C(1) << (unit % 64); }
+    bool intersects(const QCodeUnitBitmap &other) const
+    {
+        return ((bits[0] & other.bits[0]) | (bits[1] & other.bits[1])
+                | (bits[2] & other.bits[2]) | (bits[3] & other.bits[3])) != 0;
+    }
+};
+
+/*
+    What the matching of a QRegularExpressionSet needs to know about a
+    subject to skip the patterns that can't possibly match it: the code
+    units it contains, with all the code units above 0xff in the last bit
+    (like PCRE2's bitmap of starting code units), and the code units it
+    contains classified by their low byte.
+*/
+struct QRegularExpressionSubjectSummary
+{
+    explicit QRegularExpressionSubjectSummary(QStringView subject)
+        : length(subject.size())
+    {
+        for (const QChar c : subject) {
+            const uint unit = c.unicode();
+            clampedUnits.set(qMin(unit, 0xffu));
+            lowBytes.set(unit & 0xff);
+        }
+    }
+
+    qsizetype length;
+    QCodeUnitBitmap clampedUnits;
+    QCodeUnitBitmap lowBytes;
+};
+
+/*
+    A necessary condition for a pattern of a QRegularExpressionSet to match,
+    built from what PCRE2 found out about the pattern when compiling and
+    studying it (and uses itself to skip ahead in the subject).
+*/
+struct QRegularExpressionSetFilter
+{
+    explicit QRegularExpressionSetFilter(const pcre2_code_16 *code);
+
+    bool accepts(const QRegularExpressionSubjectSummary &summary) const
+    {
+        if (summary.length < minimumLength)
+            return false;
+        if (hasStartingUnits && !startingUnits.intersects(summary.clampedUnits))
+            return false;
+        for (int i = 0; i < requiredUnitCount; ++i) {
+            if (!requiredUnits[i].intersects(summary.lowBytes))
+                return false;
+        }
+        return true;
+    }
+
+    // PCRE2 doesn't tell whether a first or required code unit is to be
+    // matched caselessly (e.g. because of (?i) in the pattern), so accept
+    // any of its case variants. PCRE2 only reports code units whose other
+    // case is a single code unit.
+    void addRequiredUnit(uint unit)
+    {
+        QCodeUnitBitmap &bitmap = requiredUnits[requiredUnitCount++];
+        bitmap.set(unit & 0xff);
+        bitmap.set(QChar::toLower(unit) & 0xff);
+        bitmap.set(QChar::toUpper(unit) & 0xff);
+        bitmap.set(QChar::toTitleCase(unit) & 0xff);
+        bitmap.set(QChar::toCaseFolded(unit) & 0xff);
+    }
+
+    qsizetype minimumLength = 0;
+    QCodeUnitBitmap startingUnits;
+    QCodeUnitBitmap requiredUnits[2];
+    int requiredUnitCount = 0;
+    bool hasStartingUnits = false;
+};
+} // unnamed namespace
+
+QRegularExpressionSetFilter::QRegularExpressionSetFilter(const pcre2_code_16 *code)
+{
+    if (!code)
+        return;
+
+    // a lower bound of the length of a match in characters, and therefore
+    // also in UTF-16 code units
+    uint32_t minLength = 0;
+    pcre2_pattern_info_16(code, PCRE2_INFO_MINLENGTH, &minLength);
+    minimumLength = minLength;
+
+    // every match starts with the first code unit, if any...
+    uint32_t firstCodeType = 0;
+    pcre2_pattern_info_16(code, PCRE2_INFO_FIRSTCODETYPE, &firstCodeType);
+    if (firstCodeType == 1) {
+        uint32_t firstCodeUnit = 0;
+        pcre2_pattern_info_16(code, PCRE2_INFO_FIRSTCODEUNIT, &firstCodeUnit);
+        addRequiredUnit(firstCodeUnit);
+    } else {
+        // ... or with one of the starting code units, if known
+        const uint8_t *firstBitmap = nullptr;
+        pcre2_pattern_info_16(code, PCRE2_INFO_FIRSTBITMAP, &firstBitmap);
+        if (firstBitmap) {
+            hasStartingUnits = true;
+            for (uint unit = 0; unit < 256; ++unit) {
+                if (firstBitmap[unit / 8] & (1u << (unit % 8)))
+                    startingUnits.set(unit);
+            }
+        }
+    }
+
+    // and contains the last literal code unit of the pattern, if any
+    uint32_t lastCodeType = 0;
+    pcre2_pattern_info_16(code, PCRE2_INFO_LASTCODETYPE, &lastCodeType);
+    if (lastCodeType == 1) {
+        uint32_t lastCodeUnit = 0;
+        pcre2_pattern_info_16(code, PCRE2_INFO_LASTCODEUNIT, &lastCodeUnit);
+        addRequiredUnit(lastCodeUnit);
+    }
+}
+
+struct QRegularExpressionSetPrivate : QSharedData
+{
+    void compilePatterns();
+
+    template <typename Function>
+    void forEachMatch(QStringView subject, QRegularExpression::MatchOptions matchOptions,
+                      Function function) const;
+
+    QStringList patterns;
+    QRegularExpression::PatternOptions patternOptions;
+
+    // the following members are rebuilt by compilePatterns() whenever the
+    // patterns or the pattern options change
+    QList<QRegularExpression> regularExpressions;
+    QList<QRegularExpressionSetFilter> filters;
+    bool isValid = true;
+};
+
+/*!
+    \internal
+
+    Compiles all the patterns, so that they can be matched without locking,
+    and builds the filters of the patterns.
+*/
+void QRegularExpressionSetPrivate::compilePatterns()
+{
+    regularExpressions.clear();
+    filters.clear();
+    isValid = true;
+
+    regularExpressions.reserve(patterns.size());
+    filters.reserve(patterns.size());
+    for (const QString &pattern : qAsConst(patterns)) {
+        QRegularExpression re(pattern, patternOptions);
+        re.d->compilePattern();
+        isValid = isValid && re.d->compiledPattern;
+        filters.append(QRegularExpressionSetFilter(re.d->compiledPattern));
+        regularExpressions.append(std::move(re));
+    }
+}
+
+/*!
+    \internal
+
+    Calls \a function with the index of each pattern matching \a subject, in
+    order, for as long as it returns \c true.
+*/
+template <typename Function>
+void QRegularExpressionSetPrivate::forEachMatch(QStringView subject,
+                                                QRegularExpression::MatchOptions matchOptions,
+                                                Function function) const
+{
+    if (regularExpressions.isEmpty())
+        return;
+
+    const QRegularExpressionSubjectSummary summary(subject);
+    // PCRE2 rejects a null subject, even an empty one
+    static const char16_t emptySubject[1] = {};
+    const char16_t *subjectUtf16 = subject.isNull() ? emptySubject : subject.utf16();
+    int pcreOptions = convertToPcreOptions(matchOptions);
+    pcre2_match_context_16 *matchContext = nullptr;
+    pcre2_match_data_16 *matchData = nullptr;
+
+    for (qsizetype i = 0; i < regularExpressions.size(); ++i) {
+        const pcre2_code_16 *code = regularExpressions.at(i).d->compiledPattern;
+        if (!code || !filters.at(i).accepts(summary))
+            continue;
+
+        if (!matchContext) {
+            matchContext = QPcre2Utf16::createMatchContext(&qtPcreCallback<QPcre2Utf16>);
+            // we only need to know whether there was a match
+            matchData = pcre2_match_data_create_16(1, nullptr);
+        }
+
+        const int result = safe_pcre2_match<QPcre2Utf16>(code, subjectUtf16,
+                                                         subject.size(), 0, pcreOptions,
+                                                         matchData, matchContext);
+
+        // The subject only needs to be checked once; if it's not valid
+        // UTF-16, nothing matches it.
+        if (result == PCRE2_ERROR_UTF16_ERR1 || result == PCRE2_ERROR_UTF16_ERR2
+                || result == PCRE2_ERROR_UTF16_ERR3) {
+            break;
+        }
+        pcreOptions |= PCRE2_NO_UTF_CHECK;
+
+        // 0 means that the ovector was too small for the captures
+        if (result >= 0 && !function(i))
+            break;
+    }
+
+    pcre2_match_data_free_16(matchData);
+    pcre2_match_context_free_16(matchContext);
+}
+
+/*!
+    \class QRegularExpressionSet
+    \inmodule QtCore
+    \reentrant
+
+    \brief The QRegularExpressionSet class matches a list of regular
+    expressions against a string at once.
+
+    \since 6.1
+
+    \ingroup tools
+    \ingroup shared
+
+    \keyword regular expression set
+
+    QRegularExpressionSet finds out which of a list of patterns match a
+    subject string, for instance to classify lines of text:
+
+    \snippet code/src_corelib_text_qregularexpression.cpp 36
+
+    This is more efficient than matching a QRegularExpression for each
+    pattern: the patterns are compiled once, when they are set, and the
+    subject string is inspected once for the code units that the patterns
+    require in order to match, so that the patterns that can't match it
+    are skipped without running them.
+
+    All the patterns share the same pattern options. The matching always
+    starts at the beginning of the subject string and only reports whether
+    there was a complete match; use regularExpression() to get the
+    QRegularExpression of a pattern and extract the captured substrings.
+
+    \sa QRegularExpression
+*/
+
+/*!
+    Constructs an empty QRegularExpressionSet.
+
+    \sa setPatterns()
+*/
+QRegularExpressionSet::QRegularExpressionSet()
+    : d(new QRegularExpressionSetPrivate)
+{
+}
+
+/*!
+    Constructs a QRegularExpressionSet object matching the given \a patterns
+    using the pattern \a options.
+
+    \sa setPatterns(), setPatternOptions()
+*/
+QRegularExpressionSet::QRegularExpressionSet(const QStringList &patterns,
+                                             QRegularExpression::PatternOptions options)
+    : d(new QRegularExpressionSetPrivate)
+{
+    d->patterns = patterns;
+    d->patternOptions = options;
+    d->compilePatterns();
+}
+
+/*!
+    Constructs a QRegularExpressionSet object as a copy of \a other.
+*/
+QRegularExpressionSet::QRegularExpressionSet(const QRegularExpressionSet &other)
+    = default;
+
+/*!
+    \fn QRegularExpressionSet::QRegularExpressionSet(QRegularExpressionSet &&other)
+
+    Constructs a QRegularExpressionSet object by moving from \a other.
+
+    Note that a moved-from QRegularExpressionSet can only be destroyed or
+    assigned to. The effect of calling other functions than the destructor
+    or one of the assignment operators is undefined.
+*/
+
+/*!
+    Destroys the QRegularExpressionSet object.
+*/
+QRegularExpressionSet::~QRegularExpressionSet()
+{
+}
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QRegularExpressionSetPrivate)
+
+/*!
+    Assigns \a other to this object and returns a reference to the copy.
+*/
+QRegularExpressionSet &QRegularExpressionSet::operator=(const QRegularExpressionSet &other)
+    = default;
+
+/*!
+    \fn QRegularExpressionSet &QRegularExpressionSet::operator=(QRegularExpressionSet &&other)
+
+    Move-assigns \a other to this object and returns a reference to the
+    result.
+*/
+
+/*!
+    \fn void QRegularExpressionSet::swap(QRegularExpressionSet &other)
+
+    Swaps this object with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    Returns the patterns of the set.
+
+    \sa setPatterns(), size()
+*/
+QStringList QRegularExpressionSet::patterns() const
+{
+    return d->patterns;
+}
+
+/*!
+    Sets the patterns of the set to \a patterns and compiles them.
+
+    \sa patterns(), isValid()
+*/
+void QRegularExpressionSet::setPatterns(const QStringList &patterns)
+{
+    d.detach();
+    d->patterns = patterns;
+    d->compilePatterns();
+}
+
+/*!
+    Returns the pattern options used by all the patterns of the set.
+
+    \sa setPatternOptions()
+*/
+QRegularExpression::PatternOptions QRegularExpressionSet::patternOptions() const
+{
+    return d->patternOptions;
+}
+
+/*!
+    Sets the pattern options used by all the patterns of the set to
+    \a options and compiles the patterns again.
+
+    \sa patternOptions()
+*/
+void QRegularExpressionSet::setPatternOptions(QRegularExpression::PatternOptions options)
+{
+    d.detach();
+    d->patternOptions = options;
+    d->compilePatterns();
+}
+
+/*!
+    Returns the number of patterns in the set.
+*/
+qsizetype QRegularExpressionSet::size() const
+{
+    return d->patterns.size();
+}
+
+/*!
+    Returns the QRegularExpression for the pattern at position \a index in
+    the set; it shares the compiled pattern with the set. \a index must be a
+    valid index position in the set (i.e., 0 <= \a index < size()).
+*/
+QRegularExpression QRegularExpressionSet::regularExpression(qsizetype index) const
+{
+    Q_ASSERT_X(index >= 0 && index < size(), "QRegularExpressionSet::regularExpression", "index out of range");
+    return d->regularExpressions.at(index);
+}
+
+/*!
+    Returns \c true if all the patterns of the set are valid, or false
+    otherwise. Invalid patterns never match.
+
+    \sa QRegularExpression::isValid()
+*/
+bool QRegularExpressionSet::isValid() const
+{
+    return d->isValid;
+}
+
+/*!
+    Returns the indexes, in increasing order, of the patterns of the set that
+    match the \a subject string, using the match options \a matchOptions.
+
+    \sa hasMatch(), QRegularExpression::match()
+*/
+QList<qsizetype> QRegularExpressionSet::matchingIndexes(QStringView subject,
+                                                        QRegularExpression::MatchOptions matchOptions) const
+{
+    QList<qsizetype> result;
+    d->forEachMatch(subject, matchOptions, [&result](qsizetype index) {
+        result.append(index);
+        return true;
+    });
+    return result;
+}
+
+/*!
+    Returns \c true if at least one pattern of the set matches the \a subject
+    string, using the match options \a matchOptions, or false otherwise.
+
+    \sa matchingIndexes()
+*/
+bool QRegularExpressionSet::hasMatch(QStringView subject,
+                                     QRegularExpression::MatchOptions matchOptions) const
+{
+    bool found = false;
+    d->forEachMatch(subject, matchOptions, [&found](qsizetype) {
+        found = true;
+        return false;
+    });
+    return found;
+}
+
 #ifndef QT_NO_DATASTREAM
 /*!
     \relates QRegularExpression
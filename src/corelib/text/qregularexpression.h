@@ -45,6 +45,8 @@
 #include <QtCore/qglobal.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qstringview.h>
+#include <QtCore/qutf8stringview.h>
+#include <QtCore/qbytearrayview.h>
 #include <QtCore/qshareddata.h>
 #include <QtCore/qvariant.h>
 
@@ -147,6 +149,54 @@ public:
                                                 MatchType matchType       = NormalMatch,
                                                 MatchOptions matchOptions = NoMatchOption) const;
 
+private:
+    // Only the views themselves select matching on UTF-8: other arguments
+    // (e.g. string literals and QByteArray) keep converting to QString
+    template <typename T>
+    using if_utf8_view = std::enable_if_t<std::is_same_v<T, QUtf8StringView>
+                                          || std::is_same_v<T, QByteArrayView>, bool>;
+
+public:
+#ifdef Q_CLANG_QDOC
+    [[nodiscard]]
+    QRegularExpressionMatch match(QUtf8StringView subjectView,
+                                  qsizetype offset          = 0,
+                                  MatchType matchType       = NormalMatch,
+                                  MatchOptions matchOptions = NoMatchOption) const;
+
+    [[nodiscard]]
+    QRegularExpressionMatch match(QByteArrayView subjectView,
+                                  qsizetype offset          = 0,
+                                  MatchType matchType       = NormalMatch,
+                                  MatchOptions matchOptions = NoMatchOption) const;
+
+    [[nodiscard]]
+    QRegularExpressionMatchIterator globalMatch(QUtf8StringView subjectView,
+                                                qsizetype offset          = 0,
+                                                MatchType matchType       = NormalMatch,
+                                                MatchOptions matchOptions = NoMatchOption) const;
+
+    [[nodiscard]]
+    QRegularExpressionMatchIterator globalMatch(QByteArrayView subjectView,
+                                                qsizetype offset          = 0,
+                                                MatchType matchType       = NormalMatch,
+                                                MatchOptions matchOptions = NoMatchOption) const;
+#else
+    template <typename T, if_utf8_view<T> = true>
+    [[nodiscard]]
+    QRegularExpressionMatch match(T subjectView,
+                                  qsizetype offset          = 0,
+                                  MatchType matchType       = NormalMatch,
+                                  MatchOptions matchOptions = NoMatchOption) const;
+
+    template <typename T, if_utf8_view<T> = true>
+    [[nodiscard]]
+    QRegularExpressionMatchIterator globalMatch(T subjectView,
+                                                qsizetype offset          = 0,
+                                                MatchType matchType       = NormalMatch,
+                                                MatchOptions matchOptions = NoMatchOption) const;
+#endif
+
     void optimize() const;
 
     enum WildcardConversionOption {
@@ -187,9 +237,20 @@ private:
     friend class QRegularExpressionMatch;
     friend struct QRegularExpressionMatchPrivate;
     friend class QRegularExpressionMatchIterator;
+    friend struct QRegularExpressionSetPrivate;
     friend Q_CORE_EXPORT size_t qHash(const QRegularExpression &key, size_t seed) noexcept;
 
     QRegularExpression(QRegularExpressionPrivate &dd);
+
+    QRegularExpressionMatch matchUtf8(QUtf8StringView subjectView,
+                                      qsizetype offset,
+                                      MatchType matchType,
+                                      MatchOptions matchOptions) const;
+    QRegularExpressionMatchIterator globalMatchUtf8(QUtf8StringView subjectView,
+                                                    qsizetype offset,
+                                                    MatchType matchType,
+                                                    MatchOptions matchOptions) const;
+
     QExplicitlySharedDataPointer<QRegularExpressionPrivate> d;
 };
 
@@ -244,6 +305,9 @@ public:
     QString captured(QStringView name) const;
     QStringView capturedView(QStringView name) const;
 
+    QUtf8StringView capturedUtf8View(int nth = 0) const;
+    QUtf8StringView capturedUtf8View(QStringView name) const;
+
     QStringList capturedTexts() const;
 
     qsizetype capturedStart(int nth = 0) const;
@@ -406,6 +470,70 @@ private:
 
 Q_DECLARE_SHARED(QRegularExpressionMatchIterator)
 
+#ifndef Q_CLANG_QDOC
+template <typename T, QRegularExpression::if_utf8_view<T>>
+inline QRegularExpressionMatch QRegularExpression::match(T subjectView,
+                                                         qsizetype offset,
+                                                         MatchType matchType,
+                                                         MatchOptions matchOptions) const
+{
+    return matchUtf8(QUtf8StringView(subjectView.data(), subjectView.size()),
+                     offset, matchType, matchOptions);
+}
+
+template <typename T, QRegularExpression::if_utf8_view<T>>
+inline QRegularExpressionMatchIterator QRegularExpression::globalMatch(T subjectView,
+                                                                       qsizetype offset,
+                                                                       MatchType matchType,
+                                                                       MatchOptions matchOptions) const
+{
+    return globalMatchUtf8(QUtf8StringView(subjectView.data(), subjectView.size()),
+                           offset, matchType, matchOptions);
+}
+#endif
+
+struct QRegularExpressionSetPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QRegularExpressionSetPrivate, Q_CORE_EXPORT)
+
+class Q_CORE_EXPORT QRegularExpressionSet
+{
+public:
+    QRegularExpressionSet();
+    explicit QRegularExpressionSet(const QStringList &patterns,
+                                   QRegularExpression::PatternOptions options = QRegularExpression::NoPatternOption);
+    QRegularExpressionSet(const QRegularExpressionSet &other);
+    QRegularExpressionSet(QRegularExpressionSet &&other) = default;
+    ~QRegularExpressionSet();
+    QRegularExpressionSet &operator=(const QRegularExpressionSet &other);
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QRegularExpressionSet)
+
+    void swap(QRegularExpressionSet &other) noexcept { d.swap(other.d); }
+
+    QStringList patterns() const;
+    void setPatterns(const QStringList &patterns);
+
+    QRegularExpression::PatternOptions patternOptions() const;
+    void setPatternOptions(QRegularExpression::PatternOptions options);
+
+    qsizetype size() const;
+    QRegularExpression regularExpression(qsizetype index) const;
+
+    [[nodiscard]]
+    bool isValid() const;
+
+    [[nodiscard]]
+    QList<qsizetype> matchingIndexes(QStringView subject,
+                                     QRegularExpression::MatchOptions matchOptions = QRegularExpression::NoMatchOption) const;
+    [[nodiscard]]
+    bool hasMatch(QStringView subject,
+                  QRegularExpression::MatchOptions matchOptions = QRegularExpression::NoMatchOption) const;
+
+private:
+    QExplicitlySharedDataPointer<QRegularExpressionSetPrivate> d;
+};
+
+Q_DECLARE_SHARED(QRegularExpressionSet)
+
 QT_END_NAMESPACE
 
 #endif // QREGULAREXPRESSION_H
@@ -136,6 +136,22 @@ const char16_t QString::_empty = 0;
  * on its own (64-bit glibc on Linux does; 32-bit glibc on Linux returns them
  * 50% of the time), so skipping the alignment prologue is actually optimizing
  * for the common case.
+ *
+ * ** Runtime dispatch: **
+ *
+ * Qt is usually built for the baseline of the architecture, so the code
+ * guarded by #ifdef __SSE2__ is what actually runs on most systems. The
+ * functions with the _avx2 and _avx512 suffixes are compiled for the Haswell
+ * and Skylake-AVX512 sub-architectures with QT_FUNCTION_TARGET and are
+ * selected at runtime with qCpuHasFeature(), which only costs a load and a
+ * test once the CPU features have been detected. If the compiler is already
+ * generating code for that sub-architecture, the check is resolved at compile
+ * time. The dispatchers only take the wide paths when the input is at least
+ * one full vector long, so short strings do not pay for them.
+ *
+ * The AVX2 variants handle the remainder by processing a last vector that
+ * overlaps the previous one, when that is safe, while the AVX512 variants use
+ * masked loads and stores, which never fault on the masked-out elements.
  */
 
 #if defined(__mips_dsp)
@@ -262,6 +278,79 @@ inline RetType UnrollTailLoop<0>::exec(Number, RetType returnIfExited, Functor1,
 }
 #endif
 
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+// Loads 16 characters into 16-bit lanes, zero-extending Latin 1 data
+static Q_ALWAYS_INLINE QT_FUNCTION_TARGET(ARCH_HASWELL) __m256i mm256_load16(const char16_t *ptr)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+}
+
+static Q_ALWAYS_INLINE QT_FUNCTION_TARGET(ARCH_HASWELL) __m256i mm256_load16(const uchar *ptr)
+{
+    return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr)));
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+// Return the masks selecting the first \a n elements of a 32- or 64-element vector
+static Q_ALWAYS_INLINE QT_FUNCTION_TARGET(ARCH_SKYLAKE_AVX512) __mmask32 mm512_mask32_first(qptrdiff n)
+{
+    return n >= 32 ? ~__mmask32(0) : (__mmask32(1) << n) - 1;
+}
+
+static Q_ALWAYS_INLINE QT_FUNCTION_TARGET(ARCH_SKYLAKE_AVX512) __mmask64 mm512_mask64_first(qptrdiff n)
+{
+    return n >= 64 ? ~__mmask64(0) : (__mmask64(1) << n) - 1;
+}
+
+// Loads the 32 characters selected by \a mask into 16-bit lanes, zero-extending
+// Latin 1 data. The other lanes are zeroed and their memory is not accessed.
+static Q_ALWAYS_INLINE QT_FUNCTION_TARGET(ARCH_SKYLAKE_AVX512)
+__m512i mm512_maskz_load32(__mmask32 mask, const char16_t *ptr)
+{
+    return _mm512_maskz_loadu_epi16(mask, ptr);
+}
+
+static Q_ALWAYS_INLINE QT_FUNCTION_TARGET(ARCH_SKYLAKE_AVX512)
+__m512i mm512_maskz_load32(__mmask32 mask, const uchar *ptr)
+{
+    return _mm512_cvtepu8_epi16(_mm256_maskz_loadu_epi8(mask, ptr));
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+// requires e - n >= 16
+static QT_FUNCTION_TARGET(ARCH_HASWELL)
+const char16_t *qustrchr_avx2(const char16_t *n, const char16_t *e, char16_t c) noexcept
+{
+    const __m256i mch = _mm256_set1_epi16(short(c));
+    const char16_t *last = e - 16;
+    for ( ; ; n = qMin(n + 16, last)) {
+        __m256i data = mm256_load16(n);
+        uint mask = uint(_mm256_movemask_epi8(_mm256_cmpeq_epi16(data, mch)));
+        if (mask)
+            return n + qCountTrailingZeroBits(mask) / 2;
+        if (n == last)
+            return e;
+    }
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+static QT_FUNCTION_TARGET(ARCH_SKYLAKE_AVX512)
+const char16_t *qustrchr_avx512(const char16_t *n, const char16_t *e, char16_t c) noexcept
+{
+    const __m512i mch = _mm512_set1_epi16(short(c));
+    for ( ; n < e; n += 32) {
+        __mmask32 valid = mm512_mask32_first(e - n);
+        __m512i data = mm512_maskz_load32(valid, n);
+        if (__mmask32 mask = _mm512_mask_cmpeq_epi16_mask(valid, data, mch))
+            return n + qCountTrailingZeroBits(mask);
+    }
+    return e;
+}
+#endif
+
 /*!
  * \internal
  *
@@ -275,27 +364,19 @@ const char16_t *QtPrivate::qustrchr(QStringView str, char16_t c) noexcept
     const char16_t *n = str.utf16();
     const char16_t *e = n + str.size();
 
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW) && !defined(__OPTIMIZE_SIZE__)
+    if (e - n >= 32 && qCpuHasFeature(ArchSkylakeAvx512))
+        return qustrchr_avx512(n, e, c);
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(AVX2) && !defined(__OPTIMIZE_SIZE__)
+    if (e - n >= 16 && qCpuHasFeature(ArchHaswell))
+        return qustrchr_avx2(n, e, c);
+#endif
+
 #ifdef __SSE2__
-    bool loops = true;
     // Using the PMOVMSKB instruction, we get two bits for each character
     // we compare.
-#  if defined(__AVX2__) && !defined(__OPTIMIZE_SIZE__)
-    // we're going to read n[0..15] (32 bytes)
-    __m256i mch256 = _mm256_set1_epi32(c | (c << 16));
-    for (const char16_t *next = n + 16; next <= e; n = next, next += 16) {
-        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(n));
-        __m256i result = _mm256_cmpeq_epi16(data, mch256);
-        uint mask = uint(_mm256_movemask_epi8(result));
-        if (mask) {
-            uint idx = qCountTrailingZeroBits(mask);
-            return n + idx / 2;
-        }
-    }
-    loops = false;
-    __m128i mch = _mm256_castsi256_si128(mch256);
-#  else
     __m128i mch = _mm_set1_epi32(c | (c << 16));
-#  endif
 
     auto hasMatch = [mch, &n](__m128i data, ushort validityMask) {
         __m128i result = _mm_cmpeq_epi16(data, mch);
@@ -312,11 +393,6 @@ const char16_t *QtPrivate::qustrchr(QStringView str, char16_t c) noexcept
         __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(n));
         if (hasMatch(data, 0xffff))
             return n;
-
-        if (!loops) {
-            n += 8;
-            break;
-        }
     }
 
 #  if !defined(__OPTIMIZE_SIZE__)
@@ -355,12 +431,65 @@ const char16_t *QtPrivate::qustrchr(QStringView str, char16_t c) noexcept
 }
 
 #ifdef __SSE2__
+#  if QT_COMPILER_SUPPORTS_HERE(AVX2)
+// requires end - ptr >= 32
+static QT_FUNCTION_TARGET(ARCH_HASWELL)
+bool simdTestMask_avx2(const char *&ptr, const char *end, quint32 maskval)
+{
+    const __m256i mask = _mm256_set1_epi32(int(maskval));
+    const char *last = end - 32;
+    for ( ; ; ptr = qMin(ptr + 32, last)) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+        if (!_mm256_testz_si256(mask, data)) {
+            // found a character matching the mask
+            __m256i masked = _mm256_and_si256(mask, data);
+            __m256i comparison = _mm256_cmpeq_epi16(masked, _mm256_setzero_si256());
+            ptr += qCountTrailingZeroBits(~uint(_mm256_movemask_epi8(comparison)));
+            return false;
+        }
+        if (ptr == last)
+            break;
+    }
+    ptr = end;
+    return true;
+}
+#  endif
+
+#  if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+// the input must be 16-bit
+static QT_FUNCTION_TARGET(ARCH_SKYLAKE_AVX512)
+bool simdTestMask_avx512(const char *&ptr, const char *end, quint32 maskval)
+{
+    const __m512i mask = _mm512_set1_epi32(int(maskval));
+    const qptrdiff n = (end - ptr) / 2;
+    for (qptrdiff i = 0; i < n; i += 32) {
+        __mmask32 valid = mm512_mask32_first(n - i);
+        __m512i data = _mm512_maskz_loadu_epi16(valid, ptr + 2 * i);
+        if (__mmask32 found = _mm512_test_epi16_mask(data, mask)) {
+            ptr += 2 * (i + qCountTrailingZeroBits(found));
+            return false;
+        }
+    }
+    ptr += 2 * n;
+    return true;
+}
+#  endif
+
 // Scans from \a ptr to \a end until \a maskval is non-zero. Returns true if
 // the no non-zero was found. Returns false and updates \a ptr to point to the
 // first 16-bit word that has any bit set (note: if the input is 8-bit, \a ptr
 // may be updated to one byte short).
 static bool simdTestMask(const char *&ptr, const char *end, quint32 maskval)
 {
+#  if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+    if (end - ptr >= 64 && qCpuHasFeature(ArchSkylakeAvx512))
+        return simdTestMask_avx512(ptr, end, maskval);
+#  endif
+#  if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (end - ptr >= 32 && qCpuHasFeature(ArchHaswell))
+        return simdTestMask_avx2(ptr, end, maskval);
+#  endif
+
     auto updatePtr = [&](uint result) {
         // found a character matching the mask
         uint idx = qCountTrailingZeroBits(~result);
@@ -377,22 +506,6 @@ static bool simdTestMask(const char *&ptr, const char *end, quint32 maskval)
         return updatePtr(result);
     };
 
-#    if defined(__AVX2__)
-    // AVX2 implementation: test 32 bytes at a time
-    const __m256i mask256 = _mm256_broadcastd_epi32(_mm_cvtsi32_si128(maskval));
-    while (ptr + 32 <= end) {
-        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
-        if (!_mm256_testz_si256(mask256, data)) {
-            // found a character matching the mask
-            __m256i masked256 = _mm256_and_si256(mask256, data);
-            __m256i comparison256 = _mm256_cmpeq_epi16(masked256, _mm256_setzero_si256());
-            return updatePtr(_mm256_movemask_epi8(comparison256));
-        }
-        ptr += 32;
-    }
-
-    mask = _mm256_castsi256_si128(mask256);
-#    else
     // SSE 4.1 implementation: test 32 bytes at a time (two 16-byte
     // comparisons, unrolled)
     mask = _mm_set1_epi32(maskval);
@@ -407,9 +520,8 @@ static bool simdTestMask(const char *&ptr, const char *end, quint32 maskval)
             return updatePtrSimd(data2);
         ptr += 16;
     }
-#    endif
 
-    // AVX2 and SSE4.1: final 16-byte comparison
+    // final 16-byte comparison
     if (ptr + 16 <= end) {
         __m128i data1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
         if (!_mm_testz_si128(mask, data1))
@@ -469,24 +581,57 @@ static Q_ALWAYS_INLINE __m128i mm_load8_zero_extend(const void *ptr)
 }
 #endif
 
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+// requires end - ptr >= 32
+static QT_FUNCTION_TARGET(ARCH_HASWELL)
+bool qt_is_ascii_avx2(const char *&ptr, const char *end) noexcept
+{
+    const char *last = end - 32;
+    for ( ; ; ptr = qMin(ptr + 32, last)) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+        if (uint mask = uint(_mm256_movemask_epi8(data))) {
+            ptr += qCountTrailingZeroBits(mask);
+            return false;
+        }
+        if (ptr == last)
+            break;
+    }
+    ptr = end;
+    return true;
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+static QT_FUNCTION_TARGET(ARCH_SKYLAKE_AVX512)
+bool qt_is_ascii_avx512(const char *&ptr, const char *end) noexcept
+{
+    for ( ; ptr < end; ptr += 64) {
+        __m512i data = _mm512_maskz_loadu_epi8(mm512_mask64_first(end - ptr), ptr);
+        if (__mmask64 mask = _mm512_movepi8_mask(data)) {
+            ptr += qCountTrailingZeroBits(quint64(mask));
+            return false;
+        }
+    }
+    ptr = end;
+    return true;
+}
+#endif
+
 // Note: ptr on output may be off by one and point to a preceding US-ASCII
 // character. Usually harmless.
 bool qt_is_ascii(const char *&ptr, const char *end) noexcept
 {
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+    if (end - ptr >= 64 && qCpuHasFeature(ArchSkylakeAvx512))
+        return qt_is_ascii_avx512(ptr, end);
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (end - ptr >= 32 && qCpuHasFeature(ArchHaswell))
+        return qt_is_ascii_avx2(ptr, end);
+#endif
+
 #if defined(__SSE2__)
     // Testing for the high bit can be done efficiently with just PMOVMSKB
-#  if defined(__AVX2__)
-    while (ptr + 32 <= end) {
-        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
-        quint32 mask = _mm256_movemask_epi8(data);
-        if (mask) {
-            uint idx = qCountTrailingZeroBits(mask);
-            ptr += idx;
-            return false;
-        }
-        ptr += 32;
-    }
-#  endif
     while (ptr + 16 <= end) {
         __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
         quint32 mask = _mm_movemask_epi8(data);
@@ -601,8 +746,47 @@ bool QtPrivate::isValidUtf16(QStringView s) noexcept
 }
 
 // conversion between Latin 1 and UTF-16
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+// requires size >= 16
+static QT_FUNCTION_TARGET(ARCH_HASWELL)
+void qt_from_latin1_avx2(char16_t *dst, const char *str, size_t size) noexcept
+{
+    const uchar *src = reinterpret_cast<const uchar *>(str);
+    const size_t last = size - 16;
+    for (size_t offset = 0; ; offset = qMin(offset + 16, last)) {
+        // zero extend to an YMM register and store
+        __m256i extended = mm256_load16(src + offset);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + offset), extended);
+        if (offset == last)
+            break;
+    }
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+static QT_FUNCTION_TARGET(ARCH_SKYLAKE_AVX512)
+void qt_from_latin1_avx512(char16_t *dst, const char *str, size_t size) noexcept
+{
+    const uchar *src = reinterpret_cast<const uchar *>(str);
+    for (size_t offset = 0; offset < size; offset += 32) {
+        __mmask32 valid = mm512_mask32_first(qptrdiff(size - offset));
+        __m512i extended = mm512_maskz_load32(valid, src + offset);
+        _mm512_mask_storeu_epi16(dst + offset, valid, extended);
+    }
+}
+#endif
+
 Q_CORE_EXPORT void qt_from_latin1(char16_t *dst, const char *str, size_t size) noexcept
 {
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+    if (size >= 32 && qCpuHasFeature(ArchSkylakeAvx512))
+        return qt_from_latin1_avx512(dst, str, size);
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (size >= 16 && qCpuHasFeature(ArchHaswell))
+        return qt_from_latin1_avx2(dst, str, size);
+#endif
+
     /* SIMD:
      * Unpacking with SSE has been shown to improve performance on recent CPUs
      * The same method gives no improvement with NEON. On Aarch64, clang will do the vectorization
@@ -615,13 +799,6 @@ Q_CORE_EXPORT void qt_from_latin1(char16_t *dst, const char *str, size_t size) n
     // we're going to read str[offset..offset+15] (16 bytes)
     for ( ; str + offset + 15 < e; offset += 16) {
         const __m128i chunk = _mm_loadu_si128((const __m128i*)(str + offset)); // load
-#ifdef __AVX2__
-        // zero extend to an YMM register
-        const __m256i extended = _mm256_cvtepu8_epi16(chunk);
-
-        // store
-        _mm256_storeu_si256((__m256i*)(dst + offset), extended);
-#else
         const __m128i nullMask = _mm_set1_epi32(0);
 
         // unpack the first 8 bytes, padding with zeros
@@ -631,7 +808,6 @@ Q_CORE_EXPORT void qt_from_latin1(char16_t *dst, const char *str, size_t size) n
         // unpack the last 8 bytes, padding with zeros
         const __m128i secondHalf = _mm_unpackhi_epi8 (chunk, nullMask);
         _mm_storeu_si128((__m128i*)(dst + offset + 8), secondHalf); // store
-#endif
     }
 
     // we're going to read str[offset..offset+7] (8 bytes)
@@ -659,22 +835,82 @@ Q_CORE_EXPORT void qt_from_latin1(char16_t *dst, const char *str, size_t size) n
 #endif
 }
 
+// The conversions to Latin 1 may be done in-place, with dst pointing to the
+// beginning of src. That is safe as long as we only write the bytes of
+// characters that have already been read.
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+// Converts the complete blocks of 16 characters and returns how many
+// characters were converted.
+template <bool Checked>
+static QT_FUNCTION_TARGET(ARCH_HASWELL)
+qsizetype qt_to_latin1_avx2(uchar *dst, const char16_t *src, qsizetype length)
+{
+    const __m256i questionMark = _mm256_set1_epi16('?');
+    const __m256i outOfRange = _mm256_set1_epi16(0x100);
+    qsizetype offset = 0;
+    for ( ; offset + 16 <= length; offset += 16) {
+        __m256i chunk = mm256_load16(src + offset);
+        if (Checked) {
+            // See mergeQuestionMarks lambda in qt_to_latin1_internal for details
+            chunk = _mm256_min_epu16(chunk, outOfRange);
+            const __m256i offLimitMask = _mm256_cmpeq_epi16(chunk, outOfRange);
+            chunk = _mm256_blendv_epi8(chunk, questionMark, offLimitMask);
+        }
+
+        // pack the two halves to 16 x 8bits elements
+        const __m128i chunk2 = _mm256_extracti128_si256(chunk, 1);
+        const __m128i chunk1 = _mm256_castsi256_si128(chunk);
+        const __m128i result = _mm_packus_epi16(chunk1, chunk2);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + offset), result);
+    }
+    return offset;
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+template <bool Checked>
+static QT_FUNCTION_TARGET(ARCH_SKYLAKE_AVX512)
+void qt_to_latin1_avx512(uchar *dst, const char16_t *src, qsizetype length)
+{
+    const __m512i questionMark = _mm512_set1_epi16('?');
+    const __m512i latin1Max = _mm512_set1_epi16(0xff);
+    for (qsizetype offset = 0; offset < length; offset += 32) {
+        __mmask32 valid = mm512_mask32_first(length - offset);
+        __m512i chunk = mm512_maskz_load32(valid, src + offset);
+        if (Checked) {
+            __mmask32 offLimitMask = _mm512_cmpgt_epu16_mask(chunk, latin1Max);
+            chunk = _mm512_mask_blend_epi16(offLimitMask, chunk, questionMark);
+        }
+
+        // narrow to 32 x 8bits elements and store them (VPMOVWB)
+        _mm512_mask_cvtepi16_storeu_epi8(dst + offset, valid, chunk);
+    }
+}
+#endif
+
 template <bool Checked>
 static void qt_to_latin1_internal(uchar *dst, const char16_t *src, qsizetype length)
 {
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+    if (length >= 32 && qCpuHasFeature(ArchSkylakeAvx512))
+        return qt_to_latin1_avx512<Checked>(dst, src, length);
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (length >= 16 && qCpuHasFeature(ArchHaswell)) {
+        // the SSE2 code below converts the remaining characters
+        qsizetype converted = qt_to_latin1_avx2<Checked>(dst, src, length);
+        dst += converted;
+        src += converted;
+        length -= converted;
+    }
+#endif
+
 #if defined(__SSE2__)
     uchar *e = dst + length;
     qptrdiff offset = 0;
 
-#  ifdef __AVX2__
-    const __m256i questionMark256 = _mm256_broadcastw_epi16(_mm_cvtsi32_si128('?'));
-    const __m256i outOfRange256 = _mm256_broadcastw_epi16(_mm_cvtsi32_si128(0x100));
-    const __m128i questionMark = _mm256_castsi256_si128(questionMark256);
-    const __m128i outOfRange = _mm256_castsi256_si128(outOfRange256);
-#  else
     const __m128i questionMark = _mm_set1_epi16('?');
     const __m128i outOfRange = _mm_set1_epi16(0x100);
-#  endif
 
     auto mergeQuestionMarks = [=](__m128i chunk) {
         // SSE has no compare instruction for unsigned comparison.
@@ -709,18 +945,6 @@ static void qt_to_latin1_internal(uchar *dst, const char16_t *src, qsizetype len
 
     // we're going to write to dst[offset..offset+15] (16 bytes)
     for ( ; dst + offset + 15 < e; offset += 16) {
-#  if defined(__AVX2__)
-        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + offset));
-        if (Checked) {
-            // See mergeQuestionMarks lambda above for details
-            chunk = _mm256_min_epu16(chunk, outOfRange256);
-            const __m256i offLimitMask = _mm256_cmpeq_epi16(chunk, outOfRange256);
-            chunk = _mm256_blendv_epi8(chunk, questionMark256, offLimitMask);
-        }
-
-        const __m128i chunk2 = _mm256_extracti128_si256(chunk, 1);
-        const __m128i chunk1 = _mm256_castsi256_si128(chunk);
-#  else
         __m128i chunk1 = _mm_loadu_si128((const __m128i*)(src + offset)); // load
         if (Checked)
             chunk1 = mergeQuestionMarks(chunk1);
@@ -728,7 +952,6 @@ static void qt_to_latin1_internal(uchar *dst, const char16_t *src, qsizetype len
         __m128i chunk2 = _mm_loadu_si128((const __m128i*)(src + offset + 8)); // load
         if (Checked)
             chunk2 = mergeQuestionMarks(chunk2);
-#  endif
 
         // pack the two vector to 16 x 8bits elements
         const __m128i result = _mm_packus_epi16(chunk1, chunk2);
@@ -826,6 +1049,130 @@ void qt_to_latin1_unchecked(uchar *dst, const char16_t *src, qsizetype length)
     qt_to_latin1_internal<false>(dst, src, length);
 }
 
+// Case-insensitive comparison of the US-ASCII prefix of two strings: returns
+// the length of the longest prefix of \a a and \a b that is made of US-ASCII
+// characters only and is equal in both once A-Z are folded to a-z. The caller
+// compares the rest of the strings, starting with the returned position.
+#ifdef __SSE2__
+static Q_ALWAYS_INLINE __m128i mm_load8(const char16_t *ptr)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+}
+
+static Q_ALWAYS_INLINE __m128i mm_load8(const uchar *ptr)
+{
+    return mm_load8_zero_extend(ptr);
+}
+
+template <typename Char>
+static qsizetype ucstricmp_ascii_sse2(const char16_t *a, const Char *b, qsizetype l)
+{
+    const __m128i beforeA = _mm_set1_epi16('A' - 1);
+    const __m128i afterZ = _mm_set1_epi16('Z' + 1);
+    const __m128i caseBit = _mm_set1_epi16(0x20);
+    const __m128i nonAscii = _mm_set1_epi16(short(0xff80));
+    auto fold = [=](__m128i data) {
+        // signed comparisons: characters above U+7FFF are not in the range
+        __m128i isUpper = _mm_and_si128(_mm_cmpgt_epi16(data, beforeA), _mm_cmpgt_epi16(afterZ, data));
+        return _mm_or_si128(data, _mm_and_si128(isUpper, caseBit));
+    };
+
+    qsizetype offset = 0;
+    for ( ; offset + 8 <= l; offset += 8) {
+        __m128i a_data = mm_load8(a + offset);
+        __m128i b_data = mm_load8(b + offset);
+        __m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(a_data, b_data), nonAscii),
+                                        _mm_setzero_si128());
+        __m128i equal = _mm_and_si128(_mm_cmpeq_epi16(fold(a_data), fold(b_data)), ascii);
+        if (uint mask = ushort(~_mm_movemask_epi8(equal)))
+            return offset + qCountTrailingZeroBits(mask) / 2;
+    }
+    return offset;
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+// requires l >= 16
+template <typename Char>
+static QT_FUNCTION_TARGET(ARCH_HASWELL)
+qsizetype ucstricmp_ascii_avx2(const char16_t *a, const Char *b, qsizetype l)
+{
+    const __m256i beforeA = _mm256_set1_epi16('A' - 1);
+    const __m256i afterZ = _mm256_set1_epi16('Z' + 1);
+    const __m256i caseBit = _mm256_set1_epi16(0x20);
+    const __m256i nonAscii = _mm256_set1_epi16(short(0xff80));
+
+    const qsizetype last = l - 16;
+    for (qsizetype offset = 0; ; offset = qMin(offset + 16, last)) {
+        __m256i a_data = mm256_load16(a + offset);
+        __m256i b_data = mm256_load16(b + offset);
+        __m256i a_upper = _mm256_and_si256(_mm256_cmpgt_epi16(a_data, beforeA),
+                                           _mm256_cmpgt_epi16(afterZ, a_data));
+        __m256i b_upper = _mm256_and_si256(_mm256_cmpgt_epi16(b_data, beforeA),
+                                           _mm256_cmpgt_epi16(afterZ, b_data));
+        __m256i a_folded = _mm256_or_si256(a_data, _mm256_and_si256(a_upper, caseBit));
+        __m256i b_folded = _mm256_or_si256(b_data, _mm256_and_si256(b_upper, caseBit));
+        __m256i ascii = _mm256_cmpeq_epi16(_mm256_and_si256(_mm256_or_si256(a_data, b_data), nonAscii),
+                                           _mm256_setzero_si256());
+        __m256i equal = _mm256_and_si256(_mm256_cmpeq_epi16(a_folded, b_folded), ascii);
+        if (uint mask = ~uint(_mm256_movemask_epi8(equal)))
+            return offset + qCountTrailingZeroBits(mask) / 2;
+        if (offset == last)
+            return l;
+    }
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+template <typename Char>
+static QT_FUNCTION_TARGET(ARCH_SKYLAKE_AVX512)
+qsizetype ucstricmp_ascii_avx512(const char16_t *a, const Char *b, qsizetype l)
+{
+    const __m512i upperA = _mm512_set1_epi16('A');
+    const __m512i caseRange = _mm512_set1_epi16('Z' - 'A');
+    const __m512i caseBit = _mm512_set1_epi16(0x20);
+    const __m512i asciiMax = _mm512_set1_epi16(0x7f);
+
+    for (qsizetype offset = 0; offset < l; offset += 32) {
+        __mmask32 valid = mm512_mask32_first(l - offset);
+        __m512i a_data = mm512_maskz_load32(valid, a + offset);
+        __m512i b_data = mm512_maskz_load32(valid, b + offset);
+
+        // unsigned comparison: c - 'A' <= 'Z' - 'A'
+        __mmask32 a_upper = _mm512_cmple_epu16_mask(_mm512_sub_epi16(a_data, upperA), caseRange);
+        __mmask32 b_upper = _mm512_cmple_epu16_mask(_mm512_sub_epi16(b_data, upperA), caseRange);
+        __m512i a_folded = _mm512_mask_add_epi16(a_data, a_upper, a_data, caseBit);
+        __m512i b_folded = _mm512_mask_add_epi16(b_data, b_upper, b_data, caseBit);
+        __mmask32 nonAscii = _mm512_cmpgt_epu16_mask(_mm512_or_si512(a_data, b_data), asciiMax);
+        __mmask32 different = _mm512_cmpneq_epi16_mask(a_folded, b_folded);
+        if (__mmask32 mask = nonAscii | different)
+            return offset + qCountTrailingZeroBits(mask);
+    }
+    return l;
+}
+#endif
+
+template <typename Char>
+static qsizetype ucstricmp_ascii(const char16_t *a, const Char *b, qsizetype l)
+{
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+    if (l >= 32 && qCpuHasFeature(ArchSkylakeAvx512))
+        return ucstricmp_ascii_avx512(a, b, l);
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (l >= 16 && qCpuHasFeature(ArchHaswell))
+        return ucstricmp_ascii_avx2(a, b, l);
+#endif
+#ifdef __SSE2__
+    return ucstricmp_ascii_sse2(a, b, l);
+#else
+    Q_UNUSED(a);
+    Q_UNUSED(b);
+    Q_UNUSED(l);
+    return 0;
+#endif
+}
+
 // Unicode case-insensitive comparison
 static int ucstricmp(const QChar *a, const QChar *ae, const QChar *b, const QChar *be)
 {
@@ -836,6 +1183,13 @@ static int ucstricmp(const QChar *a, const QChar *ae, const QChar *b, const QCha
     if (be - b < ae - a)
         e = a + (be - b);
 
+    // skip the common US-ASCII prefix; it contains no surrogates, so
+    // alast and blast below need no adjustment
+    const qsizetype prefix = ucstricmp_ascii(reinterpret_cast<const char16_t *>(a),
+                                             reinterpret_cast<const char16_t *>(b), e - a);
+    a += prefix;
+    b += prefix;
+
     char32_t alast = 0;
     char32_t blast = 0;
     while (a < e) {
@@ -863,6 +1217,11 @@ static int ucstricmp(const QChar *a, const QChar *ae, const char *b, const char
     if (be - b < ae - a)
         e = a + (be - b);
 
+    const qsizetype prefix = ucstricmp_ascii(reinterpret_cast<const char16_t *>(a),
+                                             reinterpret_cast<const uchar *>(b), e - a);
+    a += prefix;
+    b += prefix;
+
     while (a < e) {
         int diff = foldCase(a->unicode()) - foldCase(char16_t{uchar(*b)});
         if ((diff))
@@ -907,6 +1266,47 @@ static int ucstricmp8(const char *utf8, const char *utf8end, const QChar *utf16,
     return (end1 > src1) - int(src2.hasNext());
 }
 
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+// requires l >= 16
+template <typename Char>
+static QT_FUNCTION_TARGET(ARCH_HASWELL)
+int ucstrncmp_avx2(const char16_t *a, const Char *b, size_t l)
+{
+    const size_t last = l - 16;
+    for (size_t offset = 0; ; offset = qMin(offset + 16, last)) {
+        __m256i a_data = mm256_load16(a + offset);
+        __m256i b_data = mm256_load16(b + offset);
+        __m256i result = _mm256_cmpeq_epi16(a_data, b_data);
+        if (uint mask = ~uint(_mm256_movemask_epi8(result))) {
+            // found a different character
+            size_t idx = offset + qCountTrailingZeroBits(mask) / 2;
+            return a[idx] - b[idx];
+        }
+        if (offset == last)
+            return 0;
+    }
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+template <typename Char>
+static QT_FUNCTION_TARGET(ARCH_SKYLAKE_AVX512)
+int ucstrncmp_avx512(const char16_t *a, const Char *b, size_t l)
+{
+    for (size_t offset = 0; offset < l; offset += 32) {
+        __mmask32 valid = mm512_mask32_first(qptrdiff(l - offset));
+        __m512i a_data = mm512_maskz_load32(valid, a + offset);
+        __m512i b_data = mm512_maskz_load32(valid, b + offset);
+        if (__mmask32 mask = _mm512_cmpneq_epi16_mask(a_data, b_data)) {
+            // found a different character
+            size_t idx = offset + qCountTrailingZeroBits(mask);
+            return a[idx] - b[idx];
+        }
+    }
+    return 0;
+}
+#endif
+
 #if defined(__mips_dsp)
 // From qstring_mips_dsp_asm.S
 extern "C" int qt_ucstrncmp_mips_dsp_asm(const char16_t *a,
@@ -927,6 +1327,16 @@ static int ucstrncmp(const QChar *a, const QChar *b, size_t l)
     }
     return 0;
 #else
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+    if (l >= 32 && qCpuHasFeature(ArchSkylakeAvx512))
+        return ucstrncmp_avx512(reinterpret_cast<const char16_t *>(a),
+                                reinterpret_cast<const char16_t *>(b), l);
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (l >= 16 && qCpuHasFeature(ArchHaswell))
+        return ucstrncmp_avx2(reinterpret_cast<const char16_t *>(a),
+                              reinterpret_cast<const char16_t *>(b), l);
+#endif
 #if defined(__mips_dsp)
     static_assert(sizeof(uint) == sizeof(size_t));
     if (l >= 8) {
@@ -954,12 +1364,6 @@ static int ucstrncmp(const QChar *a, const QChar *b, size_t l)
 
     // we're going to read a[0..15] and b[0..15] (32 bytes)
     for ( ; end - a >= offset + 16; offset += 16) {
-#ifdef __AVX2__
-        __m256i a_data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + offset));
-        __m256i b_data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + offset));
-        __m256i result = _mm256_cmpeq_epi16(a_data, b_data);
-        uint mask = _mm256_movemask_epi8(result);
-#else
         __m128i a_data1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + offset));
         __m128i a_data2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + offset + 8));
         __m128i b_data1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + offset));
@@ -967,7 +1371,6 @@ static int ucstrncmp(const QChar *a, const QChar *b, size_t l)
         __m128i result1 = _mm_cmpeq_epi16(a_data1, b_data1);
         __m128i result2 = _mm_cmpeq_epi16(a_data2, b_data2);
         uint mask = _mm_movemask_epi8(result1) | (_mm_movemask_epi8(result2) << 16);
-#endif
         mask = ~mask;
         if (mask) {
             // found a different character
@@ -1082,6 +1485,15 @@ static int ucstrncmp(const QChar *a, const uchar *c, size_t l)
     const char16_t *uc = reinterpret_cast<const char16_t *>(a);
     const char16_t *e = uc + l;
 
+#if QT_COMPILER_SUPPORTS_HERE(AVX512BW) && !defined(__OPTIMIZE_SIZE__)
+    if (l >= 32 && qCpuHasFeature(ArchSkylakeAvx512))
+        return ucstrncmp_avx512(uc, c, l);
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(AVX2) && !defined(__OPTIMIZE_SIZE__)
+    if (l >= 16 && qCpuHasFeature(ArchHaswell))
+        return ucstrncmp_avx2(uc, c, l);
+#endif
+
 #ifdef __SSE2__
     __m128i nullmask = _mm_setzero_si128();
     qptrdiff offset = 0;
@@ -1108,16 +1520,6 @@ static int ucstrncmp(const QChar *a, const uchar *c, size_t l)
         // load 16 bytes of Latin 1 data
         __m128i chunk = _mm_loadu_si128((const __m128i*)(c + offset));
 
-#  ifdef __AVX2__
-        // expand Latin 1 data via zero extension
-        __m256i ldata = _mm256_cvtepu8_epi16(chunk);
-
-        // load UTF-16 data and compare
-        __m256i ucdata = _mm256_loadu_si256((const __m256i*)(uc + offset));
-        __m256i result = _mm256_cmpeq_epi16(ldata, ucdata);
-
-        uint mask = ~_mm256_movemask_epi8(result);
-#  else
         // expand via unpacking
         __m128i firstHalf = _mm_unpacklo_epi8(chunk, nullmask);
         __m128i secondHalf = _mm_unpackhi_epi8(chunk, nullmask);
@@ -1129,7 +1531,6 @@ static int ucstrncmp(const QChar *a, const uchar *c, size_t l)
         __m128i result2 = _mm_cmpeq_epi16(secondHalf, ucdata2);
 
         uint mask = ~(_mm_movemask_epi8(result1) | _mm_movemask_epi8(result2) << 16);
-#  endif
         if (mask) {
             // found a different character
             uint idx = qCountTrailingZeroBits(mask);
@@ -209,29 +209,66 @@ static inline bool simdDecodeAscii(ushort *&dst, const uchar *&nextAscii, const
     return src == end;
 }
 
-static inline const uchar *simdFindNonAscii(const uchar *src, const uchar *end, const uchar *&nextAscii)
+#  if QT_COMPILER_SUPPORTS_HERE(AVX2)
+// requires end - src >= 32
+static QT_FUNCTION_TARGET(ARCH_HASWELL)
+const uchar *simdFindNonAscii_avx2(const uchar *src, const uchar *end, const uchar *&nextAscii)
 {
-#ifdef __AVX2__
-    // do 32 characters at a time
-    // (this is similar to simdTestMask in qstring.cpp)
-    const __m256i mask = _mm256_set1_epi8(0x80);
-    for ( ; end - src >= 32; src += 32) {
+    // do 32 characters at a time, the last block overlapping with the one
+    // before it (this is similar to simdTestMask in qstring.cpp)
+    const __m256i mask = _mm256_set1_epi8(char(0x80));
+    const uchar *last = end - 32;
+    for ( ; ; src = qMin(src + 32, last)) {
         __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
-        if (_mm256_testz_si256(mask, data))
-            continue;
+        if (!_mm256_testz_si256(mask, data)) {
+            uint n = _mm256_movemask_epi8(data);
+            Q_ASSUME(n);
 
-        uint n = _mm256_movemask_epi8(data);
-        Q_ASSUME(n);
+            // find the next probable ASCII character
+            // we don't want to load 32 bytes again in this loop if we know there are non-ASCII
+            // characters still coming
+            nextAscii = src + qBitScanReverse(n) + 1;
 
-        // find the next probable ASCII character
-        // we don't want to load 32 bytes again in this loop if we know there are non-ASCII
-        // characters still coming
-        nextAscii = src + qBitScanReverse(n) + 1;
+            // return the non-ASCII character
+            return src + qCountTrailingZeroBits(n);
+        }
+        if (src == last)
+            break;
+    }
+    nextAscii = end;
+    return end;
+}
+#  endif
 
-        // return the non-ASCII character
-        return src + qCountTrailingZeroBits(n);
+#  if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+static QT_FUNCTION_TARGET(ARCH_SKYLAKE_AVX512)
+const uchar *simdFindNonAscii_avx512(const uchar *src, const uchar *end, const uchar *&nextAscii)
+{
+    // do 64 characters at a time, using a masked load for the last block
+    for ( ; src < end; src += 64) {
+        const qptrdiff len = end - src;
+        __mmask64 valid = len >= 64 ? ~__mmask64(0) : (__mmask64(1) << len) - 1;
+        __m512i data = _mm512_maskz_loadu_epi8(valid, src);
+        if (quint64 n = _mm512_movepi8_mask(data)) {
+            nextAscii = src + (63 - qCountLeadingZeroBits(n)) + 1;
+            return src + qCountTrailingZeroBits(n);
+        }
     }
-#endif
+    nextAscii = end;
+    return end;
+}
+#  endif
+
+static inline const uchar *simdFindNonAscii(const uchar *src, const uchar *end, const uchar *&nextAscii)
+{
+#  if QT_COMPILER_SUPPORTS_HERE(AVX512BW)
+    if (end - src >= 64 && qCpuHasFeature(ArchSkylakeAvx512))
+        return simdFindNonAscii_avx512(src, end, nextAscii);
+#  endif
+#  if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (end - src >= 32 && qCpuHasFeature(ArchHaswell))
+        return simdFindNonAscii_avx2(src, end, nextAscii);
+#  endif
 
     // do sixteen characters at a time
     for ( ; end - src >= 16; src += 16) {
@@ -360,6 +397,341 @@ static void simdCompareAscii(const char8_t *&src8, const char8_t *end8, const ch
     src8 += offset;
     src16 += offset;
 }
+
+// The multi-byte kernels below transcode whole blocks of UTF-8 or UTF-16,
+// including the non-ASCII characters, and validate them at the same time.
+// They stop before the first invalid or incomplete sequence and leave it to
+// the scalar code, which knows how to report and replace it, so they never
+// change the result. Unlike simdEncodeAscii and simdDecodeAscii, they don't
+// require the whole block to be of the same kind and will make progress as
+// long as the first character is valid.
+#  if QT_COMPILER_SUPPORTS_HERE(AVX2)
+
+static inline QT_FUNCTION_TARGET(ARCH_HASWELL) __m256i mm256_load8(const uchar *ptr)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+}
+
+// loads 16 bytes zero-extended to 16-bit lanes
+static inline QT_FUNCTION_TARGET(ARCH_HASWELL) __m256i mm256_load16(const uchar *ptr)
+{
+    return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr)));
+}
+
+struct SimdShuffleTable { alignas(16) uchar shuffle[256][16]; };
+
+// pshufb masks packing the 16-bit words selected by an 8-bit mask to the front
+static constexpr SimdShuffleTable utf16PackTable = [] {
+    SimdShuffleTable t = {};
+    for (uint mask = 0; mask < 256; ++mask) {
+        uint j = 0;
+        for (uint i = 0; i < 8; ++i) {
+            if (mask & (1u << i)) {
+                t.shuffle[mask][j++] = uchar(2 * i);
+                t.shuffle[mask][j++] = uchar(2 * i + 1);
+            }
+        }
+        while (j < 16)
+            t.shuffle[mask][j++] = 0x80;
+    }
+    return t;
+}();
+
+// pshufb masks packing eight 1- or 2-byte UTF-8 sequences stored in 16-bit
+// lanes; the index selects the lanes of two bytes
+static constexpr SimdShuffleTable utf8PackTable16 = [] {
+    SimdShuffleTable t = {};
+    for (uint mask = 0; mask < 256; ++mask) {
+        uint j = 0;
+        for (uint i = 0; i < 8; ++i) {
+            t.shuffle[mask][j++] = uchar(2 * i);
+            if (mask & (1u << i))
+                t.shuffle[mask][j++] = uchar(2 * i + 1);
+        }
+        while (j < 16)
+            t.shuffle[mask][j++] = 0x80;
+    }
+    return t;
+}();
+
+// pshufb masks packing four 1- to 3-byte UTF-8 sequences stored in 32-bit
+// lanes; the low nibble of the index selects the lanes of two or more bytes
+// and the high nibble the lanes of three bytes
+static constexpr SimdShuffleTable utf8PackTable = [] {
+    SimdShuffleTable t = {};
+    for (uint mask = 0; mask < 256; ++mask) {
+        uint j = 0;
+        for (uint i = 0; i < 4; ++i) {
+            uint len = 1 + ((mask >> i) & 1) + ((mask >> (i + 4)) & 1);
+            for (uint k = 0; k < len; ++k)
+                t.shuffle[mask][j++] = uchar(4 * i + k);
+        }
+        while (j < 16)
+            t.shuffle[mask][j++] = 0x80;
+    }
+    return t;
+}();
+
+// requires end - src >= 32 and src - begin >= 3; leaves at least one byte for the caller
+static QT_FUNCTION_TARGET(ARCH_HASWELL)
+void simdDecodeMultiByte_avx2(ushort *&dst, const uchar *&src, const uchar *end)
+{
+    // The previous bytes are loaded from memory, so they must not belong to
+    // an incomplete sequence, as happens after the scalar code has found an
+    // error. Once in the loop, src always follows a valid character.
+    if (src[-1] >= 0xc0 || src[-2] >= 0xe0 || src[-3] >= 0xf0)
+        return;
+
+    const __m128i *table = reinterpret_cast<const __m128i *>(utf16PackTable.shuffle);
+    do {
+        // Check the structure: every lead byte must be followed by the right
+        // number of continuation bytes and no other byte may be one. The
+        // saturated subtractions leave the high bit set for the lead bytes of
+        // at least two, three and four bytes respectively.
+        const __m256i data = mm256_load8(src);
+        const __m256i required = _mm256_or_si256(_mm256_subs_epu8(mm256_load8(src - 1), _mm256_set1_epi8(0x40)),
+                                                 _mm256_or_si256(_mm256_subs_epu8(mm256_load8(src - 2), _mm256_set1_epi8(0x60)),
+                                                                 _mm256_subs_epu8(mm256_load8(src - 3), _mm256_set1_epi8(0x70))));
+        const __m256i isCont = _mm256_cmpgt_epi8(_mm256_set1_epi8(-0x40), data);   // 0x80 to 0xbf
+        const uint requiredMask = _mm256_movemask_epi8(required);
+        const uint structureMask = requiredMask ^ _mm256_movemask_epi8(isCont);
+
+        // 0xc0 and 0xc1 can only start overlong sequences
+        uint invalidMask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(data, _mm256_set1_epi8(char(0xfe))),
+                                                                  _mm256_set1_epi8(char(0xc0))));
+
+        __m256i result[2];
+        uint lead4Mask = 0;
+        if (_mm256_movemask_epi8(_mm256_subs_epu8(data, _mm256_set1_epi8(0x60)))) {
+            // three- and four-byte sequences; the range of the decoded values
+            // tells us whether the sequences were overlong or surrogates
+            // (which also rejects 0xf5 to 0xff, beyond U+10FFFF)
+            __m256i invalid[2];
+            for (int i = 0; i < 2; ++i) {
+                const __m256i c = mm256_load16(src + 16 * i);
+                const __m256i p1 = mm256_load16(src + 16 * i - 1);
+                const __m256i p2 = mm256_load16(src + 16 * i - 2);
+                const __m256i low6 = _mm256_and_si256(c, _mm256_set1_epi16(0x3f));
+                const __m256i mid6 = _mm256_slli_epi16(_mm256_and_si256(p1, _mm256_set1_epi16(0x3f)), 6);
+                const __m256i p1Lead2 = _mm256_cmpgt_epi16(p1, _mm256_set1_epi16(0xbf));
+                const __m256i p1Lead3 = _mm256_cmpgt_epi16(p1, _mm256_set1_epi16(0xdf));
+                const __m256i p2Lead3 = _mm256_cmpgt_epi16(p2, _mm256_set1_epi16(0xdf));
+                const __m256i p2Lead4 = _mm256_cmpgt_epi16(p2, _mm256_set1_epi16(0xef));
+                const __m256i p3Lead4 = _mm256_cmpgt_epi16(mm256_load16(src + 16 * i - 3), _mm256_set1_epi16(0xef));
+                const __m256i is2 = _mm256_andnot_si256(p1Lead3, p1Lead2);
+                const __m256i is3 = _mm256_andnot_si256(p2Lead4, p2Lead3);
+
+                // two bytes: 110yyyyy 10xxxxxx
+                __m256i value = _mm256_or_si256(_mm256_and_si256(mid6, _mm256_set1_epi16(0x7c0)), low6);
+                result[i] = _mm256_blendv_epi8(c, value, is2);
+
+                // three bytes: 1110zzzz 10yyyyyy 10xxxxxx (the shift drops the 1110)
+                value = _mm256_or_si256(_mm256_slli_epi16(p2, 12), _mm256_or_si256(mid6, low6));
+                result[i] = _mm256_blendv_epi8(result[i], value, is3);
+                const __m256i top5 = _mm256_and_si256(value, _mm256_set1_epi16(short(0xf800)));
+                invalid[i] = _mm256_and_si256(is3, _mm256_or_si256(_mm256_cmpeq_epi16(top5, _mm256_setzero_si256()),
+                                                                   _mm256_cmpeq_epi16(top5, _mm256_set1_epi16(short(0xd800)))));
+
+                // four bytes, high surrogate: 11110www 10zzzzzz 10yyyyyy (10xxxxxx)
+                value = _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(p2, _mm256_set1_epi16(0x0f)), 8),
+                                        _mm256_srli_epi16(_mm256_or_si256(mid6, low6), 4));
+                value = _mm256_sub_epi16(value, _mm256_set1_epi16(0x10000 >> 10));
+                invalid[i] = _mm256_or_si256(invalid[i], _mm256_andnot_si256(
+                        _mm256_cmpeq_epi16(_mm256_and_si256(value, _mm256_set1_epi16(short(0xfc00))), _mm256_setzero_si256()),
+                        p2Lead4));
+                result[i] = _mm256_blendv_epi8(result[i], _mm256_add_epi16(value, _mm256_set1_epi16(short(0xd800))), p2Lead4);
+
+                // four bytes, low surrogate: (11110www 10zzzzzz) 10yyyyyy 10xxxxxx
+                value = _mm256_or_si256(_mm256_set1_epi16(short(0xdc00)),
+                                        _mm256_or_si256(_mm256_and_si256(mid6, _mm256_set1_epi16(0x3c0)), low6));
+                result[i] = _mm256_blendv_epi8(result[i], value, p3Lead4);
+            }
+
+            invalidMask |= _mm256_movemask_epi8(_mm256_permute4x64_epi64(_mm256_packs_epi16(invalid[0], invalid[1]),
+                                                                          _MM_SHUFFLE(3, 1, 2, 0)));
+            lead4Mask = _mm256_movemask_epi8(_mm256_subs_epu8(mm256_load8(src - 2), _mm256_set1_epi8(0x70)));
+        } else {
+            // one- and two-byte sequences only
+            for (int i = 0; i < 2; ++i) {
+                const __m256i c = mm256_load16(src + 16 * i);
+                const __m256i p1 = mm256_load16(src + 16 * i - 1);
+                const __m256i value = _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi16(p1, 6), _mm256_set1_epi16(0x7c0)),
+                                                      _mm256_and_si256(c, _mm256_set1_epi16(0x3f)));
+                result[i] = _mm256_blendv_epi8(c, value, _mm256_cmpgt_epi16(p1, _mm256_set1_epi16(0xbf)));
+            }
+        }
+
+        // Decode the characters that end before the first error, leaving
+        // the error to the scalar code. We can't tell whether the last byte
+        // ends a character, so it's left for the next block.
+        uint endMask = ~(requiredMask >> 1) & 0x7fffffff;
+        if (const uint errorMask = structureMask | invalidMask) {
+            endMask &= (1u << qCountTrailingZeroBits(errorMask)) - 1;
+            if (!endMask)
+                return;
+        }
+
+        // pack the characters and store; the high surrogate of a four-byte
+        // sequence goes in the place of its third byte
+        const uint outputMask = endMask | (lead4Mask & (endMask >> 1));
+        for (int i = 0; i < 2; ++i) {
+            const uint mask = outputMask >> (16 * i);
+            const __m128i lo = _mm_shuffle_epi8(_mm256_castsi256_si128(result[i]),
+                                                _mm_load_si128(table + (mask & 0xff)));
+            const __m128i hi = _mm_shuffle_epi8(_mm256_extracti128_si256(result[i], 1),
+                                                _mm_load_si128(table + ((mask >> 8) & 0xff)));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), lo);
+            dst += qPopulationCount(mask & 0xff);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), hi);
+            dst += qPopulationCount(mask & 0xff00);
+        }
+        src += qBitScanReverse(endMask) + 1;
+    } while (end - src >= 32);
+}
+
+// requires end - src >= 16; leaves at least one character for the caller
+static QT_FUNCTION_TARGET(ARCH_HASWELL)
+void simdEncodeMultiByte_avx2(uchar *&dst, const ushort *&src, const ushort *end)
+{
+    do {
+        if (end - src > 16) {
+            // Sixteen characters below U+0800, which is all that most
+            // alphabetic scripts need, encode to one or two bytes each in a
+            // 16-bit lane: 110yyyyy 10xxxxxx
+            const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+            if (_mm256_testz_si256(c, _mm256_set1_epi16(short(0xf800)))) {
+                const __m256i is2 = _mm256_cmpgt_epi16(c, _mm256_set1_epi16(0x7f));
+                const __m256i value = _mm256_or_si256(_mm256_or_si256(_mm256_srli_epi16(c, 6),
+                                                                      _mm256_slli_epi16(_mm256_and_si256(c, _mm256_set1_epi16(0x3f)), 8)),
+                                                      _mm256_set1_epi16(short(0x80c0)));
+                const __m256i result = _mm256_blendv_epi8(c, value, is2);
+                const uint mask = _mm256_movemask_epi8(_mm256_packs_epi16(is2, _mm256_setzero_si256()));
+                const __m128i *table = reinterpret_cast<const __m128i *>(utf8PackTable16.shuffle);
+                const __m128i lo = _mm_shuffle_epi8(_mm256_castsi256_si128(result),
+                                                    _mm_load_si128(table + (mask & 0xff)));
+                const __m128i hi = _mm_shuffle_epi8(_mm256_extracti128_si256(result, 1),
+                                                    _mm_load_si128(table + ((mask >> 16) & 0xff)));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), lo);
+                dst += 8 + qPopulationCount(mask & 0xff);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), hi);
+                dst += 8 + qPopulationCount(mask & 0xff0000);
+                src += 16;
+                continue;
+            }
+        }
+
+        // Otherwise, build the UTF-8 sequence of each of eight characters in
+        // a 32-bit lane
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        const __m256i c = _mm256_cvtepu16_epi32(data);
+        const __m256i low6 = _mm256_or_si256(_mm256_and_si256(c, _mm256_set1_epi32(0x3f)),
+                                             _mm256_set1_epi32(0x80));
+        const __m256i mid6 = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(c, 6), _mm256_set1_epi32(0x3f)),
+                                             _mm256_set1_epi32(0x80));
+        const __m256i is2 = _mm256_cmpgt_epi32(c, _mm256_set1_epi32(0x7f));
+        const __m256i is3 = _mm256_cmpgt_epi32(c, _mm256_set1_epi32(0x7ff));
+
+        // two bytes: 110yyyyy 10xxxxxx
+        __m256i value = _mm256_or_si256(_mm256_or_si256(_mm256_srli_epi32(c, 6), _mm256_set1_epi32(0xc0)),
+                                        _mm256_slli_epi32(low6, 8));
+        __m256i result = _mm256_blendv_epi8(c, value, is2);
+
+        // three bytes: 1110zzzz 10yyyyyy 10xxxxxx
+        value = _mm256_or_si256(_mm256_or_si256(_mm256_srli_epi32(c, 12), _mm256_set1_epi32(0xe0)),
+                                _mm256_or_si256(_mm256_slli_epi32(mid6, 8), _mm256_slli_epi32(low6, 16)));
+        result = _mm256_blendv_epi8(result, value, is3);
+
+        const uint mask2 = _mm256_movemask_ps(_mm256_castsi256_ps(is2));
+        uint mask3 = _mm256_movemask_ps(_mm256_castsi256_ps(is3));
+        uint count = 8;
+        uint errorMask = 0;
+        const __m128i surrogateMask = _mm_set1_epi16(short(0xf800));
+        const __m128i isSurrogate = _mm_cmpeq_epi16(_mm_and_si128(data, surrogateMask), _mm_set1_epi16(short(0xd800)));
+        if (_mm_movemask_epi8(isSurrogate)) {
+            // surrogates must come in pairs; we can't check the last
+            // character's pair, so a high surrogate there is left for the
+            // next block
+            const __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 1));
+            const __m128i prev = _mm_slli_si128(data, 2);
+            const __m128i lowBit = _mm_set1_epi16(0x400);
+            const __m128i isLow = _mm_and_si128(isSurrogate, _mm_cmpeq_epi16(_mm_and_si128(data, lowBit), lowBit));
+            const __m128i isHigh = _mm_andnot_si128(isLow, isSurrogate);
+            const __m128i nextIsLow = _mm_cmpeq_epi16(_mm_and_si128(next, _mm_set1_epi16(short(0xfc00))),
+                                                      _mm_set1_epi16(short(0xdc00)));
+            const __m128i prevIsHigh = _mm_cmpeq_epi16(_mm_and_si128(prev, _mm_set1_epi16(short(0xfc00))),
+                                                       _mm_set1_epi16(short(0xd800)));
+            const __m128i error = _mm_or_si128(_mm_andnot_si128(nextIsLow, isHigh),
+                                               _mm_andnot_si128(prevIsHigh, isLow));
+            errorMask = _mm_movemask_epi8(_mm_packs_epi16(error, _mm_setzero_si128()));
+            count = qCountTrailingZeroBits(errorMask | 0x100);
+            if (count == 8 && (_mm_movemask_epi8(isHigh) & 0x8000))
+                count = 7;
+            if (!count)
+                return;
+
+            // high surrogate, first half of 11110www 10zzzzzz 10yyyyyy 10xxxxxx
+            const __m256i plane = _mm256_add_epi32(_mm256_and_si256(c, _mm256_set1_epi32(0x3ff)),
+                                                   _mm256_set1_epi32(0x10000 >> 10));
+            value = _mm256_or_si256(_mm256_or_si256(_mm256_srli_epi32(plane, 8), _mm256_set1_epi32(0xf0)),
+                                    _mm256_slli_epi32(_mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(plane, 2),
+                                                                                       _mm256_set1_epi32(0x3f)),
+                                                                      _mm256_set1_epi32(0x80)), 8));
+            result = _mm256_blendv_epi8(result, value, _mm256_cvtepi16_epi32(isHigh));
+
+            // low surrogate, second half
+            const __m256i p = _mm256_cvtepu16_epi32(prev);
+            value = _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(p, _mm256_set1_epi32(0x3)), 4),
+                                    _mm256_and_si256(mid6, _mm256_set1_epi32(0x8f)));
+            value = _mm256_or_si256(value, _mm256_slli_epi32(low6, 8));
+            result = _mm256_blendv_epi8(result, value, _mm256_cvtepi16_epi32(isLow));
+
+            // surrogates take two bytes each
+            mask3 &= ~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cvtepi16_epi32(isSurrogate)));
+        }
+
+        // pack the sequences and store
+        const __m128i *table = reinterpret_cast<const __m128i *>(utf8PackTable.shuffle);
+        const __m128i lo = _mm_shuffle_epi8(_mm256_castsi256_si128(result),
+                                            _mm_load_si128(table + ((mask2 & 0xf) | (mask3 & 0xf) << 4)));
+        const __m128i hi = _mm_shuffle_epi8(_mm256_extracti128_si256(result, 1),
+                                            _mm_load_si128(table + ((mask2 >> 4) | (mask3 & 0xf0))));
+        const uint loLength = 4 + qPopulationCount(mask2 & 0xf) + qPopulationCount(mask3 & 0xf);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + loLength), hi);
+
+        const uint countMask = (1u << count) - 1;
+        dst += count + qPopulationCount(mask2 & countMask) + qPopulationCount(mask3 & countMask);
+        src += count;
+        if (errorMask)
+            return;
+    } while (end - src >= 16);
+}
+#  endif
+
+static inline void simdEncodeMultiByte(uchar *&dst, const ushort *&src, const ushort *end)
+{
+#  if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (end - src >= 16 && qCpuHasFeature(ArchHaswell))
+        simdEncodeMultiByte_avx2(dst, src, end);
+#  else
+    Q_UNUSED(dst);
+    Q_UNUSED(src);
+    Q_UNUSED(end);
+#  endif
+}
+
+static inline void simdDecodeMultiByte(ushort *&dst, const uchar *&src, const uchar *begin, const uchar *end)
+{
+#  if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (end - src >= 32 && src - begin >= 3 && qCpuHasFeature(ArchHaswell))
+        simdDecodeMultiByte_avx2(dst, src, end);
+#  else
+    Q_UNUSED(dst);
+    Q_UNUSED(src);
+    Q_UNUSED(begin);
+    Q_UNUSED(end);
+#  endif
+}
 #elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64) // vaddv is only available on Aarch64
 static inline bool simdEncodeAscii(uchar *&dst, const ushort *&nextAscii, const ushort *&src, const ushort *end)
 {
@@ -460,6 +832,14 @@ static inline const uchar *simdFindNonAscii(const uchar *src, const uchar *end,
 static void simdCompareAscii(const char8_t *&, const char8_t *, const char16_t *&, const char16_t *)
 {
 }
+
+static inline void simdEncodeMultiByte(uchar *&, const ushort *&, const ushort *)
+{
+}
+
+static inline void simdDecodeMultiByte(ushort *&, const uchar *&, const uchar *, const uchar *)
+{
+}
 #else
 static inline bool simdEncodeAscii(uchar *, const ushort *, const ushort *, const ushort *)
 {
@@ -480,6 +860,14 @@ static inline const uchar *simdFindNonAscii(const uchar *src, const uchar *end,
 static void simdCompareAscii(const char8_t *&, const char8_t *, const char16_t *&, const char16_t *)
 {
 }
+
+static inline void simdEncodeMultiByte(uchar *&, const ushort *&, const ushort *)
+{
+}
+
+static inline void simdDecodeMultiByte(ushort *&, const uchar *&, const uchar *, const uchar *)
+{
+}
 #endif
 
 enum { HeaderDone = 1 };
@@ -500,6 +888,7 @@ QByteArray QUtf8::convertFromUnicode(QStringView in)
             break;
 
         do {
+            simdEncodeMultiByte(dst, src, end);
             ushort u = *src++;
             int res = QUtf8Functions::toUtf8<QUtf8BaseTraits>(u, dst, src, end);
             if (res < 0) {
@@ -567,6 +956,7 @@ char *QUtf8::convertFromUnicode(char *out, QStringView in, QStringConverter::Sta
             break;
 
         do {
+            simdEncodeMultiByte(cursor, src, end);
             ushort uc = *src++;
             int res = QUtf8Functions::toUtf8<QUtf8BaseTraits>(uc, cursor, src, end);
             if (Q_LIKELY(res >= 0))
@@ -654,6 +1044,7 @@ QChar *QUtf8::convertToUnicode(QChar *buffer, QByteArrayView in) noexcept
                 break;
 
             do {
+                simdDecodeMultiByte(dst, src, start, end);
                 uchar b = *src++;
                 int res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, dst, src, end);
                 if (res < 0) {
@@ -757,6 +1148,7 @@ QChar *QUtf8::convertToUnicode(QChar *out, QByteArrayView in, QStringConverter::
         if (src >= nextAscii && simdDecodeAscii(dst, nextAscii, src, end))
             break;
 
+        simdDecodeMultiByte(dst, src, reinterpret_cast<const uchar *>(in.data()), end);
         ch = *src++;
         res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(ch, dst, src, end);
         if (res == QUtf8BaseTraits::Error) {
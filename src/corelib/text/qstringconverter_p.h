@@ -337,7 +337,7 @@ struct QUtf8
         bool isValidUtf8;
         bool isValidAscii;
     };
-    static ValidUtf8Result isValidUtf8(QByteArrayView in);
+    Q_CORE_EXPORT static ValidUtf8Result isValidUtf8(QByteArrayView in);
     static int compareUtf8(QByteArrayView utf8, QStringView utf16) noexcept;
     static int compareUtf8(QByteArrayView utf8, QLatin1String s);
 };
@@ -0,0 +1,549 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QCOROUTINE_H
+#define QCOROUTINE_H
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qabstracteventdispatcher.h>
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qfuture.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+
+QT_REQUIRE_CONFIG(future);
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtCoroutine {
+template<typename T = void>
+class Task;
+}
+
+namespace QtPrivate {
+
+class CoroutineResumeContext
+{
+public:
+    // Only a thread that runs an event loop (or, for the main thread, is
+    // about to) can be posted back to. Anywhere else, and if that thread's
+    // event dispatcher is gone by the time the awaited operation completes,
+    // the coroutine simply continues on whichever thread completed it.
+    static CoroutineResumeContext current()
+    {
+        CoroutineResumeContext context;
+        QThread *thread = QThread::currentThread();
+        const QCoreApplication *app = QCoreApplication::instance();
+        if (thread->loopLevel() > 0 || (app && app->thread() == thread))
+            context.receiver = QAbstractEventDispatcher::instance(thread);
+        return context;
+    }
+
+    void resume(std::coroutine_handle<> handle) const
+    {
+        transfer(handle).resume();
+    }
+
+    // Suitable as the return value of await_suspend(): continues directly
+    // when already on the right thread, posts the resumption otherwise.
+    std::coroutine_handle<> transfer(std::coroutine_handle<> handle) const
+    {
+        QObject *object = receiver.data();
+        if (!object || object->thread() == QThread::currentThread())
+            return handle;
+        QMetaObject::invokeMethod(object, [handle] { handle.resume(); }, Qt::QueuedConnection);
+        return std::noop_coroutine();
+    }
+
+private:
+    QPointer<QObject> receiver;
+};
+
+class TaskPromiseBase
+{
+public:
+    enum State { Running, Awaited, Finished, Detached };
+
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept { return false; }
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept
+        {
+            return self.promise().complete(self);
+        }
+        void await_resume() const noexcept { }
+    };
+
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() noexcept
+    {
+#ifndef QT_NO_EXCEPTIONS
+        exception = std::current_exception();
+#endif
+    }
+
+    bool isFinished() const noexcept { return state.loadAcquire() == Finished; }
+    bool isCanceled() const noexcept { return isFinished() && canceled; }
+
+    // Returns false if the task finished in the meantime, in which case
+    // \a awaiting must not suspend.
+    bool setContinuation(std::coroutine_handle<> awaiting, TaskPromiseBase *awaitingTask)
+    {
+        continuation = awaiting;
+        continuationContext = CoroutineResumeContext::current();
+        continuationTask = awaitingTask;
+        return state.testAndSetOrdered(Running, Awaited);
+    }
+
+    // Called when the owning Task goes away; whoever comes last frees the frame.
+    void detach(std::coroutine_handle<> self) noexcept
+    {
+        if (state.fetchAndStoreOrdered(Detached) == Finished)
+            self.destroy();
+    }
+
+    // Finishes the task without resuming it: \a self stays suspended where it
+    // awaited something that got canceled, until the frame is destroyed.
+    void cancel(std::coroutine_handle<> self) noexcept
+    {
+        canceled = true;
+        complete(self).resume();
+    }
+
+    std::coroutine_handle<> complete(std::coroutine_handle<> self) noexcept
+    {
+        // Once the state is published the frame may be destroyed by the owner
+        // at any time, so nothing may touch *this after the exchange unless
+        // the owner is known to be suspended on us (Awaited).
+        switch (state.fetchAndStoreOrdered(Finished)) {
+        case Detached:
+            self.destroy();
+            break;
+        case Awaited:
+            if (canceled && continuationTask) {
+                continuationTask->cancel(continuation);
+                break;
+            }
+            return continuationContext.transfer(continuation);
+        default:
+            break;
+        }
+        return std::noop_coroutine();
+    }
+
+protected:
+    void rethrowIfFailed() const
+    {
+#ifndef QT_NO_EXCEPTIONS
+        if (exception)
+            std::rethrow_exception(exception);
+#endif
+        Q_ASSERT_X(!canceled, "QtCoroutine::Task", "The task was canceled and has no result");
+    }
+
+private:
+    QAtomicInt state = Running;
+    bool canceled = false;
+    std::coroutine_handle<> continuation;
+    CoroutineResumeContext continuationContext;
+    TaskPromiseBase *continuationTask = nullptr;
+#ifndef QT_NO_EXCEPTIONS
+    std::exception_ptr exception;
+#endif
+};
+
+template<typename Promise>
+TaskPromiseBase *awaitingTask(std::coroutine_handle<Promise> handle) noexcept
+{
+    if constexpr (std::is_base_of_v<TaskPromiseBase, Promise>)
+        return &handle.promise();
+    else
+        return nullptr;
+}
+
+// A Task that awaits something which gets canceled is canceled as well;
+// other coroutines are resumed and hit the precondition in await_resume().
+inline void resumeOrCancel(std::coroutine_handle<> handle, const CoroutineResumeContext &context,
+                           TaskPromiseBase *task, bool canceled)
+{
+    if (canceled && task)
+        task->cancel(handle);
+    else
+        context.resume(handle);
+}
+
+template<typename T>
+class TaskPromise : public TaskPromiseBase
+{
+public:
+    QtCoroutine::Task<T> get_return_object() noexcept;
+
+    template<typename U = T>
+    void return_value(U &&value) { storage.emplace(std::forward<U>(value)); }
+
+    const T &result() const
+    {
+        rethrowIfFailed();
+        return *storage;
+    }
+
+    T takeResult()
+    {
+        rethrowIfFailed();
+        return std::move(*storage);
+    }
+
+private:
+    std::optional<T> storage;
+};
+
+template<>
+class TaskPromise<void> : public TaskPromiseBase
+{
+public:
+    QtCoroutine::Task<void> get_return_object() noexcept;
+
+    void return_void() noexcept { }
+    void result() const { rethrowIfFailed(); }
+    void takeResult() { rethrowIfFailed(); }
+};
+
+template<typename T>
+class FutureAwaiter
+{
+public:
+    explicit FutureAwaiter(const QFuture<T> &future) : future(future) { }
+
+    // A canceled future always goes through await_suspend() so that an
+    // awaiting Task can be canceled instead of resumed.
+    bool await_ready() const { return future.isFinished() && !future.isCanceled(); }
+
+    template<typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> handle)
+    {
+        // The continuation may resume (and destroy) the awaiting frame before
+        // addContinuation() returns, so don't call it on a member. Adding
+        // keeps other coroutines awaiting the same future, and a continuation
+        // attached with then(), from being dropped.
+        QFuture<T> parent = future;
+        parent.d.addContinuation([handle, context = CoroutineResumeContext::current(),
+                                  task = awaitingTask(handle)](const QFutureInterfaceBase &d) {
+            resumeOrCancel(handle, context, task, isCanceledWithoutException(d));
+        });
+    }
+
+    T await_resume()
+    {
+        future.waitForFinished(); // rethrows a reported exception
+        if constexpr (!std::is_void_v<T>) {
+            Q_ASSERT_X(future.resultCount() > 0, "co_await QFuture",
+                       "The awaited future was canceled and has no result");
+            if constexpr (std::is_copy_constructible_v<T>)
+                return future.result();
+            else
+                return future.takeResult();
+        }
+    }
+
+private:
+    static bool isCanceledWithoutException(const QFutureInterfaceBase &d)
+    {
+        if (!d.isCanceled())
+            return false;
+#ifndef QT_NO_EXCEPTIONS
+        return !const_cast<QFutureInterfaceBase &>(d).exceptionStore().hasException();
+#else
+        return true;
+#endif
+    }
+
+    QFuture<T> future;
+};
+
+template<typename Sender, typename Signal>
+class SignalAwaiter
+{
+    using ArgsType = typename ArgResolver<Signal>::AllArgs;
+
+    struct State
+    {
+        std::coroutine_handle<> handle;
+        CoroutineResumeContext context;
+        TaskPromiseBase *task = nullptr;
+        QMetaObject::Connection destroyed;
+        QAtomicInt done = 0;
+        bool senderDestroyed = false;
+        std::conditional_t<std::is_void_v<ArgsType>, bool, std::optional<ArgsType>> args;
+    };
+
+public:
+    SignalAwaiter(Sender *sender, Signal signal) : sender(sender), signal(signal) { }
+
+    bool await_ready() const noexcept { return false; }
+
+    template<typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> handle)
+    {
+        // Nothing may touch *this once the second connection exists: the
+        // signal can fire on another thread and resume the coroutine.
+        const std::shared_ptr<State> s = std::make_shared<State>();
+        state = s;
+        s->handle = handle;
+        s->context = CoroutineResumeContext::current();
+        s->task = awaitingTask(handle);
+
+        // The connections don't use an object of the awaiting thread as
+        // context: they would be dropped, and the coroutine never resumed,
+        // if that thread finished first. The context posts the resumption
+        // to the awaiting thread instead.
+        const auto type = Qt::ConnectionType(Qt::SingleShotConnection | Qt::DirectConnection);
+        s->destroyed = QObject::connect(sender, &QObject::destroyed, sender, [s] {
+            if (!s->done.testAndSetOrdered(0, 1))
+                return;
+            s->senderDestroyed = true;
+            resumeOrCancel(s->handle, s->context, s->task, true);
+        }, type);
+
+        if constexpr (std::is_void_v<ArgsType>) {
+            QObject::connect(sender, signal, sender, [s] {
+                if (claim(s))
+                    s->context.resume(s->handle);
+            }, type);
+        } else if constexpr (isTupleV<ArgsType>) {
+            QObject::connect(sender, signal, sender, [s](auto... values) {
+                if (!claim(s))
+                    return;
+                s->args.emplace(std::move(values)...);
+                s->context.resume(s->handle);
+            }, type);
+        } else {
+            QObject::connect(sender, signal, sender, [s](ArgsType value) {
+                if (!claim(s))
+                    return;
+                s->args.emplace(std::move(value));
+                s->context.resume(s->handle);
+            }, type);
+        }
+    }
+
+    auto await_resume()
+    {
+        Q_ASSERT_X(!state->senderDestroyed, "QtCoroutine::signal",
+                   "The sender was destroyed before emitting the signal");
+        if constexpr (!std::is_void_v<ArgsType>)
+            return std::move(*state->args);
+    }
+
+private:
+    static bool claim(const std::shared_ptr<State> &s)
+    {
+        if (!s->done.testAndSetOrdered(0, 1))
+            return false;
+        QObject::disconnect(s->destroyed);
+        return true;
+    }
+
+    Sender *sender;
+    Signal signal;
+    std::shared_ptr<State> state;
+};
+
+class ThreadPoolAwaiter
+{
+public:
+    ThreadPoolAwaiter(QThreadPool *pool, int priority) : pool(pool), priority(priority) { }
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        pool->start([handle] { handle.resume(); }, priority);
+    }
+    void await_resume() const noexcept { }
+
+private:
+    QThreadPool *pool;
+    int priority;
+};
+
+class ThreadAffinityAwaiter
+{
+public:
+    explicit ThreadAffinityAwaiter(QObject *context) : context(context) { }
+
+    bool await_ready() const { return context->thread() == QThread::currentThread(); }
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        QMetaObject::invokeMethod(context, [handle] { handle.resume(); }, Qt::QueuedConnection);
+    }
+    void await_resume() const noexcept { }
+
+private:
+    QObject *context;
+};
+
+} // namespace QtPrivate
+
+namespace QtCoroutine {
+
+template<typename T>
+class Task
+{
+    template<bool TakeResult>
+    struct Awaiter
+    {
+        std::coroutine_handle<QtPrivate::TaskPromise<T>> handle;
+
+        bool await_ready() const noexcept { return handle.promise().isFinished(); }
+
+        template<typename Promise>
+        bool await_suspend(std::coroutine_handle<Promise> awaiting)
+        {
+            return handle.promise().setContinuation(awaiting, QtPrivate::awaitingTask(awaiting));
+        }
+
+        decltype(auto) await_resume() const
+        {
+            if constexpr (TakeResult)
+                return handle.promise().takeResult();
+            else
+                return handle.promise().result();
+        }
+    };
+
+public:
+    using promise_type = QtPrivate::TaskPromise<T>;
+
+    Task() noexcept = default;
+    Task(Task &&other) noexcept : handle(std::exchange(other.handle, nullptr)) { }
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_MOVE_AND_SWAP(Task)
+    ~Task()
+    {
+        if (handle)
+            handle.promise().detach(handle);
+    }
+
+    void swap(Task &other) noexcept { qSwap(handle, other.handle); }
+
+    bool isValid() const noexcept { return bool(handle); }
+    bool isFinished() const noexcept { return handle && handle.promise().isFinished(); }
+    bool isCanceled() const noexcept { return handle && handle.promise().isCanceled(); }
+
+    decltype(auto) result() const
+    {
+        Q_ASSERT_X(isFinished(), "QtCoroutine::Task::result", "The task has not finished yet");
+        return handle.promise().result();
+    }
+
+    Awaiter<false> operator co_await() const & noexcept
+    {
+        Q_ASSERT(handle);
+        return { handle };
+    }
+
+    Awaiter<true> operator co_await() && noexcept
+    {
+        Q_ASSERT(handle);
+        return { handle };
+    }
+
+private:
+    friend class QtPrivate::TaskPromise<T>;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle(handle) { }
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+template<typename Sender, typename Signal,
+         typename = QtPrivate::EnableIfInvocable<Sender, Signal>>
+QtPrivate::SignalAwaiter<Sender, Signal> signal(Sender *sender, Signal signal)
+{
+    return { sender, signal };
+}
+
+inline QtPrivate::ThreadPoolAwaiter
+resumeOnThreadPool(QThreadPool *pool = QThreadPool::globalInstance(), int priority = 0)
+{
+    return { pool, priority };
+}
+
+inline QtPrivate::ThreadAffinityAwaiter resumeOnThreadOf(QObject *context)
+{
+    return QtPrivate::ThreadAffinityAwaiter(context);
+}
+
+} // namespace QtCoroutine
+
+template<typename T>
+QtCoroutine::Task<T> QtPrivate::TaskPromise<T>::get_return_object() noexcept
+{
+    return QtCoroutine::Task<T>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+}
+
+inline QtCoroutine::Task<void> QtPrivate::TaskPromise<void>::get_return_object() noexcept
+{
+    return QtCoroutine::Task<void>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+}
+
+template<typename T>
+QtPrivate::FutureAwaiter<T> operator co_await(const QFuture<T> &future)
+{
+    return QtPrivate::FutureAwaiter<T>(future);
+}
+
+QT_END_NAMESPACE
+
+#endif // __cpp_impl_coroutine
+
+#endif // QCOROUTINE_H
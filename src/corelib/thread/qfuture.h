@@ -153,6 +153,9 @@ QT_WARNING_POP
     template<typename U = T, typename = QtPrivate::EnableForNonVoid<U>>
     T takeResult() { return d.takeResult(); }
 
+    template<typename U = T, typename = QtPrivate::EnableForNonVoid<U>>
+    QList<T> takeReadyResults() { return d.takeReadyResults(); }
+
 #if 0
     // TODO: Enable and make it return a QList, when QList is fixed to support move-only types
     template<typename U = T, typename = QtPrivate::EnableForNonVoid<U>>
@@ -313,6 +316,9 @@ private:
     friend class QtPrivate::FailureHandler;
 #endif
 
+    template<typename U>
+    friend class QtPrivate::FutureAwaiter;
+
     using QFuturePrivate =
             std::conditional_t<std::is_same_v<T, void>, QFutureInterfaceBase, QFutureInterface<T>>;
 
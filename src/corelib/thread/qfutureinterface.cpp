@@ -757,6 +757,26 @@ void QFutureInterfaceBase::setContinuation(std::function<void(const QFutureInter
     }
 }
 
+// Like setContinuation(), but runs \a func after the continuation already set,
+// instead of replacing it. Used for coroutines awaiting the future, of which
+// there can be several.
+void QFutureInterfaceBase::addContinuation(std::function<void(const QFutureInterfaceBase &)> func)
+{
+    QMutexLocker lock(&d->continuationMutex);
+    if (isFinished()) {
+        lock.unlock();
+        func(*this);
+    } else if (d->continuation) {
+        d->continuation = [first = std::move(d->continuation), second = std::move(func)](
+                                  const QFutureInterfaceBase &fi) {
+            first(fi);
+            second(fi);
+        };
+    } else {
+        d->continuation = std::move(func);
+    }
+}
+
 void QFutureInterfaceBase::runContinuation() const
 {
     QMutexLocker lock(&d->continuationMutex);
@@ -71,6 +71,9 @@ class CanceledHandler;
 template<class Function, class ResultType>
 class FailureHandler;
 #endif
+
+template<typename T>
+class FutureAwaiter;
 }
 
 class Q_CORE_EXPORT QFutureInterfaceBase
@@ -191,8 +194,12 @@ private:
     friend class QtPrivate::FailureHandler;
 #endif
 
+    template<typename T>
+    friend class QtPrivate::FutureAwaiter;
+
 protected:
     void setContinuation(std::function<void(const QFutureInterfaceBase &)> func);
+    void addContinuation(std::function<void(const QFutureInterfaceBase &)> func);
     void runContinuation() const;
 
     void setLaunchAsync(bool value);
@@ -253,6 +260,7 @@ public:
     inline QList<T> results();
 
     T takeResult();
+    QList<T> takeReadyResults();
 #if 0
     // TODO: Enable and make it return a QList, when QList is fixed to support move-only types
     std::vector<T> takeResults();
@@ -394,6 +402,18 @@ T QFutureInterface<T>::takeResult()
     return ret;
 }
 
+template<typename T>
+QList<T> QFutureInterface<T>::takeReadyResults()
+{
+    Q_ASSERT(isValid());
+
+    if (this->isCanceled())
+        exceptionStore().throwPossibleException();
+
+    const std::lock_guard<QMutex> locker{mutex()};
+    return resultStoreBase().template takeReadyResults<T>();
+}
+
 #if 0
 template<typename T>
 std::vector<T> QFutureInterface<T>::takeResults()
@@ -0,0 +1,238 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qplatformdefs.h"
+#include "qlockcontentionprofiler_p.h"
+
+#include <QtCore/qdebug.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+
+#include <qtcore_tracepoints_p.h>
+
+#include <algorithm>
+#include <utility>
+
+#if QT_CONFIG(dlopen)
+#  include <dlfcn.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QLockContentionProfiler
+    \inmodule QtCore
+    \internal
+
+    \brief The QLockContentionProfiler class reports which locks threads
+    had to wait for, and from where.
+
+    Profiling is off by default. The uncontended paths of QMutex,
+    QRecursiveMutex and QReadWriteLock are not affected at all, and the
+    contended paths check a single relaxed atomic in that state. Once
+    enabled with setEnabled(), every wait for a lock held by another
+    thread is recorded with the code address the lock was requested from,
+    and the number of waits as well as the total and longest wait time
+    are accumulated per call site and lock type.
+
+    Waits in QReadWriteLock include waiting for the readers to leave a
+    lock in the QReadWriteLock::ScalableReaders mode. Locks taken by
+    QReadWriteLock and QWaitCondition internally are recorded with call
+    sites inside QtCore.
+
+    Each wait is also emitted through the \c QLockContention_wait
+    tracepoint while profiling is enabled.
+
+    snapshot(), report() and reset() may be called from any thread.
+*/
+
+QBasicAtomicInt QLockContentionProfiler::enabled = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+namespace {
+struct ContentionData
+{
+    QMutex mutex;
+    QHash<std::pair<int, const void *>, QLockContentionProfiler::Entry> entries;
+};
+Q_GLOBAL_STATIC(ContentionData, contentionData)
+
+// Waiting for the mutex in record() would otherwise itself be recorded
+thread_local bool recordingContention = false;
+
+const char *lockTypeName(QLockContentionProfiler::LockType type)
+{
+    switch (type) {
+    case QLockContentionProfiler::Mutex: return "QMutex";
+    case QLockContentionProfiler::RecursiveMutex: return "QRecursiveMutex";
+    case QLockContentionProfiler::ReadLock: return "QReadWriteLock(read)";
+    case QLockContentionProfiler::WriteLock: return "QReadWriteLock(write)";
+    }
+    Q_UNREACHABLE();
+    return nullptr;
+}
+
+QString describeCallSite(const void *callSite)
+{
+#if QT_CONFIG(dlopen)
+    Dl_info info;
+    if (callSite && dladdr(callSite, &info)) {
+        if (info.dli_sname) {
+            return QString::asprintf("%s+0x%llx", info.dli_sname,
+                                     qulonglong(quintptr(callSite) - quintptr(info.dli_saddr)));
+        }
+        if (info.dli_fname) {
+            return QString::asprintf("%s+0x%llx", info.dli_fname,
+                                     qulonglong(quintptr(callSite) - quintptr(info.dli_fbase)));
+        }
+    }
+#endif
+    return QString::asprintf("%p", callSite);
+}
+}
+
+/*!
+    Enables or disables lock contention profiling according to
+    \a enable. Previously recorded values are kept; use reset() to clear
+    them.
+*/
+void QLockContentionProfiler::setEnabled(bool enable)
+{
+    if (enable)
+        contentionData(); // make sure it is not created while recording
+    enabled.storeRelaxed(enable);
+}
+
+/*!
+    \fn bool QLockContentionProfiler::isEnabled()
+
+    Returns \c true if lock contention is being recorded.
+*/
+
+/*!
+    Returns the contended call sites recorded so far, the ones with the
+    longest total wait time first.
+*/
+QList<QLockContentionProfiler::Entry> QLockContentionProfiler::snapshot()
+{
+    QList<Entry> result;
+    if (!contentionData.exists())
+        return result;
+    {
+        QMutexLocker locker(&contentionData->mutex);
+        result = contentionData->entries.values();
+    }
+    std::sort(result.begin(), result.end(), [](const Entry &lhs, const Entry &rhs) {
+        return lhs.totalWaitNSecs > rhs.totalWaitNSecs;
+    });
+    return result;
+}
+
+/*!
+    Clears the contention recorded so far.
+*/
+void QLockContentionProfiler::reset()
+{
+    if (!contentionData.exists())
+        return;
+    QMutexLocker locker(&contentionData->mutex);
+    contentionData->entries.clear();
+}
+
+/*!
+    Returns a human readable report of the contention recorded so far,
+    one line per call site, in the order of snapshot(). Call sites are
+    resolved to symbols where the platform allows it.
+*/
+QString QLockContentionProfiler::report()
+{
+    const QList<Entry> entries = snapshot();
+    QString result = QString::asprintf("Lock contention: %lld contended call sites\n",
+                                       qlonglong(entries.size()));
+    for (const Entry &entry : entries) {
+        result += QString::asprintf("%-22s %8llu waits %12.3f ms total %10.3f ms max  lock %p  at ",
+                                    lockTypeName(entry.type), entry.waits,
+                                    entry.totalWaitNSecs / 1e6, entry.maxWaitNSecs / 1e6,
+                                    entry.lock);
+        result += describeCallSite(entry.callSite);
+        result += QLatin1Char('\n');
+    }
+    return result;
+}
+
+/*!
+    Prints report() with qInfo().
+*/
+void QLockContentionProfiler::dumpReport()
+{
+    const QString text = report();
+    for (const QStringView line : QStringView(text).split(QLatin1Char('\n'), Qt::SkipEmptyParts))
+        qInfo().noquote() << line;
+}
+
+/*!
+    \internal
+
+    Records that acquiring \a lock of the given \a type from \a callSite
+    had to wait for \a nsecs nanoseconds.
+*/
+void QLockContentionProfiler::record(LockType type, const void *lock, const void *callSite,
+                                     qint64 nsecs)
+{
+    ContentionData *data = contentionData();
+    if (!data || recordingContention)
+        return;
+    recordingContention = true;
+
+    Q_TRACE(QLockContention_wait, int(type), lock, callSite, nsecs);
+    {
+        QMutexLocker locker(&data->mutex);
+        Entry &entry = data->entries[std::make_pair(int(type), callSite)];
+        entry.type = type;
+        entry.callSite = callSite;
+        entry.lock = lock;
+        ++entry.waits;
+        entry.totalWaitNSecs += nsecs;
+        entry.maxWaitNSecs = qMax(entry.maxWaitNSecs, nsecs);
+    }
+
+    recordingContention = false;
+}
+
+QT_END_NAMESPACE
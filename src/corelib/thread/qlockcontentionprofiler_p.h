@@ -0,0 +1,139 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QLOCKCONTENTIONPROFILER_P_H
+#define QLOCKCONTENTIONPROFILER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+
+#if defined(Q_CC_MSVC)
+#  include <intrin.h>
+#endif
+
+QT_REQUIRE_CONFIG(thread);
+
+// The address a contended lock was acquired from. Must be used directly in
+// the out-of-line function called by the inline locking functions.
+#if defined(Q_CC_GNU) || defined(Q_CC_CLANG)
+#  define QT_LOCK_CALL_SITE() __builtin_return_address(0)
+#elif defined(Q_CC_MSVC)
+#  define QT_LOCK_CALL_SITE() _ReturnAddress()
+#else
+#  define QT_LOCK_CALL_SITE() nullptr
+#endif
+
+QT_BEGIN_NAMESPACE
+
+class Q_CORE_EXPORT QLockContentionProfiler
+{
+public:
+    enum LockType { Mutex, RecursiveMutex, ReadLock, WriteLock };
+
+    struct Entry
+    {
+        LockType type = Mutex;
+        const void *callSite = nullptr;
+        const void *lock = nullptr; // the lock most recently contended at callSite
+        quint64 waits = 0;
+        qint64 totalWaitNSecs = 0;
+        qint64 maxWaitNSecs = 0;
+    };
+
+    static void setEnabled(bool enable);
+    static bool isEnabled() noexcept { return enabled.loadRelaxed(); }
+    static QList<Entry> snapshot();
+    static void reset();
+    static QString report();
+    static void dumpReport();
+
+    static void record(LockType type, const void *lock, const void *callSite, qint64 nsecs);
+
+private:
+    static QBasicAtomicInt enabled;
+};
+
+// Times one wait for a contended lock. Does nothing unless start() was
+// called while profiling is enabled; later calls to start() are ignored.
+class QLockContentionTimer
+{
+    Q_DISABLE_COPY_MOVE(QLockContentionTimer)
+
+    const void *lock = nullptr;
+    const void *callSite = nullptr;
+    QLockContentionProfiler::LockType type = QLockContentionProfiler::Mutex;
+    QElapsedTimer timer;
+
+public:
+    QLockContentionTimer() = default;
+    ~QLockContentionTimer()
+    {
+        if (Q_UNLIKELY(lock))
+            QLockContentionProfiler::record(type, lock, callSite, timer.nsecsElapsed());
+    }
+
+    void start(QLockContentionProfiler::LockType lockType, const void *contendedLock,
+               const void *contendedCallSite)
+    {
+        if (Q_LIKELY(!QLockContentionProfiler::isEnabled()) || lock)
+            return;
+        type = lockType;
+        lock = contendedLock;
+        callSite = contendedCallSite;
+        timer.start();
+    }
+};
+
+QT_END_NAMESPACE
+
+#endif // QLOCKCONTENTIONPROFILER_P_H
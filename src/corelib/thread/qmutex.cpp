@@ -46,6 +46,7 @@
 #include "qelapsedtimer.h"
 #include "qthread.h"
 #include "qmutex_p.h"
+#include "qlockcontentionprofiler_p.h"
 
 #ifndef QT_LINUX_FUTEX
 #include "private/qfreelist_p.h"
@@ -332,13 +333,9 @@ bool QRecursiveMutex::tryLock(int timeout) QT_MUTEX_LOCK_NOEXCEPT
         Q_ASSERT_X(count != 0, "QMutex::lock", "Overflow in recursion counter");
         return true;
     }
-    bool success = true;
-    if (timeout == -1) {
-        mutex.lock();
-    } else {
-        success = mutex.tryLock(timeout);
-    }
-
+    // record contention for this QRecursiveMutex and our caller, not for the QMutex
+    const bool success = mutex.fastTryLock()
+            || mutex.lockInternal(timeout, QT_LOCK_CALL_SITE(), this);
     if (success)
         owner.storeRelaxed(self);
     return success;
@@ -537,7 +534,7 @@ void QRecursiveMutex::unlock() noexcept
  */
 void QBasicMutex::lockInternal() QT_MUTEX_LOCK_NOEXCEPT
 {
-    lockInternal(-1);
+    lockInternal(-1, QT_LOCK_CALL_SITE(), nullptr);
 }
 
 /*!
@@ -545,6 +542,27 @@ void QBasicMutex::lockInternal() QT_MUTEX_LOCK_NOEXCEPT
  */
 bool QBasicMutex::lockInternal(int timeout) QT_MUTEX_LOCK_NOEXCEPT
 {
+    return lockInternal(timeout, QT_LOCK_CALL_SITE(), nullptr);
+}
+
+/*!
+    \internal
+
+    Contended path of lock() and tryLock(). The wait is recorded by
+    QLockContentionProfiler for \a callSite, as a wait for
+    \a recursiveMutex if this is the mutex inside a QRecursiveMutex.
+ */
+bool QBasicMutex::lockInternal(int timeout, const void *callSite,
+                               const QRecursiveMutex *recursiveMutex) QT_MUTEX_LOCK_NOEXCEPT
+{
+    QLockContentionTimer contention;
+    if (timeout != 0) {
+        if (recursiveMutex)
+            contention.start(QLockContentionProfiler::RecursiveMutex, recursiveMutex, callSite);
+        else
+            contention.start(QLockContentionProfiler::Mutex, this, callSite);
+    }
+
     while (!fastTryLock()) {
         QMutexPrivate *copy = d_ptr.loadAcquire();
         if (!copy) // if d is 0, the mutex is unlocked
@@ -132,6 +132,8 @@ private:
 
     void lockInternal() QT_MUTEX_LOCK_NOEXCEPT;
     bool lockInternal(int timeout) QT_MUTEX_LOCK_NOEXCEPT;
+    bool lockInternal(int timeout, const void *callSite,
+                      const QRecursiveMutex *recursiveMutex) QT_MUTEX_LOCK_NOEXCEPT;
     void unlockInternal() noexcept;
     void destroyInternal(QMutexPrivate *d);
 
@@ -141,6 +143,7 @@ private:
     }
 
     friend class QMutex;
+    friend class QRecursiveMutex;
     friend class QMutexPrivate;
 };
 
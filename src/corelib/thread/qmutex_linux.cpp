@@ -155,11 +155,28 @@ bool lockInternal_helper(QBasicAtomicPointer<QMutexPrivate> &d_ptr, int timeout
 
 void QBasicMutex::lockInternal() noexcept
 {
-    lockInternal_helper<false>(d_ptr);
+    lockInternal(-1, QT_LOCK_CALL_SITE(), nullptr);
 }
 
 bool QBasicMutex::lockInternal(int timeout) noexcept
 {
+    return lockInternal(timeout, QT_LOCK_CALL_SITE(), nullptr);
+}
+
+bool QBasicMutex::lockInternal(int timeout, const void *callSite,
+                               const QRecursiveMutex *recursiveMutex) noexcept
+{
+    QLockContentionTimer contention;
+    if (timeout != 0) {
+        if (recursiveMutex)
+            contention.start(QLockContentionProfiler::RecursiveMutex, recursiveMutex, callSite);
+        else
+            contention.start(QLockContentionProfiler::Mutex, this, callSite);
+    }
+
+    if (timeout < 0)
+        return lockInternal_helper<false>(d_ptr);
+
     QElapsedTimer elapsedTimer;
     elapsedTimer.start();
     return lockInternal_helper<true>(d_ptr, timeout, &elapsedTimer);
@@ -46,10 +46,14 @@
 #include "qthread.h"
 #include "qwaitcondition.h"
 #include "qreadwritelock_p.h"
+#include "qlockcontentionprofiler_p.h"
 #include "qelapsedtimer.h"
+#include "qdeadlinetimer.h"
 #include "private/qfreelist_p.h"
 #include "private/qlocking_p.h"
 
+#include <atomic>
+
 QT_BEGIN_NAMESPACE
 
 /*
@@ -62,6 +66,21 @@ QT_BEGIN_NAMESPACE
  *    are waiting, and the lock is not recursive.
  *  - when d_ptr == 0x2: We are locked for write and nobody is waiting. (no contention)
  *  - In any other case, d_ptr points to an actual QReadWriteLockPrivate.
+ *
+ * Recursive and ScalableReaders locks always have an actual QReadWriteLockPrivate
+ * which is allocated in the constructor, so d_ptr never changes for them.
+ *
+ * ScalableReaders locks implement the BRAVO reader bias on top of the mutex based
+ * implementation in QReadWriteLockPrivate: as long as the readerBias flag is set, a
+ * reader does not touch the lock itself but publishes itself in a slot of the
+ * process-wide visibleReaders table, chosen by hashing the lock and the thread.
+ * A writer clears readerBias, so that new readers take the mutex based path and queue
+ * up behind it, acquires the mutex based lock and then waits until no slot of the
+ * table refers to the lock anymore. Since this costs a scan of the table, the bias is
+ * only restored by a reader taking the slow path when no writer is waiting and a
+ * multiple of the last revocation time has passed.
+ * The slots a thread holds are recorded in a thread_local so that unlock() can tell
+ * the two kinds of read locks apart.
  */
 
 namespace {
@@ -74,6 +93,101 @@ const auto dummyLockedForRead = reinterpret_cast<QReadWriteLockPrivate *>(quintp
 const auto dummyLockedForWrite = reinterpret_cast<QReadWriteLockPrivate *>(quintptr(StateLockedForWrite));
 inline bool isUncontendedLocked(const QReadWriteLockPrivate *d)
 { return quintptr(d) & StateMask; }
+
+inline bool hasScalableReaders(const QReadWriteLockPrivate *d)
+{ return d && !isUncontendedLocked(d) && d->scalableReaders; }
+
+enum {
+    VisibleReaderSlotBits = 12,
+    VisibleReaderSlotCount = 1 << VisibleReaderSlotBits,
+    MaxVisibleReadsPerThread = 8,
+    // How many times the duration of a revocation the bias stays disabled
+    InhibitBiasMultiplier = 9
+};
+
+QAtomicPointer<QReadWriteLockPrivate> visibleReaders[VisibleReaderSlotCount];
+
+struct VisibleRead
+{
+    QReadWriteLockPrivate *d;
+    uint slot;
+    int count;
+};
+
+// Kept trivial so that it does not need any thread exit handling
+struct VisibleReads
+{
+    VisibleRead reads[MaxVisibleReadsPerThread];
+    int size;
+
+    VisibleRead *find(const QReadWriteLockPrivate *d)
+    {
+        for (int i = size - 1; i >= 0; --i) {
+            if (reads[i].d == d)
+                return &reads[i];
+        }
+        return nullptr;
+    }
+
+    void remove(VisibleRead *read)
+    {
+        *read = reads[--size];
+    }
+};
+
+thread_local VisibleReads currentVisibleReads;
+
+inline uint visibleReaderSlot(const QReadWriteLockPrivate *d)
+{
+    quint64 h = (quint64(quintptr(d)) << 16) ^ quint64(quintptr(&currentVisibleReads));
+    h *= Q_UINT64_C(0x9e3779b97f4a7c15);
+    return uint(h >> (64 - VisibleReaderSlotBits));
+}
+
+inline qint64 currentNSecs()
+{
+    return QDeadlineTimer::current().deadlineNSecs();
+}
+
+// The lock the current thread is acquiring and where from, for
+// QLockContentionProfiler. Only set while profiling is enabled.
+struct Acquisition
+{
+    const QReadWriteLock *lock;
+    const void *callSite;
+};
+
+thread_local Acquisition currentAcquisition;
+
+class AcquisitionScope
+{
+    Q_DISABLE_COPY_MOVE(AcquisitionScope)
+    bool active = false;
+
+public:
+    AcquisitionScope(const QReadWriteLock *lock, const void *callSite)
+    {
+        // the outermost public function knows the actual caller
+        if (Q_UNLIKELY(QLockContentionProfiler::isEnabled()) && currentAcquisition.lock != lock) {
+            currentAcquisition = { lock, callSite };
+            active = true;
+        }
+    }
+    ~AcquisitionScope()
+    {
+        if (active)
+            currentAcquisition = {};
+    }
+};
+
+inline void startContention(QLockContentionTimer &timer, QLockContentionProfiler::LockType type)
+{
+    if (Q_LIKELY(!QLockContentionProfiler::isEnabled()))
+        return;
+    const Acquisition &acquisition = currentAcquisition;
+    if (acquisition.lock)
+        timer.start(type, acquisition.lock, acquisition.callSite);
+}
 }
 
 /*! \class QReadWriteLock
@@ -118,6 +232,25 @@ inline bool isUncontendedLocked(const QReadWriteLockPrivate *d)
     \sa QReadLocker, QWriteLocker, QMutex, QSemaphore
 */
 
+/*!
+    \enum QReadWriteLock::ReaderMode
+    \since 6.1
+
+    \value DefaultReaders Readers register themselves in the lock, like
+    writers do. This is the cheapest mode as long as the lock is not used
+    by many threads at the same time.
+
+    \value ScalableReaders Readers normally do not modify the lock at all,
+    but announce themselves in a table shared by all locks in this mode,
+    so that threads reading on different CPUs do not contend on the same
+    cache line. In exchange, locking for writing is more expensive and
+    after a writer has been waiting, readers use the default path for a
+    while. Use this mode for locks that are read very frequently from many
+    threads and rarely written to.
+
+    \sa QReadWriteLock()
+*/
+
 /*!
     \enum QReadWriteLock::RecursionMode
     \since 4.4
@@ -147,6 +280,26 @@ QReadWriteLock::QReadWriteLock(RecursionMode recursionMode)
     Q_ASSERT_X(!(quintptr(d_ptr.loadRelaxed()) & StateMask), "QReadWriteLock::QReadWriteLock", "bad d_ptr alignment");
 }
 
+/*!
+    \since 6.1
+
+    Constructs a QReadWriteLock object in the given \a recursionMode,
+    using \a readerMode to acquire the lock for reading.
+
+    Writers keep priority over new readers in the ScalableReaders mode,
+    and recursive locking works as described for \a recursionMode.
+
+    \sa ReaderMode, RecursionMode
+*/
+QReadWriteLock::QReadWriteLock(RecursionMode recursionMode, ReaderMode readerMode)
+    : d_ptr(recursionMode == Recursive || readerMode == ScalableReaders
+            ? new QReadWriteLockPrivate(recursionMode == Recursive,
+                                        readerMode == ScalableReaders)
+            : nullptr)
+{
+    Q_ASSERT_X(!(quintptr(d_ptr.loadRelaxed()) & StateMask), "QReadWriteLock::QReadWriteLock", "bad d_ptr alignment");
+}
+
 /*!
     Destroys the QReadWriteLock object.
 
@@ -174,8 +327,11 @@ QReadWriteLock::~QReadWriteLock()
 */
 void QReadWriteLock::lockForRead()
 {
-    if (d_ptr.testAndSetAcquire(nullptr, dummyLockedForRead))
+    // Don't try to modify d_ptr if it is in use, so that ScalableReaders
+    // locks can be shared between CPUs
+    if (!d_ptr.loadRelaxed() && d_ptr.testAndSetAcquire(nullptr, dummyLockedForRead))
         return;
+    AcquisitionScope scope(this, QT_LOCK_CALL_SITE());
     tryLockForRead(-1);
 }
 
@@ -221,11 +377,18 @@ bool QReadWriteLock::tryLockForRead()
 */
 bool QReadWriteLock::tryLockForRead(int timeout)
 {
+    QReadWriteLockPrivate *d = d_ptr.loadRelaxed();
+    if (hasScalableReaders(d)) {
+        AcquisitionScope scope(this, QT_LOCK_CALL_SITE());
+        return d->scalableLockForRead(timeout);
+    }
+
     // Fast case: non contended:
-    QReadWriteLockPrivate *d;
     if (d_ptr.testAndSetAcquire(nullptr, dummyLockedForRead, d))
         return true;
 
+    AcquisitionScope scope(this, QT_LOCK_CALL_SITE());
+
     while (true) {
         if (d == nullptr) {
             if (!d_ptr.testAndSetAcquire(nullptr, dummyLockedForRead, d))
@@ -291,6 +454,9 @@ bool QReadWriteLock::tryLockForRead(int timeout)
 */
 void QReadWriteLock::lockForWrite()
 {
+    if (!d_ptr.loadRelaxed() && d_ptr.testAndSetAcquire(nullptr, dummyLockedForWrite))
+        return;
+    AcquisitionScope scope(this, QT_LOCK_CALL_SITE());
     tryLockForWrite(-1);
 }
 
@@ -335,11 +501,18 @@ bool QReadWriteLock::tryLockForWrite()
 */
 bool QReadWriteLock::tryLockForWrite(int timeout)
 {
+    QReadWriteLockPrivate *d = d_ptr.loadRelaxed();
+    if (hasScalableReaders(d)) {
+        AcquisitionScope scope(this, QT_LOCK_CALL_SITE());
+        return d->scalableLockForWrite(timeout);
+    }
+
     // Fast case: non contended:
-    QReadWriteLockPrivate *d;
     if (d_ptr.testAndSetAcquire(nullptr, dummyLockedForWrite, d))
         return true;
 
+    AcquisitionScope scope(this, QT_LOCK_CALL_SITE());
+
     while (true) {
         if (d == nullptr) {
             if (!d_ptr.testAndSetAcquire(d, dummyLockedForWrite, d))
@@ -414,6 +587,10 @@ void QReadWriteLock::unlock()
 
         Q_ASSERT(!isUncontendedLocked(d));
 
+        if (d->scalableReaders) {
+            d->scalableUnlock();
+            return;
+        }
         if (d->recursive) {
             d->recursiveUnlock();
             return;
@@ -469,6 +646,10 @@ bool QReadWriteLockPrivate::lockForRead(int timeout)
     if (timeout > 0)
         t.start();
 
+    QLockContentionTimer contention;
+    if ((waitingWriters || writerCount) && timeout != 0)
+        startContention(contention, QLockContentionProfiler::ReadLock);
+
     while (waitingWriters || writerCount) {
         if (timeout == 0)
             return false;
@@ -497,6 +678,10 @@ bool QReadWriteLockPrivate::lockForWrite(int timeout)
     if (timeout > 0)
         t.start();
 
+    QLockContentionTimer contention;
+    if ((readerCount || writerCount) && timeout != 0)
+        startContention(contention, QLockContentionProfiler::WriteLock);
+
     while (readerCount || writerCount) {
         if (timeout == 0)
             return false;
@@ -600,6 +785,142 @@ void QReadWriteLockPrivate::recursiveUnlock()
     unlock();
 }
 
+bool QReadWriteLockPrivate::plainLockForRead(int timeout)
+{
+    if (recursive) {
+        if (!recursiveLockForRead(timeout))
+            return false;
+    } else {
+        auto lock = qt_unique_lock(mutex);
+        if (!lockForRead(timeout))
+            return false;
+    }
+
+    // No writer can be active while we hold the lock for reading, but one may
+    // be queued, in which case the bias must stay off for it to get the lock.
+    if (scalableReaders && !readerBias.loadRelaxed()
+            && currentNSecs() >= inhibitBiasUntil.loadRelaxed()) {
+        const auto lock = qt_scoped_lock(mutex);
+        if (!waitingWriters && !readerBias.loadRelaxed()) {
+            biasNeedsRevocation = true;
+            // Release, paired with the acquire in scalableLockForRead(): a
+            // reader taking the fast path never touches the mutex, so the
+            // bias flag is what orders the last writer's critical section
+            // before it. We hold the lock for reading, after that writer.
+            readerBias.storeRelease(1);
+        }
+    }
+    return true;
+}
+
+bool QReadWriteLockPrivate::plainLockForWrite(int timeout)
+{
+    if (recursive)
+        return recursiveLockForWrite(timeout);
+    auto lock = qt_unique_lock(mutex);
+    return lockForWrite(timeout);
+}
+
+void QReadWriteLockPrivate::plainUnlock()
+{
+    if (recursive) {
+        recursiveUnlock();
+        return;
+    }
+
+    const auto lock = qt_scoped_lock(mutex);
+    if (writerCount) {
+        Q_ASSERT(writerCount == 1);
+        Q_ASSERT(readerCount == 0);
+        writerCount = 0;
+    } else {
+        Q_ASSERT(readerCount > 0);
+        if (--readerCount > 0)
+            return;
+    }
+    unlock();
+}
+
+bool QReadWriteLockPrivate::scalableLockForRead(int timeout)
+{
+    Q_ASSERT(scalableReaders);
+    VisibleReads &visibleReads = currentVisibleReads;
+
+    // Relocking a read lock obtained through the bias: a writer may already
+    // be waiting for us, so we must not queue up behind it.
+    if (VisibleRead *read = visibleReads.find(this)) {
+        ++read->count;
+        return true;
+    }
+
+    if (readerBias.loadRelaxed() && visibleReads.size < MaxVisibleReadsPerThread) {
+        const uint slot = visibleReaderSlot(this);
+        if (visibleReaders[slot].testAndSetAcquire(nullptr, this)) {
+            // Pairs with the fence in scalableLockForWrite(): either the writer
+            // sees our slot, or we see that the bias was revoked.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            // acquire pairs with the release that enabled the bias
+            if (readerBias.loadAcquire()) {
+                visibleReads.reads[visibleReads.size++] = { this, slot, 1 };
+                return true;
+            }
+            visibleReaders[slot].storeRelease(nullptr);
+        }
+    }
+
+    return plainLockForRead(timeout);
+}
+
+bool QReadWriteLockPrivate::scalableLockForWrite(int timeout)
+{
+    Q_ASSERT(scalableReaders);
+    QDeadlineTimer deadline(timeout < 0 ? QDeadlineTimer::Forever : QDeadlineTimer(timeout));
+
+    // Revoke the bias before queueing up, so that new readers queue up behind us
+    readerBias.storeRelaxed(0);
+    if (!plainLockForWrite(timeout))
+        return false;
+    if (!biasNeedsRevocation)
+        return true;
+
+    // Wait for the readers that got in through the bias
+    readerBias.storeRelaxed(0);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    const qint64 start = currentNSecs();
+    QLockContentionTimer contention;
+    for (auto &slot : visibleReaders) {
+        if (slot.loadAcquire() == this)
+            startContention(contention, QLockContentionProfiler::WriteLock);
+        while (slot.loadAcquire() == this) {
+            if (deadline.hasExpired()) {
+                readerBias.storeRelaxed(1);
+                plainUnlock();
+                return false;
+            }
+            QThread::yieldCurrentThread();
+        }
+    }
+    const qint64 end = currentNSecs();
+    biasNeedsRevocation = false;
+    inhibitBiasUntil.storeRelaxed(end + (end - start) * InhibitBiasMultiplier);
+    return true;
+}
+
+void QReadWriteLockPrivate::scalableUnlock()
+{
+    Q_ASSERT(scalableReaders);
+    VisibleReads &visibleReads = currentVisibleReads;
+    if (VisibleRead *read = visibleReads.find(this)) {
+        if (--read->count == 0) {
+            visibleReaders[read->slot].storeRelease(nullptr);
+            visibleReads.remove(read);
+        }
+        return;
+    }
+    plainUnlock();
+}
+
 // The freelist management
 namespace {
 struct FreeListConstants : QFreeListDefaultConstants {
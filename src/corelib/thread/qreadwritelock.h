@@ -53,8 +53,10 @@ class Q_CORE_EXPORT QReadWriteLock
 {
 public:
     enum RecursionMode { NonRecursive, Recursive };
+    enum ReaderMode { DefaultReaders, ScalableReaders };
 
     explicit QReadWriteLock(RecursionMode recursionMode = NonRecursive);
+    QReadWriteLock(RecursionMode recursionMode, ReaderMode readerMode);
     ~QReadWriteLock();
 
     void lockForRead();
@@ -180,7 +182,9 @@ class Q_CORE_EXPORT QReadWriteLock
 {
 public:
     enum RecursionMode { NonRecursive, Recursive };
+    enum ReaderMode { DefaultReaders, ScalableReaders };
     inline explicit QReadWriteLock(RecursionMode = NonRecursive) noexcept { }
+    inline QReadWriteLock(RecursionMode, ReaderMode) noexcept { }
     inline ~QReadWriteLock() { }
 
     void lockForRead() noexcept { }
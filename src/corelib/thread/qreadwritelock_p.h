@@ -63,8 +63,9 @@ QT_BEGIN_NAMESPACE
 class QReadWriteLockPrivate
 {
 public:
-    explicit QReadWriteLockPrivate(bool isRecursive = false)
-        : recursive(isRecursive) {}
+    explicit QReadWriteLockPrivate(bool isRecursive = false, bool isScalable = false)
+        : recursive(isRecursive), scalableReaders(isScalable), readerBias(isScalable),
+          biasNeedsRevocation(isScalable) {}
 
     QMutex mutex;
     QWaitCondition writerCond;
@@ -93,6 +94,20 @@ public:
     bool recursiveLockForWrite(int timeout);
     bool recursiveLockForRead(int timeout);
     void recursiveUnlock();
+
+    // Scalable reader handling (reader bias)
+    const bool scalableReaders;
+    QAtomicInt readerBias;
+    bool biasNeedsRevocation; // protected by the lock itself
+    QAtomicInteger<qint64> inhibitBiasUntil = 0;
+
+    // called with the mutex unlocked
+    bool scalableLockForRead(int timeout);
+    bool scalableLockForWrite(int timeout);
+    void scalableUnlock();
+    bool plainLockForRead(int timeout);
+    bool plainLockForWrite(int timeout);
+    void plainUnlock();
 };
 
 QT_END_NAMESPACE
@@ -150,7 +150,7 @@ bool ResultIteratorBase::isValid() const
 }
 
 ResultStoreBase::ResultStoreBase()
-    : insertIndex(0), resultCount(0), m_filterMode(false), filteredResults(0) { }
+    : insertIndex(0), resultCount(0), m_filterMode(false), filteredResults(0), chunkIndex(-1) { }
 
 ResultStoreBase::~ResultStoreBase()
 {
@@ -247,6 +247,55 @@ int ResultStoreBase::addResults(int index, const void *results, int vectorSize,
     }
 }
 
+/*!
+  \internal
+
+  Returns the chunk a result added at \a index can be appended to, or
+  \nullptr if it has to be stored separately. The caller has to check
+  whether the chunk has room for another result.
+ */
+void *ResultStoreBase::chunkToAppendTo(int index) const
+{
+    if (m_filterMode || chunkIndex == -1 || (index != -1 && index != insertIndex))
+        return nullptr;
+
+    // chunkIndex doesn't count the canceled results before the chunk, insertIndex does
+    const auto it = m_results.constFind(chunkIndex);
+    if (it == m_results.constEnd()
+            || chunkIndex + it.value().count() + filteredResults != insertIndex) {
+        return nullptr;
+    }
+    return const_cast<void *>(it.value().result);
+}
+
+/*!
+  \internal
+
+  Accounts for a result that was appended to the chunk returned by
+  chunkToAppendTo(). Returns the index of the result.
+ */
+int ResultStoreBase::appendedToChunk()
+{
+    ResultItem &chunk = m_results[chunkIndex];
+    if (resultCount == chunkIndex + chunk.count())
+        ++resultCount;
+    ++chunk.m_count;
+    return updateInsertIndex(-1, 1);
+}
+
+/*!
+  \internal
+
+  Adds \a chunk, holding a single result, at \a index. Later results
+  are appended to it while it has room for them.
+ */
+int ResultStoreBase::addChunk(int index, void *chunk)
+{
+    const int storeIndex = addResults(index, chunk, 1, 1);
+    chunkIndex = storeIndex - filteredResults;
+    return storeIndex;
+}
+
 ResultIteratorBase ResultStoreBase::begin() const
 {
     return ResultIteratorBase(m_results.begin());
@@ -55,6 +55,10 @@ QT_BEGIN_NAMESPACE
     which indexes are in the store can be done either by iterating or by random
     accees. In addition results kan be removed from the front of the store,
     either individually or in batches.
+
+    Results added one by one at the end of the store are appended to chunks,
+    QLists that never grow beyond the capacity they were created with, so that
+    references to stored results stay valid.
 */
 
 namespace QtPrivate {
@@ -145,6 +149,9 @@ protected:
     void syncPendingResults();
     void syncResultCount();
     int updateInsertIndex(int index, int _count);
+    void *chunkToAppendTo(int index) const;
+    int appendedToChunk();
+    int addChunk(int index, void *chunk);
 
     QMap<int, ResultItem> m_results;
     int insertIndex;     // The index where the next results(s) will be inserted.
@@ -153,6 +160,9 @@ protected:
     bool m_filterMode;
     QMap<int, ResultItem> pendingResults;
     int filteredResults;
+    int chunkIndex;      // The index of the chunk results are appended to, or -1.
+
+    enum { MaxChunkCapacity = 256 };
 
     template <typename T>
     static void clear(QMap<int, ResultItem> &store)
@@ -178,7 +188,7 @@ public:
         if (result == nullptr)
             return addResult(index, static_cast<void *>(nullptr));
 
-        return addResult(index, static_cast<void *>(new T(*result)));
+        return appendResult<T>(index, *result);
     }
 
     template <typename T>
@@ -187,9 +197,35 @@ public:
         if (containsValidResultItem(index)) // reject if already present
             return -1;
 
-        return addResult(index, static_cast<void *>(new T(std::move_if_noexcept(result))));
+        return appendResult<T>(index, std::move_if_noexcept(result));
     }
 
+private:
+    template <typename T, typename U>
+    int appendResult(int index, U &&result)
+    {
+        // QList needs types that can be both copied and moved
+        if constexpr (std::is_copy_constructible_v<T> && std::is_move_constructible_v<T>) {
+            if (auto chunk = static_cast<QList<T> *>(chunkToAppendTo(index))) {
+                if (chunk->size() < chunk->capacity()) {
+                    chunk->append(std::forward<U>(result));
+                    return appendedToChunk();
+                }
+            }
+            if (!m_filterMode && (index == -1 || index == insertIndex)) {
+                // Each chunk can hold as many results as were added before it,
+                // so that futures with a single result don't waste memory.
+                auto chunk = new QList<T>;
+                chunk->reserve(qBound(1, insertIndex, int(MaxChunkCapacity)));
+                chunk->append(std::forward<U>(result));
+                return addChunk(index, chunk);
+            }
+        }
+        return addResult(index, static_cast<void *>(new T(std::forward<U>(result))));
+    }
+
+public:
+
     template<typename T>
     int addResults(int index, const QList<T> *results)
     {
@@ -229,6 +265,28 @@ public:
         return addResults(index, &empty, _count);
     }
 
+    template <typename T>
+    QList<T> takeReadyResults()
+    {
+        QList<T> results;
+        auto it = m_results.begin();
+        while (it != m_results.end() && it.key() < resultCount) {
+            if (it.value().isVector()) {
+                auto vector = static_cast<QList<T> *>(const_cast<void *>(it.value().result));
+                results.append(std::move(*vector));
+                delete vector;
+            } else {
+                auto result = static_cast<T *>(const_cast<void *>(it.value().result));
+                results.append(std::move_if_noexcept(*result));
+                delete result;
+            }
+            if (it.key() == chunkIndex)
+                chunkIndex = -1;
+            it = m_results.erase(it);
+        }
+        return results;
+    }
+
     template <typename T>
     void clear()
     {
@@ -237,6 +295,7 @@ public:
         insertIndex = 0;
         ResultStoreBase::clear<T>(pendingResults);
         filteredResults = 0;
+        chunkIndex = -1;
     }
 };
 
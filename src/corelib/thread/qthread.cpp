@@ -48,6 +48,7 @@
 
 #include "qthread_p.h"
 #include "private/qcoreapplication_p.h"
+#include "private/qeventloopstatistics_p.h"
 
 #include <limits>
 
@@ -93,6 +94,7 @@ QThreadData::~QThreadData()
     thread.storeRelease(nullptr);
     delete t;
 
+    QCoreApplicationPrivate::drainPostEventInbox(this);
     for (int i = 0; i < postEventList.size(); ++i) {
         const QPostEvent &pe = postEventList.at(i);
         if (pe.event) {
@@ -102,6 +104,8 @@ QThreadData::~QThreadData()
         }
     }
 
+    delete loopStatistics.loadRelaxed();
+
     // fprintf(stderr, "QThreadData %p destroyed\n", this);
 }
 
@@ -319,6 +323,33 @@ QThreadPrivate::~QThreadPrivate()
     if the number of processor cores could not be detected.
 */
 
+/*!
+    \fn int QThread::numaNodeCount()
+    \since 6.1
+
+    Returns the number of NUMA nodes in the system, that is, the number of
+    groups of processors that share local memory. This function returns 1
+    if the system is not a NUMA system or the nodes could not be detected.
+
+    \sa numaNodeCpus()
+*/
+
+/*!
+    \fn QList<int> QThread::numaNodeCpus(int node)
+    \since 6.1
+
+    Returns the operating system's numbers of the processors belonging to
+    NUMA node \a node, as passed to setCpuAffinity(). If the nodes could not
+    be detected, node 0 contains all processors. An empty list is returned
+    if \a node does not exist.
+
+    Threads restricted to the processors of a single node usually get their
+    memory allocated on that node, as operating systems place memory close
+    to the processor that first uses it.
+
+    \sa numaNodeCount(), setCpuAffinity(), QThreadPool::setNumaNode()
+*/
+
 /*!
     \fn void QThread::yieldCurrentThread()
 
@@ -516,6 +547,48 @@ uint QThread::stackSize() const
     return d->stackSize;
 }
 
+/*!
+    \since 6.1
+
+    Restricts the thread to run on the processors in \a cpus, identified by
+    the numbers the operating system gives them. These are not necessarily
+    contiguous, for instance when processors are offline, and can be larger
+    than idealThreadCount(). If the thread is running, this takes effect
+    immediately; otherwise when the thread is started. An empty list, the
+    default, lets the thread run on any processor.
+
+    This is useful to keep a latency-critical thread from migrating between
+    processors, or to keep threads close to the memory they work on.
+
+    \note This function is only implemented on Linux and Windows. On Windows,
+    only the first 64 processors can be used.
+
+    \sa cpuAffinity(), numaNodeCpus(), QThreadPool::setCpuAffinity()
+*/
+void QThread::setCpuAffinity(const QList<int> &cpus)
+{
+    Q_D(QThread);
+    QMutexLocker locker(&d->mutex);
+    d->cpuAffinity = cpus;
+    if (d->running && !d->isInFinish)
+        d->applyCpuAffinity();
+}
+
+/*!
+    \since 6.1
+
+    Returns the processors the thread was restricted to with setCpuAffinity(),
+    or an empty list if it can run on any processor.
+
+    \sa setCpuAffinity()
+*/
+QList<int> QThread::cpuAffinity() const
+{
+    Q_D(const QThread);
+    QMutexLocker locker(&d->mutex);
+    return d->cpuAffinity;
+}
+
 /*!
     Enters the event loop and waits until exit() is called, returning the value
     that was passed to exit(). The value returned is 0 if exit() is called via
@@ -947,6 +1020,26 @@ uint QThread::stackSize() const
     return 0;
 }
 
+void QThread::setCpuAffinity(const QList<int> &cpus)
+{
+    Q_UNUSED(cpus);
+}
+
+QList<int> QThread::cpuAffinity() const
+{
+    return QList<int>();
+}
+
+int QThread::numaNodeCount()
+{
+    return 1;
+}
+
+QList<int> QThread::numaNodeCpus(int node)
+{
+    return node == 0 ? QList<int>{ 0 } : QList<int>();
+}
+
 #endif // QT_CONFIG(thread)
 
 /*!
@@ -64,6 +64,8 @@ public:
     static Qt::HANDLE currentThreadId() noexcept Q_DECL_PURE_FUNCTION;
     static QThread *currentThread();
     static int idealThreadCount() noexcept;
+    static int numaNodeCount();
+    static QList<int> numaNodeCpus(int node);
     static void yieldCurrentThread();
 
     explicit QThread(QObject *parent = nullptr);
@@ -95,6 +97,9 @@ public:
     void setStackSize(uint stackSize);
     uint stackSize() const;
 
+    void setCpuAffinity(const QList<int> &cpus);
+    QList<int> cpuAffinity() const;
+
     void exit(int retcode = 0);
 
     QAbstractEventDispatcher *eventDispatcher() const;
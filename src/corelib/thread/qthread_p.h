@@ -92,6 +92,56 @@ inline bool operator<(const QPostEvent &first, const QPostEvent &second)
     return first.priority > second.priority;
 }
 
+// Lock-free multi-producer, single-consumer stack of posted events.
+// postEvent() pushes queued invocations here without taking
+// QPostEventList::mutex; whoever holds the mutex moves them into the
+// sorted list (see QCoreApplicationPrivate::drainPostEventInbox()).
+class QPostEventInbox
+{
+public:
+    struct Node
+    {
+        QPostEvent event;
+        Node *next;
+    };
+
+    bool isEmpty() const
+    { return head.loadAcquire() == nullptr; }
+
+    // may be off while events are being pushed or taken
+    int size() const
+    { return count.loadRelaxed(); }
+
+    void push(Node *node)
+    {
+        count.ref();
+        Node *expected = head.loadRelaxed();
+        do {
+            node->next = expected;
+        } while (!head.testAndSetRelease(expected, node, expected));
+    }
+
+    // returns the pushed nodes, most recently pushed first
+    Node *takeAll()
+    {
+        Node *nodes = head.fetchAndStoreAcquire(nullptr);
+        int taken = 0;
+        for (Node *node = nodes; node; node = node->next)
+            ++taken;
+        count.fetchAndSubRelaxed(taken);
+        return nodes;
+    }
+
+    // Number of threads between checking the receiver's thread and pushing
+    // an event for it. QObject::moveToThread() waits for them after moving
+    // the object, so that it can forward what they pushed.
+    QAtomicInt pushers = 0;
+
+private:
+    QAtomicPointer<Node> head = nullptr;
+    QAtomicInt count = 0;
+};
+
 // This class holds the list of posted events.
 //  The list has to be kept sorted by priority
 class QPostEventList : public QList<QPostEvent>
@@ -107,6 +157,9 @@ public:
 
     QMutex mutex;
 
+    // events posted without holding the mutex, not yet in the list
+    QPostEventInbox inbox;
+
     inline QPostEventList() : QList<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0) { }
 
     void addEvent(const QPostEvent &ev)
@@ -151,6 +204,7 @@ public:
     ~QThreadPrivate();
 
     void setPriority(QThread::Priority prio);
+    void applyCpuAffinity();
 
     mutable QMutex mutex;
     QAtomicInt quitLockRef;
@@ -165,6 +219,7 @@ public:
 
     uint stackSize;
     QThread::Priority priority;
+    QList<int> cpuAffinity;
 
     static QThread *threadForId(int id);
 
@@ -229,6 +284,8 @@ public:
 
 #endif // QT_CONFIG(thread)
 
+class QEventLoopStatisticsData;
+
 class QThreadData
 {
 public:
@@ -257,7 +314,7 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
-        return canWait;
+        return canWait && postEventList.inbox.isEmpty();
     }
 
     // This class provides per-thread (by way of being a QThreadData
@@ -292,6 +349,7 @@ public:
     QAtomicPointer<QThread> thread;
     QAtomicPointer<void> threadId;
     QAtomicPointer<QAbstractEventDispatcher> eventDispatcher;
+    QAtomicPointer<QEventLoopStatisticsData> loopStatistics;
     QList<void *> tls;
     FlaggedDebugSignatures flaggedSignatures;
 
@@ -67,6 +67,7 @@
 
 #include <sched.h>
 #include <errno.h>
+#include <numeric>
 
 #ifdef Q_OS_BSD4
 #include <sys/sysctl.h>
@@ -253,6 +254,9 @@ QAbstractEventDispatcher *QThreadPrivate::createEventDispatcher(QThreadData *dat
 #elif !defined(QT_NO_GLIB)
     const bool isQtMainThread = data->thread.loadAcquire() == QCoreApplicationPrivate::mainThread();
     if (qEnvironmentVariableIsEmpty("QT_NO_GLIB")
+#  if QT_CONFIG(epoll)
+        && qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_EPOLL") <= 0
+#  endif
         && (isQtMainThread || qEnvironmentVariableIsEmpty("QT_NO_THREADED_GLIB"))
         && QEventDispatcherGlib::versionSupported())
         return new QEventDispatcherGlib;
@@ -303,6 +307,9 @@ void *QThreadPrivate::start(void *arg)
             data->threadId.storeRelaxed(to_HANDLE(pthread_self()));
             set_thread_data(data);
 
+            if (!thr->d_func()->cpuAffinity.isEmpty())
+                thr->d_func()->applyCpuAffinity();
+
             data->ref();
             data->quitNow = thr->d_func()->exited;
         }
@@ -494,6 +501,63 @@ int QThread::idealThreadCount() noexcept
     return cores;
 }
 
+#if defined(Q_OS_LINUX)
+static QByteArray readNumaNodeFile(const QByteArray &path)
+{
+    const QByteArray fileName = "/sys/devices/system/node/" + path;
+    int fd = qt_safe_open(fileName.constData(), O_RDONLY);
+    if (fd == -1)
+        return QByteArray();
+    char buffer[4096];
+    const qint64 size = qt_safe_read(fd, buffer, sizeof(buffer));
+    qt_safe_close(fd);
+    return size > 0 ? QByteArray(buffer, size).trimmed() : QByteArray();
+}
+
+// parses lists of the form "0-3,8,10-11"
+static QList<int> parseNumaNodeList(const QByteArray &list)
+{
+    QList<int> numbers;
+    for (const QByteArray &range : list.split(',')) {
+        const qsizetype dash = range.indexOf('-');
+        bool firstOk, lastOk = true;
+        const int first = (dash == -1 ? range : range.left(dash)).toInt(&firstOk);
+        const int last = dash == -1 ? first : range.mid(dash + 1).toInt(&lastOk);
+        if (!firstOk || !lastOk)
+            continue;
+        for (int i = first; i <= last; ++i)
+            numbers.append(i);
+    }
+    return numbers;
+}
+#endif
+
+int QThread::numaNodeCount()
+{
+#if defined(Q_OS_LINUX)
+    const QList<int> nodes = parseNumaNodeList(readNumaNodeFile("online"));
+    if (!nodes.isEmpty())
+        return nodes.last() + 1;
+#endif
+    return 1;
+}
+
+QList<int> QThread::numaNodeCpus(int node)
+{
+#if defined(Q_OS_LINUX)
+    if (node < 0)
+        return QList<int>();
+    const QByteArray cpuList = readNumaNodeFile("node" + QByteArray::number(node) + "/cpulist");
+    if (!cpuList.isEmpty() || node > 0)
+        return parseNumaNodeList(cpuList);
+#endif
+    if (node != 0)
+        return QList<int>();
+    QList<int> cpus(idealThreadCount());
+    std::iota(cpus.begin(), cpus.end(), 0);
+    return cpus;
+}
+
 void QThread::yieldCurrentThread()
 {
     sched_yield();
@@ -786,6 +850,27 @@ void QThread::setTerminationEnabled(bool enabled)
 #endif
 }
 
+// Caller must lock the mutex
+void QThreadPrivate::applyCpuAffinity()
+{
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (cpuAffinity.isEmpty()) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            CPU_SET(cpu, &cpuSet);
+    }
+    for (int cpu : qAsConst(cpuAffinity)) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE)
+            CPU_SET(cpu, &cpuSet);
+    }
+    if (pthread_setaffinity_np(from_HANDLE<pthread_t>(data->threadId.loadRelaxed()),
+                               sizeof(cpuSet), &cpuSet) != 0) {
+        qWarning("QThread::setCpuAffinity: Cannot set CPU affinity");
+    }
+#endif
+}
+
 // Caller must lock the mutex
 void QThreadPrivate::setPriority(QThread::Priority threadPriority)
 {
@@ -383,6 +383,32 @@ int QThread::idealThreadCount() noexcept
     return sysinfo.dwNumberOfProcessors;
 }
 
+int QThread::numaNodeCount()
+{
+    ULONG highestNode;
+    if (!GetNumaHighestNodeNumber(&highestNode))
+        return 1;
+    return int(highestNode) + 1;
+}
+
+QList<int> QThread::numaNodeCpus(int node)
+{
+    QList<int> cpus;
+    ULONGLONG mask;
+    if (node < 0 || node > UCHAR_MAX || !GetNumaNodeProcessorMask(UCHAR(node), &mask)) {
+        if (node == 0) {
+            for (int cpu = 0; cpu < idealThreadCount(); ++cpu)
+                cpus.append(cpu);
+        }
+        return cpus;
+    }
+    for (int cpu = 0; cpu < 64; ++cpu) {
+        if (mask & (ULONGLONG(1) << cpu))
+            cpus.append(cpu);
+    }
+    return cpus;
+}
+
 void QThread::yieldCurrentThread()
 {
     SwitchToThread();
@@ -496,6 +522,9 @@ void QThread::start(Priority priority)
         qErrnoWarning("QThread::start: Failed to set thread priority");
     }
 
+    if (!d->cpuAffinity.isEmpty())
+        d->applyCpuAffinity();
+
     if (ResumeThread(d->handle) == (DWORD) -1) {
         qErrnoWarning("QThread::start: Failed to resume new thread");
     }
@@ -578,6 +607,22 @@ void QThread::setTerminationEnabled(bool enabled)
 }
 
 // Caller must hold the mutex
+void QThreadPrivate::applyCpuAffinity()
+{
+    DWORD_PTR mask = 0;
+    if (cpuAffinity.isEmpty()) {
+        DWORD_PTR systemMask;
+        if (!GetProcessAffinityMask(GetCurrentProcess(), &mask, &systemMask))
+            return;
+    }
+    for (int cpu : qAsConst(cpuAffinity)) {
+        if (cpu >= 0 && cpu < int(sizeof(DWORD_PTR) * 8))
+            mask |= DWORD_PTR(1) << cpu;
+    }
+    if (!SetThreadAffinityMask(handle, mask))
+        qErrnoWarning("QThread::setCpuAffinity: Cannot set CPU affinity");
+}
+
 void QThreadPrivate::setPriority(QThread::Priority threadPriority)
 {
     // copied from start() with a few modifications:
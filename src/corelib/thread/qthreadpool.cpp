@@ -60,6 +60,7 @@ public:
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+    QThreadPoolLocalQueue localQueue;
 };
 
 /*
@@ -88,58 +89,67 @@ void QThreadPoolThread::run()
 
         do {
             if (r) {
-                // If autoDelete() is false, r might already be deleted after run(), so check status now.
-                const bool del = r->autoDelete();
-
                 // run the task
                 locker.unlock();
+                do {
+                    // If autoDelete() is false, r might already be deleted after run(), so check status now.
+                    const bool del = r->autoDelete();
+
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        r->run();
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
 
-                if (del)
-                    delete r;
+                    if (del)
+                        delete r;
+
+                    // Tasks started from this thread only have the default priority, so they
+                    // can skip the shared queue unless it holds more important ones.
+                    r = manager->queuedPriority.loadRelaxed() > 0 ? nullptr : localQueue.pop();
+                } while (r);
                 locker.relock();
             }
 
-            // if too many threads are active, expire this thread
-            if (manager->tooManyThreadsActive())
+            // if too many threads are active, expire this thread,
+            // but not before running the tasks it started itself
+            if (manager->tooManyThreadsActive() && localQueue.isEmpty())
                 break;
 
-            if (manager->queue.isEmpty()) {
-                r = nullptr;
-                break;
-            }
-
-            QueuePage *page = manager->queue.first();
-            r = page->pop();
-
-            if (page->isFinished()) {
-                manager->queue.removeFirst();
-                delete page;
-            }
-        } while (true);
+            r = manager->takeNextTask(this);
+        } while (r);
 
         // if too many threads are active, expire this thread
         bool expired = manager->tooManyThreadsActive();
         if (!expired) {
             manager->waitingThreads.enqueue(this);
             registerThreadInactive();
+            manager->updateSpareThreads();
+            // A worker that started a task after we looked at its queue above
+            // only hands it over if it sees this thread as idle, so look again.
+            if (manager->workStealing.loadRelaxed()) {
+                if (QRunnable *stolen = manager->stealTask(this)) {
+                    manager->waitingThreads.removeOne(this);
+                    ++manager->activeThreads;
+                    manager->updateSpareThreads();
+                    runnable = stolen;
+                    continue;
+                }
+            }
             // wait for work, exiting after the expiry timeout is reached
             runnableReady.wait(locker.mutex(), QDeadlineTimer(manager->expiryTimeout));
             ++manager->activeThreads;
             if (manager->waitingThreads.removeOne(this))
                 expired = true;
+            manager->updateSpareThreads();
             if (!manager->allThreads.contains(this)) {
                 registerThreadInactive();
                 break;
@@ -148,6 +158,7 @@ void QThreadPoolThread::run()
         if (expired) {
             manager->expiredThreads.enqueue(this);
             registerThreadInactive();
+            manager->updateSpareThreads();
             break;
         }
     }
@@ -183,6 +194,7 @@ bool QThreadPoolPrivate::tryStart(QRunnable *task)
         // recycle an available thread
         enqueueTask(task);
         waitingThreads.takeFirst()->runnableReady.wakeOne();
+        updateSpareThreads();
         return true;
     }
 
@@ -192,8 +204,10 @@ bool QThreadPoolPrivate::tryStart(QRunnable *task)
         Q_ASSERT(thread->runnable == nullptr);
 
         ++activeThreads;
+        updateSpareThreads();
 
         thread->runnable = task;
+        thread->setObjectName(pooledThreadName());
         thread->start();
         return true;
     }
@@ -219,6 +233,101 @@ void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
     }
     auto it = std::upper_bound(queue.constBegin(), queue.constEnd(), priority, comparePriority);
     queue.insert(std::distance(queue.constBegin(), it), new QueuePage(runnable, priority));
+    updateQueuedPriority();
+}
+
+/*!
+    \internal
+
+    Takes the next task from the queue, which must not be empty.
+*/
+QRunnable *QThreadPoolPrivate::takeQueuedTask()
+{
+    QueuePage *page = queue.first();
+    QRunnable *r = page->pop();
+
+    if (page->isFinished()) {
+        queue.removeFirst();
+        delete page;
+        updateQueuedPriority();
+    }
+    return r;
+}
+
+/*!
+    \internal
+
+    Returns the next task for \a thread to run, or \nullptr if there is none.
+    Queued tasks with a higher than default priority come first, then the
+    tasks \a thread started itself, then the remaining queued tasks with the
+    default priority, then the tasks started by other threads and finally
+    the queued tasks with a lower priority.
+*/
+QRunnable *QThreadPoolPrivate::takeNextTask(QThreadPoolThread *thread)
+{
+    if (!queue.isEmpty() && queue.first()->priority() > 0)
+        return takeQueuedTask();
+    if (QRunnable *r = thread->localQueue.pop())
+        return r;
+    if (!queue.isEmpty() && queue.first()->priority() == 0)
+        return takeQueuedTask();
+    if (workStealing.loadRelaxed()) {
+        if (QRunnable *r = stealTask(thread))
+            return r;
+    }
+    if (!queue.isEmpty())
+        return takeQueuedTask();
+    return nullptr;
+}
+
+/*!
+    \internal
+
+    Takes the oldest task another thread than \a thief started while work
+    stealing was enabled.
+*/
+QRunnable *QThreadPoolPrivate::stealTask(QThreadPoolThread *thief)
+{
+    for (QThreadPoolThread *thread : qAsConst(allThreads)) {
+        if (thread == thief)
+            continue;
+        if (QRunnable *r = thread->localQueue.steal())
+            return r;
+    }
+    return nullptr;
+}
+
+/*!
+    \internal
+
+    Starts \a runnable from the pool's own \a thread. The task is queued
+    without taking the pool's mutex; it is only handed over to another
+    thread if there is one idle or one can be started.
+*/
+void QThreadPoolPrivate::startLocalTask(QThreadPoolThread *thread, QRunnable *runnable)
+{
+    thread->localQueue.push(runnable);
+    if (spareThreads.loadRelaxed() <= 0)
+        return;
+
+    QMutexLocker locker(&mutex);
+    while (activeThreadCount() < maxThreadCount) {
+        QRunnable *r = thread->localQueue.steal();
+        if (!r)
+            break;
+        tryStart(r);
+    }
+}
+
+void QThreadPoolPrivate::updateSpareThreads()
+{
+    spareThreads.storeRelaxed(maxThreadCount - activeThreadCount());
+}
+
+void QThreadPoolPrivate::updateQueuedPriority()
+{
+    queuedPriority.storeRelaxed(queue.isEmpty() ? std::numeric_limits<int>::min()
+                                                : queue.first()->priority());
 }
 
 int QThreadPoolPrivate::activeThreadCount() const
@@ -242,6 +351,7 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
         if (page->isFinished()) {
             queue.removeFirst();
             delete page;
+            updateQueuedPriority();
         }
     }
 }
@@ -252,6 +362,18 @@ bool QThreadPoolPrivate::tooManyThreadsActive() const
     return activeThreadCount > maxThreadCount && (activeThreadCount - reservedThreads) > 1;
 }
 
+/*!
+    \internal
+
+    Returns the name for a thread that is about to be (re)started. Threads
+    only get named before they start, as QThread passes the objectName() on
+    to the operating system from the new thread.
+*/
+QString QThreadPoolPrivate::pooledThreadName() const
+{
+    return threadName.isEmpty() ? QStringLiteral("Thread (pooled)") : threadName;
+}
+
 /*!
     \internal
 */
@@ -259,10 +381,13 @@ void QThreadPoolPrivate::startThread(QRunnable *runnable)
 {
     Q_ASSERT(runnable != nullptr);
     QScopedPointer<QThreadPoolThread> thread(new QThreadPoolThread(this));
-    thread->setObjectName(QLatin1String("Thread (pooled)"));
+    thread->setObjectName(pooledThreadName());
+    if (!cpuAffinity.isEmpty())
+        thread->setCpuAffinity(cpuAffinity);
     Q_ASSERT(!allThreads.contains(thread.data())); // if this assert hits, we have an ABA problem (deleted threads don't get removed here)
     allThreads.insert(thread.data());
     ++activeThreads;
+    updateSpareThreads();
 
     thread->runnable = runnable;
     thread.take()->start();
@@ -280,6 +405,7 @@ void QThreadPoolPrivate::reset()
     allThreadsCopy.swap(allThreads);
     expiredThreads.clear();
     waitingThreads.clear();
+    updateSpareThreads();
     mutex.unlock();
 
     for (QThreadPoolThread *thread : qAsConst(allThreadsCopy)) {
@@ -324,6 +450,16 @@ bool QThreadPoolPrivate::waitForDone(int msecs)
 void QThreadPoolPrivate::clear()
 {
     QMutexLocker locker(&mutex);
+    QList<QRunnable *> localTasks;
+    for (QThreadPoolThread *thread : qAsConst(allThreads))
+        localTasks += thread->localQueue.takeAll();
+    for (QRunnable *r : qAsConst(localTasks)) {
+        if (r->autoDelete()) {
+            locker.unlock();
+            delete r;
+            locker.relock();
+        }
+    }
     while (!queue.isEmpty()) {
         auto *page = queue.takeLast();
         while (!page->isFinished()) {
@@ -336,6 +472,7 @@ void QThreadPoolPrivate::clear()
         }
         delete page;
     }
+    updateQueuedPriority();
 }
 
 /*!
@@ -368,10 +505,15 @@ bool QThreadPool::tryTake(QRunnable *runnable)
             if (page->isFinished()) {
                 d->queue.removeOne(page);
                 delete page;
+                d->updateQueuedPriority();
             }
             return true;
         }
     }
+    for (QThreadPoolThread *thread : qAsConst(d->allThreads)) {
+        if (thread->localQueue.tryTake(runnable))
+            return true;
+    }
 
     return false;
 }
@@ -500,6 +642,14 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (priority == 0 && d->workStealing.loadRelaxed()) {
+        auto thread = qobject_cast<QThreadPoolThread *>(QThread::currentThread());
+        if (thread && thread->manager == d) {
+            d->startLocalTask(thread, runnable);
+            return;
+        }
+    }
+
     QMutexLocker locker(&d->mutex);
 
     if (!d->tryStart(runnable)) {
@@ -635,6 +785,7 @@ void QThreadPool::setMaxThreadCount(int maxThreadCount)
         return;
 
     d->maxThreadCount = maxThreadCount;
+    d->updateSpareThreads();
     d->tryToStartMoreThreads();
 }
 
@@ -672,6 +823,7 @@ void QThreadPool::reserveThread()
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
     ++d->reservedThreads;
+    d->updateSpareThreads();
 }
 
 /*! \property QThreadPool::stackSize
@@ -698,6 +850,147 @@ uint QThreadPool::stackSize() const
     return d->stackSize;
 }
 
+/*! \property QThreadPool::workStealingEnabled
+    \brief whether runnables started from the pool's own threads are kept local
+    \since 6.1
+
+    When enabled, a runnable started with the default priority from one of
+    the pool's threads is not put on the shared run queue. It is pushed on a
+    queue of the starting thread instead, which runs the most recently started
+    of these runnables first once its current runnable returns, without
+    synchronizing with the other threads. Threads that have nothing else to
+    do take the oldest runnables from the other threads' queues, and the
+    starting thread hands its runnables over right away if there are idle
+    threads or more threads can be started.
+
+    This greatly reduces contention when runnables spawn many small
+    runnables, for instance when recursively dividing up work. Runnables
+    started with a priority other than 0, or from outside of the pool, are
+    always put on the shared run queue. Runnables on the shared run queue
+    with a higher priority are run first.
+
+    The default value is \c false.
+*/
+void QThreadPool::setWorkStealingEnabled(bool enabled)
+{
+    Q_D(QThreadPool);
+    d->workStealing.storeRelaxed(enabled);
+}
+
+bool QThreadPool::isWorkStealingEnabled() const
+{
+    Q_D(const QThreadPool);
+    return d->workStealing.loadRelaxed();
+}
+
+/*! \property QThreadPool::threadName
+    \brief the name of the pool's threads
+    \since 6.1
+
+    This is the \l{QObject::objectName}{objectName} of the threads, which
+    is also passed on to the operating system where it is supported, so
+    that it shows up in debuggers and profilers. A changed name applies to
+    the threads the pool starts afterwards; threads that are already running
+    keep their name.
+
+    If empty, the default, the threads are named "Thread (pooled)".
+*/
+void QThreadPool::setThreadName(const QString &name)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->threadName = name;
+}
+
+QString QThreadPool::threadName() const
+{
+    Q_D(const QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    return d->threadName;
+}
+
+/*!
+    \since 6.1
+
+    Restricts all of the pool's threads to run on the processors in \a cpus,
+    including the threads started later on. Processors are identified by the
+    numbers the operating system gives them, see QThread::setCpuAffinity().
+    An empty list, the default, lets them run on any processor.
+
+    \sa cpuAffinity(), setNumaNode(), QThread::setCpuAffinity()
+*/
+void QThreadPool::setCpuAffinity(const QList<int> &cpus)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->cpuAffinity = cpus;
+    d->numaNode = -1;
+    for (QThreadPoolThread *thread : qAsConst(d->allThreads))
+        thread->setCpuAffinity(cpus);
+}
+
+/*!
+    \since 6.1
+
+    Returns the processors the pool's threads are restricted to, or an empty
+    list if they can run on any processor.
+
+    \sa setCpuAffinity(), numaNode()
+*/
+QList<int> QThreadPool::cpuAffinity() const
+{
+    Q_D(const QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    return d->cpuAffinity;
+}
+
+/*!
+    \since 6.1
+
+    Restricts all of the pool's threads to run on the processors of NUMA
+    node \a node, and thereby usually to use the memory of that node. This
+    is the same as passing QThread::numaNodeCpus() to setCpuAffinity().
+    A negative \a node lets the threads run on any processor again.
+
+    To make use of all nodes without the threads accessing remote memory,
+    create one pool per node and set its maxThreadCount() to the number of
+    processors on the node:
+
+    \snippet code/src_corelib_concurrent_qthreadpool.cpp 1
+
+    \sa numaNode(), QThread::numaNodeCount()
+*/
+void QThreadPool::setNumaNode(int node)
+{
+    const QList<int> cpus = node < 0 ? QList<int>() : QThread::numaNodeCpus(node);
+    if (node >= 0 && cpus.isEmpty()) {
+        qWarning("QThreadPool::setNumaNode: NUMA node %d does not exist", node);
+        return;
+    }
+
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->cpuAffinity = cpus;
+    d->numaNode = qMax(node, -1);
+    for (QThreadPoolThread *thread : qAsConst(d->allThreads))
+        thread->setCpuAffinity(cpus);
+}
+
+/*!
+    \since 6.1
+
+    Returns the NUMA node the pool's threads were restricted to with
+    setNumaNode(), or -1 if they were not.
+
+    \sa setNumaNode(), cpuAffinity()
+*/
+int QThreadPool::numaNode() const
+{
+    Q_D(const QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    return d->numaNode;
+}
+
 /*!
     Releases a thread previously reserved by a call to reserveThread().
 
@@ -715,6 +1008,7 @@ void QThreadPool::releaseThread()
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
     --d->reservedThreads;
+    d->updateSpareThreads();
     d->tryToStartMoreThreads();
 }
 
@@ -60,6 +60,8 @@ class Q_CORE_EXPORT QThreadPool : public QObject
     Q_PROPERTY(int maxThreadCount READ maxThreadCount WRITE setMaxThreadCount)
     Q_PROPERTY(int activeThreadCount READ activeThreadCount)
     Q_PROPERTY(uint stackSize READ stackSize WRITE setStackSize)
+    Q_PROPERTY(bool workStealingEnabled READ isWorkStealingEnabled WRITE setWorkStealingEnabled)
+    Q_PROPERTY(QString threadName READ threadName WRITE setThreadName)
     friend class QFutureInterfaceBase;
 
 public:
@@ -85,6 +87,18 @@ public:
     void setStackSize(uint stackSize);
     uint stackSize() const;
 
+    void setWorkStealingEnabled(bool enabled);
+    bool isWorkStealingEnabled() const;
+
+    void setThreadName(const QString &name);
+    QString threadName() const;
+
+    void setCpuAffinity(const QList<int> &cpus);
+    QList<int> cpuAffinity() const;
+
+    void setNumaNode(int node);
+    int numaNode() const;
+
     void reserveThread();
     void releaseThread();
 
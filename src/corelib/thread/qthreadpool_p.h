@@ -59,6 +59,8 @@
 #include "QtCore/qqueue.h"
 #include "private/qobject_p.h"
 
+#include <limits>
+
 QT_REQUIRE_CONFIG(thread);
 
 QT_BEGIN_NAMESPACE
@@ -142,6 +144,53 @@ private:
     QRunnable *m_entries[MaxPageSize];
 };
 
+// The tasks a worker thread started while work stealing is enabled. The
+// worker itself takes the most recently started one, other workers steal
+// the oldest one.
+class QThreadPoolLocalQueue
+{
+public:
+    void push(QRunnable *runnable)
+    {
+        QMutexLocker locker(&mutex);
+        tasks.append(runnable);
+    }
+
+    QRunnable *pop()
+    {
+        QMutexLocker locker(&mutex);
+        return tasks.isEmpty() ? nullptr : tasks.takeLast();
+    }
+
+    QRunnable *steal()
+    {
+        QMutexLocker locker(&mutex);
+        return tasks.isEmpty() ? nullptr : tasks.takeFirst();
+    }
+
+    bool tryTake(QRunnable *runnable)
+    {
+        QMutexLocker locker(&mutex);
+        return tasks.removeOne(runnable);
+    }
+
+    QList<QRunnable *> takeAll()
+    {
+        QMutexLocker locker(&mutex);
+        return std::exchange(tasks, {});
+    }
+
+    bool isEmpty()
+    {
+        QMutexLocker locker(&mutex);
+        return tasks.isEmpty();
+    }
+
+private:
+    QMutex mutex;
+    QList<QRunnable *> tasks;
+};
+
 class QThreadPoolThread;
 class Q_CORE_EXPORT QThreadPoolPrivate : public QObjectPrivate
 {
@@ -158,6 +207,7 @@ public:
     void tryToStartMoreThreads();
     bool tooManyThreadsActive() const;
 
+    QString pooledThreadName() const;
     void startThread(QRunnable *runnable = nullptr);
     void reset();
     bool waitForDone(int msecs);
@@ -166,6 +216,13 @@ public:
     void stealAndRunRunnable(QRunnable *runnable);
     void deletePageIfFinished(QueuePage *page);
 
+    QRunnable *takeQueuedTask();
+    QRunnable *takeNextTask(QThreadPoolThread *thread);
+    QRunnable *stealTask(QThreadPoolThread *thief);
+    void startLocalTask(QThreadPoolThread *thread, QRunnable *runnable);
+    void updateSpareThreads();
+    void updateQueuedPriority();
+
     mutable QMutex mutex;
     QSet<QThreadPoolThread *> allThreads;
     QQueue<QThreadPoolThread *> waitingThreads;
@@ -178,6 +235,16 @@ public:
     int reservedThreads = 0;
     int activeThreads = 0;
     uint stackSize = 0;
+    QString threadName;
+    QList<int> cpuAffinity;
+    int numaNode = -1;
+
+    // The following can be read without holding the mutex
+    QAtomicInt workStealing;
+    // maxThreadCount - activeThreadCount()
+    QAtomicInt spareThreads = maxThreadCount;
+    // the priority of the first page in the queue, or INT_MIN
+    QAtomicInt queuedPriority = std::numeric_limits<int>::min();
 };
 
 QT_END_NAMESPACE
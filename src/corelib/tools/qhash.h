@@ -487,14 +487,16 @@ struct Data
         bool resized = numBuckets != other.numBuckets;
         size_t nSpans = (numBuckets + Span::LocalBucketMask) / Span::NEntries;
         spans = new Span[nSpans];
+        size_t otherNSpans = (other.numBuckets + Span::LocalBucketMask) / Span::NEntries;
 
-        for (size_t s = 0; s < nSpans; ++s) {
+        for (size_t s = 0; s < otherNSpans; ++s) {
             const Span &span = other.spans[s];
             for (size_t index = 0; index < Span::NEntries; ++index) {
                 if (!span.hasNode(index))
                     continue;
                 const Node &n = span.at(index);
-                iterator it = resized ? find(n.key) : iterator{ this, s*Span::NEntries + index };
+                iterator it = resized ? findUnused(QHashPrivate::calculateHash(n.key, seed))
+                                      : iterator{ this, s*Span::NEntries + index };
                 Q_ASSERT(it.isUnused());
                 Node *newNode = spans[it.span()].insert(it.index());
                 new (newNode) Node(n);
@@ -557,7 +559,7 @@ struct Data
                 if (!span.hasNode(index))
                     continue;
                 Node &n = span.at(index);
-                iterator it = find(n.key);
+                iterator it = findUnused(QHashPrivate::calculateHash(n.key, seed));
                 Q_ASSERT(it.isUnused());
                 Node *newNode = spans[it.span()].insert(it.index());
                 new (newNode) Node(std::move(n));
@@ -609,6 +611,17 @@ struct Data
         }
     }
 
+    // Returns the bucket a key with the given hash would be inserted in, for
+    // a key that is known not to be in the hash yet, without comparing keys.
+    iterator findUnused(size_t hash) const noexcept
+    {
+        Q_ASSERT(numBuckets > 0);
+        size_t bucket = GrowthPolicy::bucketForHash(numBuckets, hash);
+        while (spans[bucket / Span::NEntries].hasNode(bucket & Span::LocalBucketMask))
+            bucket = nextBucket(bucket);
+        return iterator{ this, bucket };
+    }
+
     Node *findNode(const Key &key) const noexcept
     {
         if (!size)
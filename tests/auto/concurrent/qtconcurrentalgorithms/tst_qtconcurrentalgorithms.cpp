@@ -0,0 +1,333 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtconcurrentalgorithms.h>
+
+#include <QTest>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+class tst_QtConcurrentAlgorithms : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void forEachIndex_data();
+    void forEachIndex();
+    void forEachIndexBlocks();
+    void sort_data();
+    void sort();
+    void sortCustomLessThan();
+    void sortNested();
+    void inclusiveScan_data();
+    void inclusiveScan();
+    void exclusiveScan_data();
+    void exclusiveScan();
+    void scanNonCommutative();
+    void transformReduce_data();
+    void transformReduce();
+    void transformReduceEmpty();
+};
+
+using namespace QtConcurrent;
+
+static QList<int> randomList(int count)
+{
+    std::mt19937 generator(count);
+    std::uniform_int_distribution<int> distribution(-1000, 1000);
+    QList<int> list(count);
+    for (int &value : list)
+        value = distribution(generator);
+    return list;
+}
+
+static void addThreadCountData()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("threadCount");
+
+    for (int count : {0, 1, 17, 5000, 100000}) {
+        for (int threadCount : {1, 2, 8})
+            QTest::addRow("%d items, %d threads", count, threadCount) << count << threadCount;
+    }
+}
+
+void tst_QtConcurrentAlgorithms::forEachIndex_data()
+{
+    addThreadCountData();
+}
+
+void tst_QtConcurrentAlgorithms::forEachIndex()
+{
+    QFETCH(int, count);
+    QFETCH(int, threadCount);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount);
+
+    QList<QAtomicInt> calls(count + 20);
+    auto visit = [&calls](int index) { calls[index].ref(); };
+
+    QtConcurrent::forEachIndex(&pool, 10, count + 10, visit).waitForFinished();
+    for (int i = 0; i < calls.size(); ++i)
+        QCOMPARE(calls.at(i).loadRelaxed(), i >= 10 && i < count + 10 ? 1 : 0);
+
+    QtConcurrent::blockingForEachIndex(&pool, 10, count + 10, visit);
+    for (int i = 0; i < calls.size(); ++i)
+        QCOMPARE(calls.at(i).loadRelaxed(), i >= 10 && i < count + 10 ? 2 : 0);
+
+    // an empty or reversed range doesn't call the functor
+    QtConcurrent::blockingForEachIndex(&pool, 10, 5, visit);
+    QCOMPARE(calls.at(5).loadRelaxed(), 0);
+}
+
+void tst_QtConcurrentAlgorithms::forEachIndexBlocks()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    QList<int> list(10000);
+    QAtomicInt blockCount;
+    QtConcurrent::blockingForEachIndex(&pool, 0, list.size(), [&](int begin, int end) {
+        QVERIFY(begin < end);
+        blockCount.ref();
+        for (int i = begin; i < end; ++i)
+            list[i] += i;
+    });
+
+    QVERIFY(blockCount.loadRelaxed() > 0);
+    QVERIFY(blockCount.loadRelaxed() < list.size());
+    for (int i = 0; i < list.size(); ++i)
+        QCOMPARE(list.at(i), i);
+}
+
+void tst_QtConcurrentAlgorithms::sort_data()
+{
+    addThreadCountData();
+}
+
+void tst_QtConcurrentAlgorithms::sort()
+{
+    QFETCH(int, count);
+    QFETCH(int, threadCount);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount);
+
+    QList<int> list = randomList(count);
+    QList<int> expected = list;
+    std::sort(expected.begin(), expected.end());
+
+    QtConcurrent::sort(&pool, list).waitForFinished();
+    QCOMPARE(list, expected);
+
+    std::vector<int> vector(expected.crbegin(), expected.crend());
+    QtConcurrent::blockingSort(&pool, vector);
+    QVERIFY(std::equal(vector.cbegin(), vector.cend(), expected.cbegin(), expected.cend()));
+}
+
+void tst_QtConcurrentAlgorithms::sortCustomLessThan()
+{
+    QList<int> list = randomList(50000);
+    QList<int> expected = list;
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+
+    QtConcurrent::blockingSort(list, std::greater<>());
+    QCOMPARE(list, expected);
+
+    QStringList strings;
+    for (int i = 0; i < 10000; ++i)
+        strings.append(QString::number(i));
+    QStringList expectedStrings = strings;
+    auto byLength = [](const QString &a, const QString &b) {
+        return a.size() < b.size() || (a.size() == b.size() && a < b);
+    };
+    std::sort(expectedStrings.begin(), expectedStrings.end());
+    std::shuffle(strings.begin(), strings.end(), std::mt19937(42));
+
+    QtConcurrent::sort(strings).waitForFinished();
+    QCOMPARE(strings, expectedStrings);
+
+    std::sort(expectedStrings.begin(), expectedStrings.end(), byLength);
+    QtConcurrent::sort(strings, byLength).waitForFinished();
+    QCOMPARE(strings, expectedStrings);
+}
+
+void tst_QtConcurrentAlgorithms::sortNested()
+{
+    // the coordinating task takes the only thread of the pool, the passes
+    // must still make progress
+    QThreadPool pool;
+    pool.setMaxThreadCount(1);
+
+    QList<int> list = randomList(100000);
+    QList<int> expected = list;
+    std::sort(expected.begin(), expected.end());
+
+    QtConcurrent::sort(&pool, list).waitForFinished();
+    QCOMPARE(list, expected);
+}
+
+void tst_QtConcurrentAlgorithms::inclusiveScan_data()
+{
+    addThreadCountData();
+}
+
+void tst_QtConcurrentAlgorithms::inclusiveScan()
+{
+    QFETCH(int, count);
+    QFETCH(int, threadCount);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount);
+
+    const QList<int> input = randomList(count);
+    QList<int> expected(count);
+    std::partial_sum(input.cbegin(), input.cend(), expected.begin());
+
+    QList<int> list = input;
+    QtConcurrent::inclusiveScan(&pool, list).waitForFinished();
+    QCOMPARE(list, expected);
+
+    list = input;
+    QtConcurrent::blockingInclusiveScan(&pool, list);
+    QCOMPARE(list, expected);
+
+    // a different operation
+    std::partial_sum(input.cbegin(), input.cend(), expected.begin(),
+                     [](int a, int b) { return qMax(a, b); });
+    list = input;
+    QtConcurrent::blockingInclusiveScan(&pool, list, [](int a, int b) { return qMax(a, b); });
+    QCOMPARE(list, expected);
+}
+
+void tst_QtConcurrentAlgorithms::exclusiveScan_data()
+{
+    addThreadCountData();
+}
+
+void tst_QtConcurrentAlgorithms::exclusiveScan()
+{
+    QFETCH(int, count);
+    QFETCH(int, threadCount);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount);
+
+    const QList<int> input = randomList(count);
+    QList<qint64> expected(count);
+    qint64 sum = 42;
+    for (int i = 0; i < count; ++i) {
+        expected[i] = sum;
+        sum += input.at(i);
+    }
+
+    QList<qint64> list(input.cbegin(), input.cend());
+    QtConcurrent::exclusiveScan(&pool, list, qint64(42)).waitForFinished();
+    QCOMPARE(list, expected);
+
+    list = QList<qint64>(input.cbegin(), input.cend());
+    QtConcurrent::blockingExclusiveScan(&pool, list, qint64(42));
+    QCOMPARE(list, expected);
+}
+
+void tst_QtConcurrentAlgorithms::scanNonCommutative()
+{
+    // string concatenation is associative, but not commutative
+    QStringList list;
+    for (int i = 0; i < 3000; ++i)
+        list.append(QString(QChar(u'a' + i % 26)));
+    QStringList expected = list;
+    std::partial_sum(expected.begin(), expected.end(), expected.begin());
+
+    QStringList inclusive = list;
+    QtConcurrent::blockingInclusiveScan(inclusive);
+    QCOMPARE(inclusive, expected);
+
+    expected.prepend(QStringLiteral(">"));
+    for (int i = 1; i < expected.size(); ++i)
+        expected[i].prepend(u'>');
+    expected.removeLast();
+
+    QStringList exclusive = list;
+    QtConcurrent::exclusiveScan(exclusive, QStringLiteral(">")).waitForFinished();
+    QCOMPARE(exclusive, expected);
+}
+
+void tst_QtConcurrentAlgorithms::transformReduce_data()
+{
+    addThreadCountData();
+}
+
+void tst_QtConcurrentAlgorithms::transformReduce()
+{
+    QFETCH(int, count);
+    QFETCH(int, threadCount);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount);
+
+    const QList<int> list = randomList(count);
+    auto square = [](int value) { return qint64(value) * value; };
+    const qint64 expected = std::transform_reduce(list.cbegin(), list.cend(), qint64(7),
+                                                  std::plus<>(), square);
+
+    QCOMPARE(QtConcurrent::transformReduce(&pool, list, qint64(7), std::plus<>(), square).result(),
+             expected);
+    QCOMPARE(QtConcurrent::blockingTransformReduce(&pool, list, qint64(7), std::plus<>(), square),
+             expected);
+
+    // a default constructed value is not neutral for qMin()
+    const QList<int> ones(count, 1);
+    auto twice = [](int value) { return value * 2; };
+    const int minimum = QtConcurrent::blockingTransformReduce(
+            &pool, ones, 100, [](int a, int b) { return qMin(a, b); }, twice);
+    QCOMPARE(minimum, count ? 2 : 100);
+
+    // partial results are not combined through a narrower argument
+    auto large = [](int) { return 1 << 20; };
+    const qint64 total = QtConcurrent::blockingTransformReduce(
+            &pool, list, qint64(0), [](qint64 a, int b) { return a + b; }, large);
+    QCOMPARE(total, qint64(count) << 20);
+}
+
+void tst_QtConcurrentAlgorithms::transformReduceEmpty()
+{
+    const QList<int> empty;
+    auto identity = [](int value) { return value; };
+    QCOMPARE(QtConcurrent::blockingTransformReduce(empty, 5, std::multiplies<>(), identity), 5);
+    QCOMPARE(QtConcurrent::transformReduce(empty, 5, std::multiplies<>(), identity).result(), 5);
+
+    const QList<int> list {1, 2, 3, 4};
+    QCOMPARE(QtConcurrent::blockingTransformReduce(list, 5, std::multiplies<>(), identity), 120);
+}
+
+QTEST_MAIN(tst_QtConcurrentAlgorithms)
+#include "tst_qtconcurrentalgorithms.moc"
@@ -54,6 +54,7 @@ private slots:
     void mappedReducedInitialValueThreadPool();
     void mappedReducedInitialValueWithMoveOnlyCallable();
     void mappedReducedDifferentTypeInitialValue();
+    void mappedReducedParallel();
     void assignResult();
     void functionOverloads();
     void noExceptFunctionOverloads();
@@ -1444,6 +1445,70 @@ int sleeper(int val)
     return val;
 }
 
+void tst_QtConcurrentMap::mappedReducedParallel()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    QList<int> intList;
+    for (int i = 0; i < 10000; ++i)
+        intList.append(i);
+    const qint64 sum = 2 * (qint64(9999) * 10000 / 2);
+
+    // not passed as plain enum values, which would be taken for the initial value
+    const QtConcurrent::ReduceOptions unordered(QtConcurrent::UnorderedReduce
+                                                | QtConcurrent::ParallelReduce);
+    const QtConcurrent::ReduceOptions ordered(QtConcurrent::OrderedReduce
+                                              | QtConcurrent::ParallelReduce);
+
+    auto sumReduce = [](qint64 &result, qint64 value) { result += value; };
+    auto doubled = [](int x) { return qint64(x) * 2; };
+
+    {
+        const qint64 result = QtConcurrent::blockingMappedReduced<qint64>(
+                &pool, intList, doubled, sumReduce, unordered);
+        QCOMPARE(result, sum);
+    }
+    {
+        const qint64 result = QtConcurrent::blockingMappedReduced<qint64>(
+                &pool, intList, doubled, sumReduce, ordered);
+        QCOMPARE(result, sum);
+    }
+    {
+        // the initial value is only added once
+        const qint64 result = QtConcurrent::blockingMappedReduced<qint64>(
+                &pool, intList, doubled, sumReduce, qint64(10), unordered);
+        QCOMPARE(result, sum + 10);
+    }
+    {
+        // the order of the sequence is kept when combining partial results
+        auto toList = [](int x) { return QList<int>{x}; };
+        auto appendReduce = [](QList<int> &result, const QList<int> &value) { result += value; };
+        const QList<int> result = QtConcurrent::blockingMappedReduced<QList<int>>(
+                &pool, intList, toList, appendReduce, QList<int>{-1}, ordered);
+        QCOMPARE(result.size(), intList.size() + 1);
+        QCOMPARE(result.first(), -1);
+        QCOMPARE(result.mid(1), intList);
+    }
+    {
+        // partial results can't be combined, falls back to sequential reduction
+        auto toString = [](int x) { return QString::number(x); };
+        auto lengthReduce = [](int &result, const QString &value) { result += value.size(); };
+        const int result = QtConcurrent::blockingMappedReduced<int>(
+                &pool, intList, toString, lengthReduce,
+                QtConcurrent::ReduceOptions(QtConcurrent::ParallelReduce));
+        QCOMPARE(result, 10 + 90 * 2 + 900 * 3 + 9000 * 4);
+    }
+    {
+        // the partial results would be truncated when passed as an int
+        auto large = [](int) { return 1 << 20; };
+        auto narrowingReduce = [](qint64 &result, int value) { result += value; };
+        const qint64 result = QtConcurrent::blockingMappedReduced<qint64>(
+                &pool, intList, large, narrowingReduce, unordered);
+        QCOMPARE(result, qint64(intList.size()) << 20);
+    }
+}
+
 void tst_QtConcurrentMap::assignResult()
 {
     const QList<int> startList = QList<int>() << 0 << 1 << 2;
@@ -0,0 +1,295 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtconcurrentpipeline.h>
+
+#include <QTest>
+#include <QSemaphore>
+
+class tst_QtConcurrentPipeline : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void orderedResults_data();
+    void orderedResults();
+    void serialStages();
+    void maxTokens();
+    void emptySource();
+    void moveOnlyItems();
+    void cancel();
+#ifndef QT_NO_EXCEPTIONS
+    void exceptions();
+#endif
+    void statistics();
+};
+
+using namespace QtConcurrent;
+
+// returns the numbers from 0 up to count
+static auto counter(int count)
+{
+    return [i = 0, count]() mutable -> std::optional<int> {
+        if (i == count)
+            return std::nullopt;
+        return i++;
+    };
+}
+
+void tst_QtConcurrentPipeline::orderedResults_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::addColumn<int>("maxTokens");
+
+    QTest::newRow("1 thread") << 1 << 0;
+    QTest::newRow("4 threads") << 4 << 0;
+    QTest::newRow("4 threads, 1 token") << 4 << 1;
+    QTest::newRow("16 threads, 3 tokens") << 16 << 3;
+}
+
+void tst_QtConcurrentPipeline::orderedResults()
+{
+    QFETCH(int, threadCount);
+    QFETCH(int, maxTokens);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount);
+
+    const int count = 2000;
+    QList<int> written;
+    QFuture<QString> future = pipeline(counter(count))
+            .addStage(StageMode::Parallel, [](int i) { return i * 2; })
+            .addStage(StageMode::SerialInOrder, [&written](int i) {
+                written.append(i);
+                return i;
+            })
+            .addStage(StageMode::Parallel, [](int i) { return QString::number(i); })
+            .withMaxTokens(maxTokens)
+            .onThreadPool(pool)
+            .spawn();
+    future.waitForFinished();
+
+    QCOMPARE(written.size(), count);
+    const QList<QString> results = future.results();
+    QCOMPARE(results.size(), count);
+    for (int i = 0; i < count; ++i) {
+        QCOMPARE(written.at(i), i * 2);
+        QCOMPARE(results.at(i), QString::number(i * 2));
+    }
+}
+
+void tst_QtConcurrentPipeline::serialStages()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(8);
+
+    QAtomicInt inStage;
+    QAtomicInt overlaps;
+    auto serial = [&](int i) {
+        if (inStage.fetchAndAddRelaxed(1) != 0)
+            overlaps.ref();
+        QThread::yieldCurrentThread();
+        inStage.deref();
+        return i;
+    };
+
+    QSet<int> seen;
+    pipeline(counter(1000))
+            .addStage(StageMode::Parallel, [](int i) { return i; })
+            .addStage(StageMode::SerialOutOfOrder, serial)
+            .addStage(StageMode::SerialOutOfOrder, [&seen](int i) { seen.insert(i); })
+            .onThreadPool(pool)
+            .spawn()
+            .waitForFinished();
+
+    QCOMPARE(overlaps.loadRelaxed(), 0);
+    QCOMPARE(seen.size(), 1000);
+}
+
+void tst_QtConcurrentPipeline::maxTokens()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(8);
+
+    // the source and the last stage are both serial, so they can count the
+    // items in flight without a lock
+    int inFlight = 0;
+    QAtomicInt maxInFlight;
+    int produced = 0;
+    auto source = [&]() -> std::optional<int> {
+        if (produced == 500)
+            return std::nullopt;
+        const int current = ++inFlight;
+        if (current > maxInFlight.loadRelaxed())
+            maxInFlight.storeRelaxed(current);
+        return produced++;
+    };
+
+    QMutex mutex;
+    pipeline(source)
+            .addStage(StageMode::Parallel, [](int i) {
+                QThread::usleep(50);
+                return i;
+            })
+            .addStage(StageMode::SerialOutOfOrder, [&](int) {
+                QMutexLocker locker(&mutex);
+                --inFlight;
+            })
+            .withMaxTokens(3)
+            .onThreadPool(pool)
+            .spawn()
+            .waitForFinished();
+
+    QCOMPARE(produced, 500);
+    QVERIFY(maxInFlight.loadRelaxed() <= 3);
+}
+
+void tst_QtConcurrentPipeline::emptySource()
+{
+    QFuture<int> future = pipeline(counter(0))
+            .addStage(StageMode::SerialInOrder, [](int i) { return i; })
+            .spawn();
+    future.waitForFinished();
+    QVERIFY(future.isFinished());
+    QCOMPARE(future.resultCount(), 0);
+}
+
+void tst_QtConcurrentPipeline::moveOnlyItems()
+{
+    int i = 0;
+    auto source = [&i]() -> std::optional<std::unique_ptr<int>> {
+        if (i == 100)
+            return std::nullopt;
+        return std::make_unique<int>(i++);
+    };
+
+    QList<int> values;
+    pipeline(source)
+            .addStage(StageMode::Parallel, [](std::unique_ptr<int> &&value) {
+                *value += 1;
+                return std::move(value);
+            })
+            .addStage(StageMode::SerialInOrder, [&values](std::unique_ptr<int> &&value) {
+                values.append(*value);
+            })
+            .spawn()
+            .waitForFinished();
+
+    QCOMPARE(values.size(), 100);
+    for (int i = 0; i < values.size(); ++i)
+        QCOMPARE(values.at(i), i + 1);
+}
+
+void tst_QtConcurrentPipeline::cancel()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    QSemaphore started;
+    QAtomicInt processed;
+    // the source never ends
+    QFuture<void> future = pipeline([]() -> std::optional<int> { return 0; })
+            .addStage(StageMode::Parallel, [](int i) { return i; })
+            .addStage(StageMode::SerialInOrder, [&](int) {
+                if (processed.fetchAndAddRelaxed(1) == 10)
+                    started.release();
+            })
+            .onThreadPool(pool)
+            .spawn();
+
+    QVERIFY(started.tryAcquire(1, 10000));
+    future.cancel();
+    future.waitForFinished();
+    QVERIFY(future.isCanceled());
+    QVERIFY(pool.waitForDone(10000));
+}
+
+#ifndef QT_NO_EXCEPTIONS
+class PipelineException : public QException
+{
+public:
+    void raise() const override { throw *this; }
+    PipelineException *clone() const override { return new PipelineException(*this); }
+};
+
+void tst_QtConcurrentPipeline::exceptions()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    QFuture<int> future = pipeline([]() -> std::optional<int> { return 0; })
+            .addStage(StageMode::Parallel, [](int i) { return i; })
+            .addStage(StageMode::SerialInOrder, [count = 0](int i) mutable {
+                if (++count == 50)
+                    throw PipelineException();
+                return i;
+            })
+            .onThreadPool(pool)
+            .spawn();
+
+    QVERIFY_EXCEPTION_THROWN(future.waitForFinished(), PipelineException);
+    QVERIFY(future.isCanceled());
+
+    // the source throws
+    QFuture<void> sourceFuture = pipeline([]() -> std::optional<int> { throw 42; })
+            .addStage(StageMode::Parallel, [](int) { })
+            .onThreadPool(pool)
+            .spawn();
+    QVERIFY_EXCEPTION_THROWN(sourceFuture.waitForFinished(), QUnhandledException);
+}
+#endif
+
+void tst_QtConcurrentPipeline::statistics()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    PipelineStatistics statistics;
+    QCOMPARE(statistics.stageCount(), 0);
+    QCOMPARE(statistics.processedCount(0), 0);
+
+    pipeline(counter(300))
+            .addStage(StageMode::Parallel, [](int i) {
+                QThread::usleep(10);
+                return i;
+            })
+            .addStage(StageMode::SerialInOrder, [](int) { })
+            .withStatistics(statistics)
+            .onThreadPool(pool)
+            .spawn()
+            .waitForFinished();
+
+    QCOMPARE(statistics.stageCount(), 3);
+    for (int stage = 0; stage < 3; ++stage)
+        QCOMPARE(statistics.processedCount(stage), 300);
+    QVERIFY(statistics.busyTime(1) >= 300 * 10000);
+    QCOMPARE(statistics.processedCount(3), 0);
+}
+
+QTEST_MAIN(tst_QtConcurrentPipeline)
+#include "tst_qtconcurrentpipeline.moc"
@@ -27,6 +27,7 @@
 ****************************************************************************/
 
 #include <qtconcurrenttask.h>
+#include <qtaskgraph.h>
 
 #include <QTest>
 #include <QSemaphore>
@@ -49,6 +50,10 @@ private Q_SLOTS:
     void adjustAllSettings();
     void ignoreFutureResult();
     void withPromise();
+    void taskGraph();
+    void taskGraphOrder();
+    void taskGraphFailure();
+    void taskGraphCancel();
 };
 
 using namespace QtConcurrent;
@@ -217,5 +222,147 @@ void tst_QtConcurrentTask::withPromise()
     QCOMPARE(task(&incrementWithPromise).withArguments(1).withPriority(7).spawn().result(), 2);
 }
 
+void tst_QtConcurrentTask::taskGraph()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    QTaskGraph graph;
+    graph.onThreadPool(pool);
+    QCOMPARE(graph.taskCount(), 0);
+
+    // an empty graph finishes immediately
+    QFuture<void> future = graph.spawn();
+    QVERIFY(future.isFinished());
+
+    int a = 0;
+    int b = 0;
+    int c = 0;
+    auto nodeA = graph.addTask([&a] { a = 1; });
+    auto nodeB = graph.addTask([&b] { b = 2; });
+    graph.addTask([&] { c = a + b; }, {nodeA, nodeB});
+    QCOMPARE(graph.taskCount(), 3);
+    QVERIFY(nodeA.isValid());
+    QVERIFY(!QTaskGraph::Node().isValid());
+
+    future = graph.spawn();
+    future.waitForFinished();
+    QCOMPARE(c, 3);
+    QCOMPARE(future.progressValue(), 3);
+
+    // the same graph can run again
+    a = 10;
+    c = 0;
+    graph.spawn().waitForFinished();
+    QCOMPARE(c, 3);
+}
+
+void tst_QtConcurrentTask::taskGraphOrder()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(8);
+
+    // a diamond lattice, where each task depends on up to two tasks of
+    // the row above and checks that they have finished
+    const int rows = 20;
+    const int columns = 10;
+    QList<QAtomicInt> finished(rows * columns);
+    QAtomicInt violations;
+
+    QTaskGraph graph;
+    graph.onThreadPool(pool);
+    QList<QTaskGraph::Node> previousRow;
+    for (int row = 0; row < rows; ++row) {
+        QList<QTaskGraph::Node> currentRow;
+        for (int column = 0; column < columns; ++column) {
+            QList<QTaskGraph::Node> dependencies;
+            QList<int> dependencyIndexes;
+            if (row > 0) {
+                for (int c : {column, (column + 1) % columns}) {
+                    dependencies.append(previousRow.at(c));
+                    dependencyIndexes.append((row - 1) * columns + c);
+                }
+            }
+            const int index = row * columns + column;
+            currentRow.append(graph.addTask([&, index, dependencyIndexes] {
+                for (int dependency : dependencyIndexes) {
+                    if (!finished.at(dependency).loadAcquire())
+                        violations.ref();
+                }
+                finished[index].storeRelease(1);
+            }, dependencies));
+        }
+        previousRow = currentRow;
+    }
+
+    graph.spawn().waitForFinished();
+    QCOMPARE(violations.loadRelaxed(), 0);
+    for (const QAtomicInt &done : finished)
+        QCOMPARE(done.loadRelaxed(), 1);
+}
+
+#ifndef QT_NO_EXCEPTIONS
+class GraphException : public QException
+{
+public:
+    void raise() const override { throw *this; }
+    GraphException *clone() const override { return new GraphException(*this); }
+};
+#endif
+
+void tst_QtConcurrentTask::taskGraphFailure()
+{
+#ifndef QT_NO_EXCEPTIONS
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    QAtomicInt ran;
+    QTaskGraph graph;
+    graph.onThreadPool(pool);
+    auto failing = graph.addTask([] { throw GraphException(); });
+    auto dependent = graph.addTask([&ran] { ran.ref(); }, {failing});
+    graph.addTask([&ran] { ran.ref(); }, {dependent});
+    auto independent = graph.addTask([&ran] { ran.fetchAndAddRelaxed(100); });
+    graph.addTask([&ran] { ran.fetchAndAddRelaxed(100); }, {independent});
+
+    QFuture<void> future = graph.spawn();
+    QVERIFY_EXCEPTION_THROWN(future.waitForFinished(), GraphException);
+    // the dependents of the failed task are skipped, the others still run
+    QCOMPARE(ran.loadRelaxed(), 200);
+    QVERIFY(pool.waitForDone());
+#else
+    QSKIP("This test requires exception support");
+#endif
+}
+
+void tst_QtConcurrentTask::taskGraphCancel()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(2);
+
+    QSemaphore started;
+    QSemaphore proceed;
+    QAtomicInt ran;
+
+    QTaskGraph graph;
+    graph.onThreadPool(pool);
+    auto first = graph.addTask([&] {
+        started.release();
+        proceed.acquire();
+    });
+    auto second = graph.addTask([&ran] { ran.ref(); }, {first});
+    graph.addTask([&ran] { ran.ref(); }, {second});
+
+    QFuture<void> future = graph.spawn();
+    started.acquire();
+    future.cancel();
+    proceed.release();
+    future.waitForFinished();
+
+    QVERIFY(future.isCanceled());
+    QCOMPARE(ran.loadRelaxed(), 0);
+    QVERIFY(pool.waitForDone());
+}
+
 QTEST_MAIN(tst_QtConcurrentTask)
 #include "tst_qtconcurrenttask.moc"
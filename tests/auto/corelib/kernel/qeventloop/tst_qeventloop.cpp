@@ -33,6 +33,7 @@
 #include <qcoreevent.h>
 #include <qeventloop.h>
 #include <private/qeventloop_p.h>
+#include <private/qeventloopstatistics_p.h>
 #if defined(Q_OS_UNIX)
   #include <private/qeventdispatcher_unix_p.h>
   #include <QtCore/private/qcore_unix_p.h>
@@ -41,6 +42,7 @@
   #endif
 #endif
 #include <qmutex.h>
+#include <qscopeguard.h>
 #include <qthread.h>
 #include <qtimer.h>
 #include <qwaitcondition.h>
@@ -174,6 +176,7 @@ private slots:
 #endif
     void processEventsExcludeTimers();
     void deliverInDefinedOrder();
+    void statistics();
 
     // keep this test last:
     void nestedLoops();
@@ -664,5 +667,51 @@ void tst_QEventLoop::testQuitLock()
     eventLoop.exec();
 }
 
+void tst_QEventLoop::statistics()
+{
+    QThread *thread = QThread::currentThread();
+    QVERIFY(!QEventLoopStatistics::isEnabled(thread));
+    QCOMPARE(QEventLoopStatistics::snapshot(thread).iterations, quint64(0));
+
+    QEventLoopStatistics::setEnabled(thread, true);
+    QVERIFY(QEventLoopStatistics::isEnabled(thread));
+    auto disable = qScopeGuard([thread] { QEventLoopStatistics::setEnabled(thread, false); });
+
+    QObject receiver;
+    for (int i = 0; i < 3; ++i)
+        QCoreApplication::postEvent(&receiver, new QEvent(QEvent::User));
+    QCoreApplication::sendPostedEvents();
+
+    QEventLoop loop;
+    QTimer::singleShot(10, &loop, &QEventLoop::quit);
+    loop.exec();
+
+    QEventLoopStatistics stats = QEventLoopStatistics::snapshot(thread);
+    QCOMPARE(stats.eventTypes.value(QEvent::User).count, quint64(3));
+    QVERIFY(stats.receiverClasses.value("QObject").count >= 3);
+    QVERIFY(stats.maxPostedEventQueueDepth >= 3);
+#if defined(Q_OS_UNIX)
+    QVERIFY(stats.timerActivations >= 1);
+    QVERIFY(stats.maxTimerLatenessNSecs >= 0);
+    if (qobject_cast<QEventDispatcherUNIX *>(QAbstractEventDispatcher::instance())) {
+        QVERIFY(stats.iterations > 0);
+        QVERIFY(stats.idleNSecs > 0);
+    }
+#endif
+
+    // disabled recording keeps the values, but adds nothing
+    QEventLoopStatistics::setEnabled(thread, false);
+    QVERIFY(!QEventLoopStatistics::isEnabled(thread));
+    QEvent event(QEvent::User);
+    QCoreApplication::sendEvent(&receiver, &event);
+    QCOMPARE(QEventLoopStatistics::snapshot(thread).eventTypes.value(QEvent::User).count, quint64(3));
+
+    QEventLoopStatistics::reset(thread);
+    stats = QEventLoopStatistics::snapshot(thread);
+    QVERIFY(stats.eventTypes.isEmpty());
+    QVERIFY(stats.receiverClasses.isEmpty());
+    QCOMPARE(stats.iterations, quint64(0));
+}
+
 QTEST_MAIN(tst_QEventLoop)
 #include "tst_qeventloop.moc"
@@ -325,6 +325,7 @@ private slots:
 
     void firstMethod_data();
     void firstMethod();
+    void indexOfMethodInherited();
 
     void indexOfMethodPMF();
 
@@ -1741,6 +1742,37 @@ void tst_QMetaObject::firstMethod()
     QCOMPARE(firstMethod, method);
 }
 
+class AliasBase : public QObject {
+    Q_OBJECT
+public slots:
+    void alias(int) {}
+};
+
+class AliasDerived : public AliasBase {
+    Q_OBJECT
+public slots:
+    void alias(qint32) {}
+};
+
+void tst_QMetaObject::indexOfMethodInherited()
+{
+    const QMetaObject &derived = Derived::staticMetaObject;
+    const int test = derived.indexOfMethod("test()");
+    QVERIFY(test >= derived.methodOffset());
+    // repeated lookups are served from the index and must agree
+    QCOMPARE(derived.indexOfMethod("test()"), test);
+    QVERIFY(Base::staticMetaObject.indexOfMethod("test()") < derived.methodOffset());
+    QCOMPARE(derived.indexOfMethod("baseOnly()"), Base::staticMetaObject.indexOfMethod("baseOnly()"));
+    QCOMPARE(derived.indexOfMethod("noSuchMethod()"), -1);
+
+    // the derived overload also matches the signature spelled with int
+    const QMetaObject &aliased = AliasDerived::staticMetaObject;
+    const int alias = aliased.indexOfMethod("alias(qint32)");
+    QVERIFY(alias >= aliased.methodOffset());
+    QCOMPARE(aliased.indexOfMethod("alias(int)"), alias);
+    QCOMPARE(aliased.indexOfMethod("alias(int)"), alias);
+}
+
 void tst_QMetaObject::indexOfMethodPMF()
 {
 #define INDEXOFMETHODPMF_HELPER(ObjectType, Name, Arguments)  { \
@@ -178,6 +178,7 @@ private:
 private slots:
     void defined();
     void threadSafety();
+    void converterRegistryChurn();
     void namespaces();
     void id();
     void qMetaTypeId();
@@ -588,6 +589,69 @@ void tst_QMetaType::threadSafety()
     QCOMPARE(Bar::failureCount, 0);
 }
 
+struct ChurnSource { int value; };
+struct ChurnTarget { int value; };
+struct ChurnReentrantTarget { int value; };
+
+#ifdef QT_BUILD_INTERNAL
+QT_BEGIN_NAMESPACE
+Q_CORE_EXPORT size_t qt_metaTypeConverterRegistryRetiredCount();
+QT_END_NAMESPACE
+#endif
+
+void tst_QMetaType::converterRegistryChurn()
+{
+    const QMetaType source = QMetaType::fromType<ChurnSource>();
+    const QMetaType target = QMetaType::fromType<ChurnTarget>();
+
+    // convert in other threads while the converter keeps being replaced
+    QAtomicInt stop;
+    QAtomicInt failures;
+    std::unique_ptr<QThread> threads[4];
+    for (auto &thread : threads) {
+        thread.reset(QThread::create([&] {
+            const ChurnSource from = { 42 };
+            while (!stop.loadRelaxed()) {
+                ChurnTarget to = { 0 };
+                if (QMetaType::convert(source, &from, target, &to) && to.value != 42 && to.value != 43)
+                    failures.ref();
+            }
+        }));
+        thread->start();
+    }
+    for (int i = 0; i < 20000; ++i) {
+        QVERIFY((QMetaType::registerConverter<ChurnSource, ChurnTarget>([i](const ChurnSource &from) {
+            return ChurnTarget{ from.value + (i & 1) };
+        })));
+        QMetaType::unregisterConverterFunction(source, target);
+    }
+    stop.storeRelaxed(1);
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+    QCOMPARE(failures.loadRelaxed(), 0);
+
+    // a running converter may register another one
+    const QMetaType reentrantTarget = QMetaType::fromType<ChurnReentrantTarget>();
+    QVERIFY((QMetaType::registerConverter<ChurnSource, ChurnReentrantTarget>([](const ChurnSource &from) {
+        QMetaType::registerConverter<ChurnSource, ChurnTarget>([](const ChurnSource &from) {
+            return ChurnTarget{ from.value };
+        });
+        return ChurnReentrantTarget{ from.value };
+    })));
+    const ChurnSource from = { 7 };
+    ChurnReentrantTarget to = { 0 };
+    QVERIFY(QMetaType::convert(source, &from, reentrantTarget, &to));
+    QCOMPARE(to.value, 7);
+    QVERIFY((QMetaType::hasRegisteredConverterFunction<ChurnSource, ChurnTarget>()));
+    QMetaType::unregisterConverterFunction(source, reentrantTarget);
+    QMetaType::unregisterConverterFunction(source, target);
+
+#ifdef QT_BUILD_INTERNAL
+    // with no conversion running, unlinked entries do not pile up
+    QCOMPARE(qt_metaTypeConverterRegistryRetiredCount(), size_t(0));
+#endif
+}
+
 namespace TestSpace
 {
     struct Foo { double d; public: ~Foo() {} };
@@ -97,6 +97,7 @@ private slots:
     void blockingQueuedConnection();
     void childEvents();
     void installEventFilter();
+    void installTypedEventFilter();
     void deleteSelfInSlot();
     void disconnectSelfInSlotAndDeleteAfterEmit();
     void dumpObjectInfo();
@@ -162,6 +163,7 @@ private slots:
     void functorReferencesConnection();
     void disconnectDisconnects();
     void singleShotConnection();
+    void coalescedConnection();
 };
 
 struct QObjectCreatedOnShutdown
@@ -3219,6 +3221,85 @@ void tst_QObject::installEventFilter()
     QVERIFY(spy.eventList().isEmpty());
 }
 
+void tst_QObject::installTypedEventFilter()
+{
+    QEvent user(QEvent::User);
+    QEvent user1(QEvent::Type(QEvent::User + 1));
+    EventSpy::EventList expected;
+
+    QObject object;
+    EventSpy typed;
+    EventSpy untyped;
+    object.installEventFilter(&typed, { QEvent::User });
+    object.installEventFilter(&untyped);
+
+    // only events of the registered type reach the typed filter
+    QCoreApplication::sendEvent(&object, &user1);
+    QVERIFY(typed.eventList().isEmpty());
+    expected = EventSpy::EventList() << qMakePair(&object, QEvent::Type(QEvent::User + 1));
+    QCOMPARE(untyped.eventList(), expected);
+    untyped.clear();
+
+    QCoreApplication::sendEvent(&object, &user);
+    expected = EventSpy::EventList() << qMakePair(&object, QEvent::User);
+    QCOMPARE(typed.eventList(), expected);
+    QCOMPARE(untyped.eventList(), expected);
+    typed.clear();
+    untyped.clear();
+
+    // the last installed filter is activated first, whatever its types
+    {
+        class OrderFilter : public QObject
+        {
+        public:
+            OrderFilter(QList<QObject *> *order) : order(order) {}
+            bool eventFilter(QObject *, QEvent *) override
+            {
+                order->append(this);
+                return false;
+            }
+            QList<QObject *> *order;
+        };
+        QList<QObject *> order;
+        QObject watched;
+        OrderFilter first(&order), second(&order), third(&order);
+        watched.installEventFilter(&first);
+        watched.installEventFilter(&second, { QEvent::User });
+        watched.installEventFilter(&third);
+        QCoreApplication::sendEvent(&watched, &user);
+        QCOMPARE(order, QList<QObject *>() << &third << &second << &first);
+        order.clear();
+        QCoreApplication::sendEvent(&watched, &user1);
+        QCOMPARE(order, QList<QObject *>() << &third << &first);
+    }
+
+    // re-installing replaces the set of types
+    object.installEventFilter(&typed, { QEvent::Type(QEvent::User + 1) });
+    QCoreApplication::sendEvent(&object, &user);
+    QVERIFY(typed.eventList().isEmpty());
+    QCoreApplication::sendEvent(&object, &user1);
+    expected = EventSpy::EventList() << qMakePair(&object, QEvent::Type(QEvent::User + 1));
+    QCOMPARE(typed.eventList(), expected);
+    typed.clear();
+    untyped.clear();
+
+    // removed filters are not called any more
+    object.removeEventFilter(&typed);
+    QCoreApplication::sendEvent(&object, &user1);
+    QVERIFY(typed.eventList().isEmpty());
+    QCOMPARE(untyped.eventList(), expected);
+    untyped.clear();
+
+    // a deleted typed filter is skipped too
+    {
+        EventSpy scoped;
+        object.installEventFilter(&scoped, { QEvent::User });
+    }
+    QCoreApplication::sendEvent(&object, &user);
+    expected = EventSpy::EventList() << qMakePair(&object, QEvent::User);
+    QCOMPARE(untyped.eventList(), expected);
+}
+
 class EmitThread : public QThread
 {   Q_OBJECT
 public:
@@ -8138,6 +8219,99 @@ void tst_QObject::singleShotConnection()
     }
 }
 
+void tst_QObject::coalescedConnection()
+{
+    const auto type = static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::CoalescedConnection);
+
+    {
+        // Plain queued connection: one call per emission
+        QObject sender;
+        QObject receiver;
+        QStringList received;
+        connect(&sender, &QObject::objectNameChanged, &receiver,
+                [&](const QString &name) { received << name; }, Qt::QueuedConnection);
+
+        sender.setObjectName("a");
+        sender.setObjectName("b");
+        sender.setObjectName("c");
+        QCOMPARE(received.size(), 0);
+        QCoreApplication::processEvents();
+        QCOMPARE(received, QStringList({ "a", "b", "c" }));
+    }
+
+    {
+        // Coalesced connection: pending calls take the latest arguments
+        QObject sender;
+        QObject receiver;
+        QStringList received;
+        QMetaObject::Connection c = connect(&sender, &QObject::objectNameChanged, &receiver,
+                                            [&](const QString &name) { received << name; }, type);
+        QVERIFY(c);
+
+        sender.setObjectName("a");
+        sender.setObjectName("b");
+        sender.setObjectName("c");
+        QCOMPARE(received.size(), 0);
+        QCoreApplication::processEvents();
+        QCOMPARE(received, QStringList({ "c" }));
+
+        // once delivered, the next emission queues a new call
+        sender.setObjectName("d");
+        QCoreApplication::processEvents();
+        QCOMPARE(received, QStringList({ "c", "d" }));
+
+        // direct emissions are not affected
+        received.clear();
+        QObject::disconnect(c);
+        connect(&sender, &QObject::objectNameChanged, &receiver,
+                [&](const QString &name) { received << name; },
+                static_cast<Qt::ConnectionType>(Qt::DirectConnection | Qt::CoalescedConnection));
+        sender.setObjectName("e");
+        sender.setObjectName("f");
+        QCOMPARE(received, QStringList({ "e", "f" }));
+    }
+
+    {
+        // String-based connection
+        QObject sender;
+        SenderObject receiver;
+        QVERIFY(connect(&sender, SIGNAL(objectNameChanged(QString)),
+                        &receiver, SLOT(aPublicSlot()), type));
+        sender.setObjectName("a");
+        sender.setObjectName("b");
+        QCoreApplication::processEvents();
+        QCOMPARE(receiver.aPublicSlotCalled, 1);
+    }
+
+    {
+        // Receiver deleted while a coalesced call is pending
+        QObject sender;
+        QStringList received;
+        auto receiver = std::make_unique<QObject>();
+        connect(&sender, &QObject::objectNameChanged, receiver.get(),
+                [&](const QString &name) { received << name; }, type);
+        sender.setObjectName("a");
+        receiver.reset();
+        sender.setObjectName("b");
+        QCoreApplication::processEvents();
+        QVERIFY(received.isEmpty());
+    }
+
+    {
+        // Disconnected while a coalesced call is pending
+        QObject sender;
+        QObject receiver;
+        QStringList received;
+        QMetaObject::Connection c = connect(&sender, &QObject::objectNameChanged, &receiver,
+                                            [&](const QString &name) { received << name; }, type);
+        sender.setObjectName("a");
+        QVERIFY(QObject::disconnect(c));
+        sender.setObjectName("b");
+        QCoreApplication::processEvents();
+        QVERIFY(!received.contains("b"));
+    }
+}
+
 // Test for QtPrivate::HasQ_OBJECT_Macro
 static_assert(QtPrivate::HasQ_OBJECT_Macro<tst_QObject>::Value);
 static_assert(!QtPrivate::HasQ_OBJECT_Macro<SiblingDeleter>::Value);
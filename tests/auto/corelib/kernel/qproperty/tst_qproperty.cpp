@@ -93,6 +93,7 @@ private slots:
 
     void bindablePropertyWithInitialization();
     void markDirty();
+    void propertyUpdateGroup();
 };
 
 void tst_QProperty::functorBinding()
@@ -1594,6 +1595,80 @@ void tst_QProperty::markDirty()
     }
 }
 
+void tst_QProperty::propertyUpdateGroup()
+{
+    QProperty<int> a(1);
+    QProperty<int> b(2);
+    int leftEvaluations = 0;
+    int rightEvaluations = 0;
+    int resultEvaluations = 0;
+    QProperty<int> left([&]() { ++leftEvaluations; return a + b; });
+    QProperty<int> right([&]() { ++rightEvaluations; return a * b; });
+    QProperty<int> result([&]() { ++resultEvaluations; return left + right; });
+    int resultChanges = 0;
+    int aChanges = 0;
+    auto resultHandler = result.onValueChanged([&]() { ++resultChanges; });
+    auto aHandler = a.onValueChanged([&]() { ++aChanges; });
+    QCOMPARE(result.value(), 5);
+    leftEvaluations = rightEvaluations = resultEvaluations = 0;
+
+    {
+        QScopedPropertyUpdateGroup group;
+        a = 3;
+        a = 4;
+        b = 5;
+        QCOMPARE(aChanges, 0);
+        QCOMPARE(resultChanges, 0);
+        QCOMPARE(resultEvaluations, 0);
+        QCOMPARE(a.value(), 4);
+    }
+    QCOMPARE(aChanges, 1);
+    QCOMPARE(resultChanges, 1);
+    QCOMPARE(result.value(), 29);
+    QCOMPARE(leftEvaluations, 1);
+    QCOMPARE(rightEvaluations, 1);
+    QCOMPARE(resultEvaluations, 1);
+
+    // reading inside the group evaluates lazily, the handler still fires once
+    Qt::beginPropertyUpdateGroup();
+    Qt::beginPropertyUpdateGroup();
+    a = 1;
+    QCOMPARE(result.value(), 11);
+    b = 2;
+    Qt::endPropertyUpdateGroup();
+    QCOMPARE(resultChanges, 1);
+    Qt::endPropertyUpdateGroup();
+    QCOMPARE(resultChanges, 2);
+    QCOMPARE(aChanges, 2);
+    QCOMPARE(result.value(), 5);
+
+    // writes that end up not changing a dependent do not notify it
+    {
+        QScopedPropertyUpdateGroup group;
+        a = 2;
+        b = 1;
+    }
+    QCOMPARE(aChanges, 3);
+    QCOMPARE(resultChanges, 2);
+
+    MyQObject object;
+    QObject::connect(&object, &MyQObject::fooChanged, &object, &MyQObject::fooHasChanged);
+    QObject::connect(&object, &MyQObject::barChanged, &object, &MyQObject::barHasChanged);
+    object.bindableBar().setBinding([&]() { return object.foo() * 2; });
+    QCOMPARE(object.bar(), 0);
+    object.fooChangedCount = object.barChangedCount = 0;
+    {
+        QScopedPropertyUpdateGroup group;
+        object.setFoo(1);
+        object.setFoo(2);
+        QCOMPARE(object.fooChangedCount, 0);
+        QCOMPARE(object.barChangedCount, 0);
+    }
+    QCOMPARE(object.fooChangedCount, 1);
+    QCOMPARE(object.barChangedCount, 1);
+    QCOMPARE(object.bar(), 4);
+}
+
 QTEST_MAIN(tst_QProperty);
 
 #include "tst_qproperty.moc"
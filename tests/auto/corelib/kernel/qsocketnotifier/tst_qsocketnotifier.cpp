@@ -39,6 +39,10 @@
 #include <private/qnativesocketengine_p.h>
 #define NATIVESOCKETENGINE QNativeSocketEngine
 #ifdef Q_OS_UNIX
+#include <QtCore/QAbstractEventDispatcher>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QThread>
+#include <private/qeventdispatcher_unix_p.h>
 #include <private/qnet_unix_p.h>
 #include <sys/select.h>
 #endif
@@ -59,6 +63,9 @@ private slots:
     void mixingWithTimers();
 #ifdef Q_OS_UNIX
     void posixSockets();
+#endif
+#if defined(Q_OS_UNIX) && QT_CONFIG(epoll)
+    void epollClosedDescriptor();
 #endif
     void asyncMultipleDatagram();
     void activationReason_data();
@@ -362,6 +369,52 @@ void tst_QSocketNotifier::posixSockets()
 }
 #endif
 
+#if defined(Q_OS_UNIX) && QT_CONFIG(epoll)
+void tst_QSocketNotifier::epollClosedDescriptor()
+{
+    // A descriptor closed before its notifier goes away stays registered
+    // with epoll as long as a duplicate keeps the file open; the dispatcher
+    // must neither deliver it nor keep waking up for it.
+    int pipes[2];
+    QCOMPARE(::pipe(pipes), 0);
+    const int duplicate = ::dup(pipes[0]);
+    QVERIFY(duplicate != -1);
+    QCOMPARE(qt_safe_write(pipes[1], "x", 1), qint64(1));
+
+    int activations = 0;
+    int wakeups = 0;
+    QScopedPointer<QThread> thread(QThread::create([&] {
+        QAbstractEventDispatcher *dispatcher = QThread::currentThread()->eventDispatcher();
+        {
+            QSocketNotifier notifier(pipes[0], QSocketNotifier::Read);
+            connect(&notifier, &QSocketNotifier::activated, [&] { ++activations; });
+            dispatcher->processEvents(QEventLoop::AllEvents);
+            ::close(pipes[0]);
+        }
+
+        QTimer timer;
+        timer.start(50);
+        QElapsedTimer elapsed;
+        elapsed.start();
+        while (elapsed.elapsed() < 250) {
+            dispatcher->processEvents(QEventLoop::WaitForMoreEvents);
+            ++wakeups;
+        }
+    }));
+    qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+    thread->setEventDispatcher(new QEventDispatcherUNIX);
+    qunsetenv("QT_EVENT_DISPATCHER_EPOLL");
+    thread->start();
+    QVERIFY(thread->wait());
+
+    QCOMPARE(activations, 1);
+    QVERIFY2(wakeups < 20, QByteArray::number(wakeups));
+
+    qt_safe_close(duplicate);
+    qt_safe_close(pipes[1]);
+}
+#endif
+
 void tst_QSocketNotifier::async_readDatagramSlot()
 {
     char buf[1];
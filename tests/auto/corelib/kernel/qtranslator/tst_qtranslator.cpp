@@ -51,6 +51,7 @@ private slots:
 
     void load_data();
     void load();
+    void cachedTranslations();
     void loadLocale();
     void threadLoad();
     void testLanguageChange();
@@ -432,5 +433,81 @@ void tst_QTranslator::translationInThreadWhileInstallingTranslator()
     QVERIFY(thread.ok);
 }
 
+class CountingTranslator : public QTranslator
+{
+    Q_OBJECT
+public:
+    QString translate(const char *, const char *, const char *, int) const override
+    {
+        return QString::number(++calls);
+    }
+    mutable int calls = 0;
+};
+
+// same, without Q_OBJECT
+class PlainCountingTranslator : public QTranslator
+{
+public:
+    QString translate(const char *, const char *, const char *, int) const override
+    {
+        return QString::number(++calls);
+    }
+    mutable int calls = 0;
+};
+
+void tst_QTranslator::cachedTranslations()
+{
+    QTranslator tor;
+    QVERIFY(tor.load("hellotr_la"));
+    QTranslator other;
+    QVERIFY(other.load("hellotr_empty"));
+    QCoreApplication::installTranslator(&tor);
+    QCoreApplication::installTranslator(&other);
+
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"), QLatin1String("Hallo Welt!"));
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"), QLatin1String("Hallo Welt!"));
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello %n world(s)!", 0, 1), QLatin1String("Hallo 1 Welt!"));
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello %n world(s)!", 0, 2), QLatin1String("Hallo 2 Welten!"));
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!", "other"), QLatin1String("Hallo Welt!"));
+    QCOMPARE(QCoreApplication::translate("QLabel", "Hello world!"), QLatin1String("Hello world!"));
+
+    // loading another file into an installed translator replaces the results
+    QVERIFY(tor.load("hellotr_empty"));
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"), QLatin1String("Hello world!"));
+    QVERIFY(tor.load("hellotr_la"));
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"), QLatin1String("Hallo Welt!"));
+
+    // so does removing it
+    QCoreApplication::removeTranslator(&tor);
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"), QLatin1String("Hello world!"));
+
+    // reimplementations of translate() are asked every time
+    CountingTranslator counting;
+    QCoreApplication::installTranslator(&counting);
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"), QLatin1String("1"));
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"), QLatin1String("2"));
+    QCoreApplication::removeTranslator(&counting);
+
+    PlainCountingTranslator plainCounting;
+    QVERIFY(plainCounting.load("hellotr_la"));
+    QCoreApplication::installTranslator(&plainCounting);
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"), QLatin1String("1"));
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"), QLatin1String("2"));
+    QCoreApplication::removeTranslator(&plainCounting);
+
+    // %Ln follows the default locale, also for cached translations
+    const QLocale defaultLocale;
+    QLocale::setDefault(QLocale(QLocale::English, QLocale::UnitedStates));
+    QCOMPARE(QCoreApplication::translate("QLabel", "%Ln world(s)", 0, 12345), QLatin1String("12,345 world(s)"));
+    QLocale::setDefault(QLocale(QLocale::German, QLocale::Germany));
+    QCOMPARE(QCoreApplication::translate("QLabel", "%Ln world(s)", 0, 12345), QLatin1String("12.345 world(s)"));
+    QLocale::setDefault(defaultLocale);
+    QCoreApplication::removeTranslator(&other);
+
+    // don't let the events posted by load() leak into testLanguageChange()
+    QCoreApplication::sendPostedEvents();
+    languageChangeEventCounter = 0;
+}
+
 QTEST_MAIN(tst_QTranslator)
 #include "tst_qtranslator.moc"
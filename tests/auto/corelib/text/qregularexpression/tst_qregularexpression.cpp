@@ -35,6 +35,7 @@
 
 #include <qobject.h>
 #include <qregularexpression.h>
+#include <qrandom.h>
 #include <qthread.h>
 
 Q_DECLARE_METATYPE(QRegularExpression::PatternOptions)
@@ -80,8 +81,15 @@ private slots:
     void JOptionUsage_data();
     void JOptionUsage();
     void QStringAndQStringViewEquivalence();
+    void matchUtf8();
     void threadSafety_data();
     void threadSafety();
+    void sharedCompiledPattern();
+
+    void regularExpressionSet();
+    void regularExpressionSetMatch_data();
+    void regularExpressionSetMatch();
+    void regularExpressionSetFilter();
 
     void wildcard_data();
     void wildcard();
@@ -243,6 +251,10 @@ void consistencyCheck(const QRegularExpressionMatch &match)
                 qsizetype length = match.capturedLength(i);
                 QString captured = match.captured(i);
                 QStringView capturedView = match.capturedView(i);
+                QUtf8StringView capturedUtf8View = match.capturedUtf8View(i);
+
+                // at most one of the views is set, depending on the subject's encoding
+                QVERIFY(capturedView.isNull() || capturedUtf8View.isNull());
 
                 if (!captured.isNull()) {
                     QVERIFY(startPos >= 0);
@@ -250,12 +262,18 @@ void consistencyCheck(const QRegularExpressionMatch &match)
                     QVERIFY(length >= 0);
                     QVERIFY(endPos >= startPos);
                     QVERIFY((endPos - startPos) == length);
-                    QVERIFY(captured == capturedView);
+                    if (capturedUtf8View.isNull()) {
+                        QVERIFY(captured == capturedView);
+                    } else {
+                        QVERIFY(captured == capturedUtf8View.toString());
+                        QVERIFY(capturedUtf8View.size() == length);
+                    }
                 } else {
                     QVERIFY(startPos == -1);
                     QVERIFY(endPos == -1);
                     QVERIFY((endPos - startPos) == length);
                     QVERIFY(capturedView.isNull());
+                    QVERIFY(capturedUtf8View.isNull());
                 }
             }
         }
@@ -357,10 +375,34 @@ static void testMatchImpl(const QRegularExpression &regexp,
     }
 }
 
-template<typename QREMatch, typename QREMatchFuncForString, typename QREMatchFuncForStringRef, typename Result>
+// Converts an offset in UTF-16 code units into the equivalent offset in
+// UTF-8 code units. Offsets out of bounds stay out of bounds by the same
+// amount. Returns false if the offset falls inside a surrogate pair.
+static bool utf8OffsetFor(const QString &subject, qsizetype offset, qsizetype *utf8Offset)
+{
+    const qsizetype length = subject.size();
+    const qsizetype utf8Length = subject.toUtf8().size();
+    if (offset > length) {
+        *utf8Offset = utf8Length + (offset - length);
+        return true;
+    }
+    if (offset < -length) {
+        *utf8Offset = -utf8Length + (offset + length);
+        return true;
+    }
+    const qsizetype pos = offset < 0 ? length + offset : offset;
+    if (pos > 0 && pos < length && subject.at(pos).isLowSurrogate())
+        return false;
+    const qsizetype utf8Pos = subject.left(pos).toUtf8().size();
+    *utf8Offset = offset < 0 ? utf8Pos - utf8Length : utf8Pos;
+    return true;
+}
+
+template<typename QREMatch, typename QREMatchFuncForString, typename QREMatchFuncForStringRef, typename QREMatchFuncForUtf8, typename Result>
 static void testMatch(const QRegularExpression &regexp,
                       QREMatchFuncForString matchingMethodForString,
                       QREMatchFuncForStringRef matchingMethodForStringRef,
+                      QREMatchFuncForUtf8 matchingMethodForUtf8,
                       const QString &subject,
                       qsizetype offset,
                       QRegularExpression::MatchType matchType,
@@ -378,12 +420,30 @@ static void testMatch(const QRegularExpression &regexp,
                             matchType,
                             matchOptions,
                             result);
+    if (QTest::currentTestFailed())
+        return;
+
+    // test with UTF-8 data as subject type, if the subject can be
+    // represented in UTF-8 without loss
+    const QByteArray utf8Subject = subject.toUtf8();
+    qsizetype utf8Offset;
+    if (QString::fromUtf8(utf8Subject) != subject || !utf8OffsetFor(subject, offset, &utf8Offset))
+        return;
+    testMatchImpl<QREMatch>(regexp,
+                            matchingMethodForUtf8,
+                            QUtf8StringView(utf8Subject),
+                            utf8Offset,
+                            matchType,
+                            matchOptions,
+                            result);
 }
 
 typedef QRegularExpressionMatch (QRegularExpression::*QREMatchStringPMF)(const QString &, qsizetype, QRegularExpression::MatchType, QRegularExpression::MatchOptions) const;
 typedef QRegularExpressionMatch (QRegularExpression::*QREMatchStringViewPMF)(QStringView, qsizetype, QRegularExpression::MatchType, QRegularExpression::MatchOptions) const;
 typedef QRegularExpressionMatchIterator (QRegularExpression::*QREGlobalMatchStringPMF)(const QString &, qsizetype, QRegularExpression::MatchType, QRegularExpression::MatchOptions) const;
 typedef QRegularExpressionMatchIterator (QRegularExpression::*QREGlobalMatchStringViewPMF)(QStringView, qsizetype, QRegularExpression::MatchType, QRegularExpression::MatchOptions) const;
+typedef QRegularExpressionMatch (QRegularExpression::*QREMatchUtf8StringViewPMF)(QUtf8StringView, qsizetype, QRegularExpression::MatchType, QRegularExpression::MatchOptions) const;
+typedef QRegularExpressionMatchIterator (QRegularExpression::*QREGlobalMatchUtf8StringViewPMF)(QUtf8StringView, qsizetype, QRegularExpression::MatchType, QRegularExpression::MatchOptions) const;
 
 void tst_QRegularExpression::provideRegularExpressions()
 {
@@ -1001,6 +1061,7 @@ void tst_QRegularExpression::normalMatch()
     testMatch<QRegularExpressionMatch>(regexp,
                                        static_cast<QREMatchStringPMF>(&QRegularExpression::match),
                                        static_cast<QREMatchStringViewPMF>(&QRegularExpression::match),
+                                       static_cast<QREMatchUtf8StringViewPMF>(&QRegularExpression::match),
                                        subject,
                                        offset,
                                        QRegularExpression::NormalMatch,
@@ -1273,6 +1334,7 @@ void tst_QRegularExpression::partialMatch()
     testMatch<QRegularExpressionMatch>(regexp,
                                        static_cast<QREMatchStringPMF>(&QRegularExpression::match),
                                        static_cast<QREMatchStringViewPMF>(&QRegularExpression::match),
+                                       static_cast<QREMatchUtf8StringViewPMF>(&QRegularExpression::match),
                                        subject,
                                        offset,
                                        matchType,
@@ -1550,6 +1612,7 @@ void tst_QRegularExpression::globalMatch()
     testMatch<QRegularExpressionMatchIterator>(regexp,
                                                static_cast<QREGlobalMatchStringPMF>(&QRegularExpression::globalMatch),
                                                static_cast<QREGlobalMatchStringViewPMF>(&QRegularExpression::globalMatch),
+                                               static_cast<QREGlobalMatchUtf8StringViewPMF>(&QRegularExpression::globalMatch),
                                                subject,
                                                offset,
                                                matchType,
@@ -2230,6 +2293,113 @@ void tst_QRegularExpression::QStringAndQStringViewEquivalence()
     }
 }
 
+void tst_QRegularExpression::matchUtf8()
+{
+    // "Grüße, 世界 😀!" -- 1, 2, 3 and 4 bytes long characters
+    const QByteArray subject = QByteArrayLiteral("Gr\xc3\xbc\xc3\x9f" "e, \xe4\xb8\x96\xe7\x95\x8c \xf0\x9f\x98\x80!");
+
+    {
+        // offsets are in bytes, captures point into the subject
+        const QRegularExpression re(QStringLiteral("(?<word>\\w+), (\\S+) (.)"),
+                                    QRegularExpression::UseUnicodePropertiesOption);
+        const QRegularExpressionMatch match = re.match(QUtf8StringView(subject));
+        consistencyCheck(match);
+        QVERIFY(match.hasMatch());
+        QCOMPARE(match.captured(), QString::fromUtf8(subject.chopped(1)));
+        QCOMPARE(match.captured(u"word"), QStringLiteral("Grüße"));
+        QCOMPARE(match.capturedStart(2), 9);
+        QCOMPARE(match.capturedEnd(2), 15);
+        QCOMPARE(match.capturedStart(3), 16);
+        QCOMPARE(match.capturedLength(3), 4);
+        QCOMPARE(match.capturedUtf8View(u"word").data(), subject.constData());
+        QCOMPARE(match.capturedUtf8View(3).data(), subject.constData() + 16);
+        QVERIFY(match.capturedView(3).isNull());
+
+        // QByteArrayView selects the same overload
+        const QRegularExpression re2(QStringLiteral("(\\S+) "));
+        const QRegularExpressionMatch match2 = re2.match(QByteArrayView(subject), 9);
+        consistencyCheck(match2);
+        QVERIFY(match2.hasMatch());
+        QCOMPARE(match2.capturedStart(), 9);
+        QCOMPARE(match2.capturedUtf8View(1), QUtf8StringView("\xe4\xb8\x96\xe7\x95\x8c"));
+    }
+
+    {
+        // string literals and QByteArray still convert to QString
+        const QRegularExpression re(QStringLiteral("\\d+"));
+        const QRegularExpressionMatch literalMatch = re.match("abc 42");
+        QVERIFY(literalMatch.hasMatch());
+        QCOMPARE(literalMatch.capturedView(), u"42");
+        QVERIFY(literalMatch.capturedUtf8View().isNull());
+        const QRegularExpressionMatch byteArrayMatch = re.match(QByteArray("abc 42"));
+        QVERIFY(byteArrayMatch.hasMatch());
+        QCOMPARE(byteArrayMatch.capturedView(), u"42");
+        QVERIFY(byteArrayMatch.capturedUtf8View().isNull());
+    }
+
+    {
+        // empty matches never stop in the middle of a character or of a CRLF
+        const QRegularExpression re(QStringLiteral("(?m)$|\\b"));
+        QRegularExpressionMatchIterator it = re.globalMatch(QUtf8StringView(subject));
+        consistencyCheck(it);
+        QList<qsizetype> starts;
+        while (it.hasNext())
+            starts << it.next().capturedStart();
+        QRegularExpressionMatchIterator it16 = re.globalMatch(QString::fromUtf8(subject));
+        QList<qsizetype> starts16;
+        while (it16.hasNext())
+            starts16 << it16.next().capturedStart();
+        QCOMPARE(starts.size(), starts16.size());
+        for (qsizetype i = 0; i < starts.size(); ++i)
+            QCOMPARE(QString::fromUtf8(subject.left(starts.at(i))).size(), starts16.at(i));
+
+        const QRegularExpression anyEmpty(QStringLiteral("(*CRLF)(?m)$"));
+        const QByteArray crlf = QByteArrayLiteral("a\r\n\xc3\xa9\r\n");
+        QRegularExpressionMatchIterator crlfIt = anyEmpty.globalMatch(QUtf8StringView(crlf));
+        consistencyCheck(crlfIt);
+        starts.clear();
+        while (crlfIt.hasNext())
+            starts << crlfIt.next().capturedStart();
+        QCOMPARE(starts, QList<qsizetype>({ 1, 5, 7 }));
+    }
+
+    {
+        // partial matches include the lookbehind, in whole characters
+        const QRegularExpression re(QStringLiteral("(?<=\\x{1F600})abc"));
+        const QRegularExpressionMatch match = re.match(QUtf8StringView("x\xf0\x9f\x98\x80" "ab"), 0,
+                                                       QRegularExpression::PartialPreferFirstMatch);
+        consistencyCheck(match);
+        QVERIFY(match.hasPartialMatch());
+        QCOMPARE(match.capturedStart(), 1);
+        QCOMPARE(match.captured(), QStringLiteral("\U0001F600ab"));
+    }
+
+    {
+        // invalid UTF-8 is rejected, unless the check is disabled
+        const QRegularExpression re(QStringLiteral("b"));
+        const QRegularExpressionMatch match = re.match(QUtf8StringView("a\xff" "b"));
+        consistencyCheck(match);
+        QVERIFY(!match.isValid());
+        QVERIFY(!match.hasMatch());
+
+        const QRegularExpressionMatch unchecked = re.match(QUtf8StringView("a\xc3\xa9" "b"), 0,
+                                                           QRegularExpression::NormalMatch,
+                                                           QRegularExpression::DontCheckSubjectStringMatchOption);
+        consistencyCheck(unchecked);
+        QVERIFY(unchecked.hasMatch());
+        QCOMPARE(unchecked.capturedStart(), 3);
+    }
+
+    {
+        // null and empty subjects
+        const QRegularExpression re(QStringLiteral("^$"));
+        QVERIFY(re.match(QUtf8StringView()).hasMatch());
+        QVERIFY(re.match(QByteArrayView("")).hasMatch());
+        QTest::ignoreMessage(QtWarningMsg, "QRegularExpressionPrivate::doMatch(): called on an invalid QRegularExpression object");
+        QVERIFY(!QRegularExpression(QStringLiteral("(")).match(QUtf8StringView("a")).isValid());
+    }
+}
+
 class MatcherThread : public QThread
 {
 public:
@@ -2317,6 +2487,261 @@ void tst_QRegularExpression::threadSafety()
     }
 }
 
+void tst_QRegularExpression::sharedCompiledPattern()
+{
+    const QString subject = QStringLiteral("Hello World");
+
+    // only identical patterns with identical options share the compiled code
+    {
+        QRegularExpression re1("world");
+        QRegularExpression re2("world", QRegularExpression::CaseInsensitiveOption);
+        QRegularExpression re3("world");
+        QVERIFY(!re1.match(subject).hasMatch());
+        QVERIFY(re2.match(subject).hasMatch());
+        QVERIFY(!re3.match(subject).hasMatch());
+
+        re3.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+        QVERIFY(re3.match(subject).hasMatch());
+        QVERIFY(!re1.match(subject).hasMatch());
+    }
+
+    // the compiled code outlives the objects that used it
+    for (int i = 0; i < 10; ++i) {
+        QRegularExpression re("(?<word>w\\w+)", QRegularExpression::CaseInsensitiveOption);
+        const QRegularExpressionMatch match = re.match(subject);
+        QVERIFY(match.hasMatch());
+        QCOMPARE(match.captured("word"), QStringLiteral("World"));
+        QCOMPARE(re.captureCount(), 1);
+    }
+
+    // errors are reported every time
+    for (int i = 0; i < 2; ++i) {
+        QRegularExpression re("a(b");
+        QVERIFY(!re.isValid());
+        QCOMPARE(re.patternErrorOffset(), 3);
+        QVERIFY(!re.errorString().isEmpty());
+    }
+
+    // many threads compiling and matching the same patterns at the same time
+    const int threadCount = qMax(QThread::idealThreadCount(), 4);
+    QAtomicInt failures;
+    QList<QThread *> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.append(QThread::create([&failures, t] {
+            const QString subject = QStringLiteral("key%1=value%1").arg(t % 3);
+            for (int i = 0; i < 200; ++i) {
+                QRegularExpression re(QStringLiteral("(\\w+)%1=(\\w+)").arg(i % 3));
+                const QRegularExpressionMatch match = re.match(subject);
+                if (match.hasMatch() != (i % 3 == t % 3)
+                        || (match.hasMatch() && match.captured(2) != QStringLiteral("value%1").arg(i % 3))) {
+                    failures.ref();
+                }
+            }
+        }));
+        threads.last()->start();
+    }
+    for (QThread *thread : qAsConst(threads))
+        QVERIFY(thread->wait());
+    qDeleteAll(threads);
+    QCOMPARE(failures.loadRelaxed(), 0);
+}
+
+void tst_QRegularExpression::regularExpressionSet()
+{
+    QRegularExpressionSet empty;
+    QCOMPARE(empty.size(), 0);
+    QVERIFY(empty.patterns().isEmpty());
+    QCOMPARE(empty.patternOptions(), QRegularExpression::NoPatternOption);
+    QVERIFY(empty.isValid());
+    QVERIFY(empty.matchingIndexes(u"abc").isEmpty());
+    QVERIFY(!empty.hasMatch(u"abc"));
+
+    const QStringList patterns = { "a+", "b(", "c" };
+    QRegularExpressionSet set(patterns);
+    QCOMPARE(set.size(), 3);
+    QCOMPARE(set.patterns(), patterns);
+    QVERIFY(!set.isValid());
+    QCOMPARE(set.regularExpression(0), QRegularExpression("a+"));
+    QVERIFY(!set.regularExpression(1).isValid());
+    QCOMPARE(set.matchingIndexes(u"xaxc"), QList<qsizetype>({ 0, 2 }));
+    QVERIFY(set.hasMatch(u"xc"));
+    QVERIFY(!set.hasMatch(u"xyz"));
+
+    // copies are independent
+    QRegularExpressionSet copy = set;
+    copy.setPatterns({ "x", "a" });
+    QVERIFY(copy.isValid());
+    QCOMPARE(copy.matchingIndexes(u"xaxc"), QList<qsizetype>({ 0, 1 }));
+    QCOMPARE(set.matchingIndexes(u"xaxc"), QList<qsizetype>({ 0, 2 }));
+
+    copy.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+    QCOMPARE(copy.patternOptions(), QRegularExpression::CaseInsensitiveOption);
+    QCOMPARE(copy.regularExpression(1).patternOptions(), QRegularExpression::CaseInsensitiveOption);
+    QCOMPARE(copy.matchingIndexes(u"XA"), QList<qsizetype>({ 0, 1 }));
+
+    QRegularExpressionSet moved = std::move(copy);
+    QCOMPARE(moved.size(), 2);
+    copy = set;
+    QCOMPARE(copy.patterns(), patterns);
+    set.swap(moved);
+    QCOMPARE(set.size(), 2);
+    QCOMPARE(moved.size(), 3);
+
+    // the regular expressions of the set can be used normally
+    QRegularExpression re = set.regularExpression(1);
+    QCOMPARE(re.match(u"xA").capturedStart(), 1);
+    re.setPattern("b");
+    QCOMPARE(set.regularExpression(1).pattern(), QStringLiteral("a"));
+}
+
+void tst_QRegularExpression::regularExpressionSetMatch_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<QRegularExpression::PatternOptions>("patternOptions");
+    QTest::addColumn<QRegularExpression::MatchOptions>("matchOptions");
+    QTest::addColumn<QString>("subject");
+    QTest::addColumn<QList<qsizetype>>("expected");
+
+    const QRegularExpression::PatternOptions noOptions;
+    const QRegularExpression::MatchOptions noMatchOptions;
+    const QStringList logPatterns = { "\\berror\\b", "\\bwarning\\b", "disk \\S+ full",
+                                      "^\\d{4}-\\d\\d-\\d\\d", "timeout|timed out" };
+
+    QTest::newRow("log-error") << logPatterns << noOptions << noMatchOptions
+                               << "2021-03-04 error: disk /var full" << QList<qsizetype>({ 0, 2, 3 });
+    QTest::newRow("log-none") << logPatterns << noOptions << noMatchOptions
+                              << "ERROR: connection TIMED OUT" << QList<qsizetype>();
+    QTest::newRow("log-caseless") << logPatterns << QRegularExpression::PatternOptions(QRegularExpression::CaseInsensitiveOption)
+                                  << noMatchOptions
+                                  << "ERROR: connection TIMED OUT" << QList<qsizetype>({ 0, 4 });
+    QTest::newRow("log-anchored") << logPatterns << noOptions
+                                  << QRegularExpression::MatchOptions(QRegularExpression::AnchorAtOffsetMatchOption)
+                                  << "disk / full, error" << QList<qsizetype>({ 2 });
+    QTest::newRow("empty-subject") << logPatterns + QStringList{ "", "x*" } << noOptions << noMatchOptions
+                                   << "" << QList<qsizetype>({ 5, 6 });
+    QTest::newRow("too-short") << QStringList{ "abcd", "a.c", "\\w{3}" } << noOptions << noMatchOptions
+                               << "abc" << QList<qsizetype>({ 1, 2 });
+    QTest::newRow("invalid") << QStringList{ "(", "a", "[" } << noOptions << noMatchOptions
+                             << "a" << QList<qsizetype>({ 1 });
+
+    // the first and last code units have to be matched in any case when
+    // the pattern says so
+    const QStringList caseless = { "(?i)kelvin", "(?i)k", "(?i)ı", "(?i)ſ", "(?i)xσ", "(?i)[a-c]z",
+                                   "(?i)straße", "(?i:\u00e9t\u00e9)" };
+    QTest::newRow("caseless-ascii") << caseless << noOptions << noMatchOptions
+                                    << "KELVIN" << QList<qsizetype>({ 0, 1 });
+    QTest::newRow("caseless-kelvin") << caseless << noOptions << noMatchOptions
+                                     << "\u212a" << QList<qsizetype>({ 1 });
+    QTest::newRow("caseless-dotless-i") << caseless << noOptions << noMatchOptions
+                                        << "I" << QList<qsizetype>();
+    QTest::newRow("caseless-long-s") << caseless << noOptions << noMatchOptions
+                                     << "S" << QList<qsizetype>({ 3 });
+    QTest::newRow("caseless-sigma") << caseless << noOptions << noMatchOptions
+                                    << "X\u03a3 x\u03c2" << QList<qsizetype>({ 4 });
+    QTest::newRow("caseless-bitmap") << caseless << noOptions << noMatchOptions
+                                     << "BZ" << QList<qsizetype>({ 5 });
+    QTest::newRow("caseless-sharp-s") << caseless << noOptions << noMatchOptions
+                                      << "STRASSE STRA\u1e9eE" << QList<qsizetype>({ 3, 6 });
+    QTest::newRow("caseless-latin1") << caseless << noOptions << noMatchOptions
+                                     << "\u00c9T\u00c9" << QList<qsizetype>({ 7 });
+
+    const QStringList nonLatin1 = { "\u4e16\u754c", "[\u4e16\u4e17]", "\U0001F600", "\\x{1F600}+x", "\u0100|\u0101" };
+    QTest::newRow("cjk") << nonLatin1 << noOptions << noMatchOptions
+                         << "hello \u4e16\u754c" << QList<qsizetype>({ 0, 1 });
+    QTest::newRow("surrogates") << nonLatin1 << noOptions << noMatchOptions
+                                << "\U0001F600\U0001F600x" << QList<qsizetype>({ 2, 3 });
+    QTest::newRow("collision") << nonLatin1 << noOptions << noMatchOptions
+                               << "L\u0116 \u0600\u00ff\u0101" << QList<qsizetype>({ 4 });
+    QTest::newRow("invalid-utf16") << nonLatin1 << noOptions << noMatchOptions
+                                   << QString(QChar(0xd83d)) + "\u4e16\u754c" << QList<qsizetype>();
+
+    const QStringList multiline = { "^b", "a$", "^$" };
+    QTest::newRow("multiline") << multiline << QRegularExpression::PatternOptions(QRegularExpression::MultilineOption)
+                               << noMatchOptions << "a\n\nb" << QList<qsizetype>({ 0, 1, 2 });
+    QTest::newRow("singleline") << multiline << noOptions << noMatchOptions
+                                << "a\n\nb" << QList<qsizetype>();
+}
+
+void tst_QRegularExpression::regularExpressionSetMatch()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(QRegularExpression::PatternOptions, patternOptions);
+    QFETCH(QRegularExpression::MatchOptions, matchOptions);
+    QFETCH(QString, subject);
+    QFETCH(QList<qsizetype>, expected);
+
+    // the set must agree with the individual regular expressions
+    QList<qsizetype> matched;
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        QRegularExpression re(patterns.at(i), patternOptions);
+        if (re.isValid() && re.match(subject, 0, QRegularExpression::NormalMatch, matchOptions).hasMatch())
+            matched.append(i);
+    }
+    QCOMPARE(matched, expected);
+
+    const QRegularExpressionSet set(patterns, patternOptions);
+    QCOMPARE(set.matchingIndexes(subject, matchOptions), expected);
+    QCOMPARE(set.hasMatch(subject, matchOptions), !expected.isEmpty());
+}
+
+void tst_QRegularExpression::regularExpressionSetFilter()
+{
+    // Match many patterns whose literals are likely to end up as the first
+    // or the last code unit, or in the starting code units, against strings
+    // made of case variants of the same characters, and check that the
+    // filter never skips a pattern that matches.
+    const QString alphabet = QStringLiteral("aAbBkK\u212asS\u017fiI\u0130\u0131\u00e9\u00c9\u03c3\u03a3\u03c2 -1");
+    const QStringList atoms = { "a", "b", "k", "s", "i", "\u00e9", "\u03c3", "[ab]", "[si]", "\\d", ".", " " };
+    const QStringList quantifiers = { "", "", "", "?", "*", "+" };
+
+    QRandomGenerator rng(1234);
+    auto randomPattern = [&] {
+        QString pattern;
+        if (rng.bounded(3) == 0)
+            pattern += QLatin1String("(?i)");
+        const int length = 1 + rng.bounded(4);
+        for (int i = 0; i < length; ++i) {
+            pattern += atoms.at(rng.bounded(atoms.size()));
+            pattern += quantifiers.at(rng.bounded(quantifiers.size()));
+        }
+        return pattern;
+    };
+    auto randomSubject = [&] {
+        QString subject;
+        const int length = rng.bounded(8);
+        for (int i = 0; i < length; ++i)
+            subject += alphabet.at(rng.bounded(alphabet.size()));
+        return subject;
+    };
+
+    for (int round = 0; round < 20; ++round) {
+        QStringList patterns;
+        for (int i = 0; i < 50; ++i)
+            patterns.append(randomPattern());
+        const QRegularExpressionSet set(patterns);
+        QVERIFY(set.isValid());
+
+        for (int i = 0; i < 200; ++i) {
+            const QString subject = randomSubject();
+            QList<qsizetype> expected;
+            for (qsizetype j = 0; j < patterns.size(); ++j) {
+                if (set.regularExpression(j).match(subject).hasMatch())
+                    expected.append(j);
+            }
+            const QList<qsizetype> matched = set.matchingIndexes(subject);
+            if (matched != expected) {
+                QStringList failing;
+                for (qsizetype j : expected) {
+                    if (!matched.contains(j))
+                        failing.append(patterns.at(j));
+                }
+                QFAIL(qPrintable(QStringLiteral("\"%1\" isn't matched by: %2")
+                                 .arg(subject, failing.join(QLatin1String(", ")))));
+            }
+        }
+    }
+}
+
 void tst_QRegularExpression::wildcard_data()
 {
     QTest::addColumn<QString>("pattern");
@@ -38,7 +38,10 @@
 #endif
 
 #include <private/qglobal_p.h> // for the icu feature test
+#include <private/qsimd_p.h>
+#include <private/qstringconverter_p.h>
 #include <QTest>
+#include <QScopeGuard>
 #include <QString>
 #include <QStringBuilder>
 #include <qregularexpression.h>
@@ -584,6 +587,8 @@ private slots:
     void isValidUtf16_data();
     void isValidUtf16();
     void unicodeStrings();
+    void simdDispatch_data();
+    void simdDispatch();
 };
 
 template <class T> const T &verifyZeroTermination(const T &t) { return t; }
@@ -6864,6 +6869,112 @@ void tst_QString::isValidUtf16()
     QTEST(string.isValidUtf16(), "valid");
 }
 
+void tst_QString::simdDispatch_data()
+{
+    QTest::addColumn<quint64>("disabledFeatures");
+    QTest::addColumn<quint64>("requiredFeatures");
+
+#if defined(Q_PROCESSOR_X86) && defined(Q_ATOMIC_INT64_IS_SUPPORTED)
+    QTest::newRow("sse2") << quint64(CpuFeatureAVX2 | CpuFeatureAVX512BW) << quint64(0);
+    QTest::newRow("avx2") << quint64(CpuFeatureAVX512BW) << quint64(CpuFeatureArchHaswell);
+    QTest::newRow("avx512") << quint64(0) << quint64(CpuFeatureArchSkylakeAvx512);
+#else
+    QTest::newRow("default") << quint64(0) << quint64(0);
+#endif
+}
+
+// Runs the string kernels at every supported ISA level over all the lengths
+// and positions that exercise their loops and their tail handling
+void tst_QString::simdDispatch()
+{
+    QFETCH(quint64, disabledFeatures);
+    QFETCH(quint64, requiredFeatures);
+
+#ifdef Q_ATOMIC_INT64_IS_SUPPORTED
+    if ((qCpuFeatures() & requiredFeatures) != requiredFeatures)
+        QSKIP("This processor does not support the features for this test row");
+    if (qCompilerCpuFeatures & disabledFeatures)
+        QSKIP("Qt was compiled for a higher sub-architecture than this test row");
+
+    const quint64 savedFeatures = qt_cpu_features[0].loadRelaxed();
+    qt_cpu_features[0].storeRelaxed(savedFeatures & ~disabledFeatures);
+    auto restoreFeatures = qScopeGuard([=] { qt_cpu_features[0].storeRelaxed(savedFeatures); });
+#else
+    Q_UNUSED(disabledFeatures);
+    Q_UNUSED(requiredFeatures);
+#endif
+
+    constexpr int MaxLength = 100;
+    QString base;
+    for (int i = 0; i <= MaxLength; ++i)
+        base += QLatin1Char('a' + i % 26);
+    const QString upperBase = base.toUpper();
+
+    // start at offset 1 too, so the data is not aligned
+    for (int start = 0; start < 2; ++start) {
+        for (int len = 0; len <= MaxLength - start; ++len) {
+            const QString s = base.mid(start, len);
+            const QString upper = upperBase.mid(start, len);
+            const QByteArray latin1 = s.toLatin1();
+            const QByteArray upperLatin1 = upper.toLatin1();
+
+            QCOMPARE(QtPrivate::compareStrings(s, QString(s)), 0);
+            QCOMPARE(QtPrivate::compareStrings(s, QLatin1String(latin1)), 0);
+            QCOMPARE(QtPrivate::compareStrings(s, upper, Qt::CaseInsensitive), 0);
+            QCOMPARE(QtPrivate::compareStrings(s, QLatin1String(upperLatin1), Qt::CaseInsensitive), 0);
+            QCOMPARE(s.indexOf(QLatin1Char('{')), -1);
+            QCOMPARE(s.indexOf(QChar()), -1);
+            QCOMPARE(QString::fromLatin1(latin1), s);
+            QCOMPARE(s.toLatin1(), latin1);
+            QVERIFY(QtPrivate::isAscii(s));
+            QVERIFY(QtPrivate::isAscii(QLatin1String(latin1)));
+            QVERIFY(QUtf8::isValidUtf8(latin1).isValidAscii);
+
+            for (int i = 0; i < len; ++i) {
+                QString t = s;
+                t[i] = QLatin1Char('{');    // sorts after any lowercase letter
+                QVERIFY(QtPrivate::compareStrings(s, t) < 0);
+                QVERIFY(QtPrivate::compareStrings(t, s) > 0);
+                QVERIFY(QtPrivate::compareStrings(t, QLatin1String(latin1)) > 0);
+                QVERIFY(QtPrivate::compareStrings(t, upper, Qt::CaseInsensitive) > 0);
+                QVERIFY(QtPrivate::compareStrings(upper, t, Qt::CaseInsensitive) < 0);
+                QVERIFY(QtPrivate::compareStrings(t, QLatin1String(upperLatin1), Qt::CaseInsensitive) > 0);
+                QCOMPARE(t.indexOf(QLatin1Char('{')), i);
+
+                // non-ASCII characters are compared by the generic code
+                t[i] = QChar(0xe9);
+                QString tUpper = upper;
+                tUpper[i] = QChar(0xc9);
+                QCOMPARE(QtPrivate::compareStrings(t, tUpper, Qt::CaseInsensitive), 0);
+                QCOMPARE(QtPrivate::compareStrings(t, QLatin1String(tUpper.toLatin1()), Qt::CaseInsensitive), 0);
+                QVERIFY(!QtPrivate::isAscii(t));
+                QVERIFY(QtPrivate::isLatin1(t));
+                QCOMPARE(QString::fromLatin1(t.toLatin1()), t);
+
+                QByteArray bytes = latin1;
+                bytes[i] = char(0xe9);
+                QVERIFY(!QtPrivate::isAscii(QLatin1String(bytes)));
+                QCOMPARE(QUtf8::isValidUtf8(bytes).isValidUtf8, false);
+                if (i + 1 < len) {
+                    bytes[i] = char(0xc9);
+                    bytes[i + 1] = char(0xa9);      // U+0269
+                    QCOMPARE(QUtf8::isValidUtf8(bytes).isValidUtf8, true);
+                    QCOMPARE(QUtf8::isValidUtf8(bytes).isValidAscii, false);
+                }
+
+                t[i] = QChar(0x100);
+                QVERIFY(!QtPrivate::isLatin1(t));
+                QByteArray expected = latin1;
+                expected[i] = '?';
+                QCOMPARE(t.toLatin1(), expected);
+                QString inPlace = t;
+                inPlace.detach();
+                QCOMPARE(std::move(inPlace).toLatin1(), expected);
+            }
+        }
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QString)
 
 #include "tst_qstring.moc"
@@ -31,6 +31,9 @@
 
 #include <qstringconverter.h>
 #include <qthreadpool.h>
+#include <QScopeGuard>
+
+#include <private/qsimd_p.h>
 
 class tst_QStringConverter : public QObject
 {
@@ -57,6 +60,9 @@ private slots:
     void utf8stateful_data();
     void utf8stateful();
 
+    void utf8Simd_data();
+    void utf8Simd();
+
     void utfHeaders_data();
     void utfHeaders();
 
@@ -1420,6 +1426,103 @@ void tst_QStringConverter::utf8stateful()
     }
 }
 
+void tst_QStringConverter::utf8Simd_data()
+{
+    QTest::addColumn<QString>("text");
+
+    auto makeText = [](std::initializer_list<char32_t> alphabet) {
+        QString text;
+        for (int i = 0; i < 150; ++i)
+            text += QString::fromUcs4(alphabet.begin() + i % alphabet.size(), 1);
+        return text;
+    };
+
+    QTest::newRow("ascii") << makeText({ 'H', 'e', 'l', 'l', 'o', ',', ' ', 'w', 'o', 'r', 'l', 'd', '!', ' ' });
+    QTest::newRow("latin") << makeText({ 'G', 'r', 0xfc, 0xdf, 'e', ' ', 'a', 'u', 's', ' ', 'K', 0xf6, 'l', 'n', ' ' });
+    QTest::newRow("cyrillic") << makeText({ 0x41f, 0x440, 0x438, 0x432, 0x435, 0x442, ' ', 0x43c, 0x438, 0x440, ',', ' ' });
+    QTest::newRow("cjk") << makeText({ 0x4f60, 0x597d, 0xff0c, 0x4e16, 0x754c, 0x3002 });
+    QTest::newRow("emoji") << makeText({ 0x1f600, ' ', 0x1f680, 0x1f44d, 0x1f3fd, ' ', 0x1f1e8, 0x1f1ed, '!' });
+    QTest::newRow("boundaries") << makeText({ 0x7f, 0x80, 0x7ff, 0x800, 0xd7ff, 0xe000, 0xfeff, 0xffff,
+                                              0x10000, 0x10ffff, 0 });
+}
+
+// Checks that the SIMD code in the UTF-8 codec decodes and encodes all
+// kinds of text, and that it treats invalid sequences exactly like the
+// scalar code does
+void tst_QStringConverter::utf8Simd()
+{
+    QFETCH(QString, text);
+    const QByteArray utf8 = text.toUtf8();
+
+    auto decodeInChunks = [](QByteArrayView in, qsizetype chunkSize) {
+        QStringDecoder decoder(QStringDecoder::Utf8, QStringDecoder::Flag::ConvertInitialBom);
+        QString result;
+        for (qsizetype i = 0; i < in.size(); i += chunkSize)
+            result += decoder(in.sliced(i, qMin(chunkSize, in.size() - i)));
+        if (decoder.hasError())
+            result += u"<error>";
+        return result;
+    };
+    auto encodeInChunks = [](QStringView in, qsizetype chunkSize) {
+        QStringEncoder encoder(QStringEncoder::Utf8);
+        QByteArray result;
+        for (qsizetype i = 0; i < in.size(); i += chunkSize)
+            result += encoder(in.sliced(i, qMin(chunkSize, in.size() - i)));
+        if (encoder.hasError())
+            result += "<error>";
+        return result;
+    };
+
+    // runs the conversion once with the SIMD code and once without
+    auto compareToScalar = [](auto convert) {
+        const auto result = convert();
+#if defined(Q_PROCESSOR_X86) && defined(Q_ATOMIC_INT64_IS_SUPPORTED)
+        qCpuFeatures();
+        const quint64 savedFeatures = qt_cpu_features[0].loadRelaxed();
+        auto restoreFeatures = qScopeGuard([=] { qt_cpu_features[0].storeRelaxed(savedFeatures); });
+        qt_cpu_features[0].storeRelaxed(savedFeatures & ~CpuFeatureAVX2);
+        return result == convert();
+#else
+        return true;
+#endif
+    };
+
+    QCOMPARE(QString::fromUtf8(utf8), text);
+    QCOMPARE(QString(text.constData(), text.size()).toUtf8(), utf8);
+    for (qsizetype chunkSize : { 1, 15, 16, 17, 63, 1000 }) {
+        QCOMPARE(decodeInChunks(utf8, chunkSize), text);
+        QCOMPARE(encodeInChunks(text, chunkSize), utf8);
+    }
+
+    static const char *const invalidUtf8[] = {
+        "\x80", "\xbf", "\xc0\x80", "\xc1\xbf", "\xc3", "\xe4\xb8", "\xe0\x80\x80", "\xe0\x9f\xbf",
+        "\xed\xa0\x80", "\xed\xbf\xbf", "\xf0\x9f\x98", "\xf0\x80\x80\x80", "\xf0\x8f\xbf\xbf",
+        "\xf4\x90\x80\x80", "\xf5\x80\x80\x80", "\xff"
+    };
+    for (const char *sequence : invalidUtf8) {
+        for (qsizetype pos = 0; pos < qMin(utf8.size(), 48); ++pos) {
+            QByteArray invalid = utf8;
+            invalid.insert(pos, sequence);
+            QVERIFY2(compareToScalar([&] { return QString::fromUtf8(invalid); }),
+                     invalid.toHex(' ').constData());
+            for (qsizetype chunkSize : { 16, 17, 63 }) {
+                QVERIFY2(compareToScalar([&] { return decodeInChunks(invalid, chunkSize); }),
+                         invalid.toHex(' ').constData());
+            }
+        }
+    }
+
+    for (char16_t surrogate : { 0xd800, 0xdbff, 0xdc00, 0xdfff }) {
+        for (qsizetype pos = 0; pos < qMin(text.size(), 24); ++pos) {
+            QString invalid = text;
+            invalid.insert(pos, QChar(surrogate));
+            QVERIFY(compareToScalar([&] { return invalid.toUtf8(); }));
+            for (qsizetype chunkSize : { 16, 17, 63 })
+                QVERIFY(compareToScalar([&] { return encodeInChunks(invalid, chunkSize); }));
+        }
+    }
+}
+
 void tst_QStringConverter::utfHeaders_data()
 {
     QTest::addColumn<QStringConverter::Encoding>("encoding");
@@ -0,0 +1,350 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QCoreApplication>
+#include <QTest>
+#include <QThread>
+#include <QThreadPool>
+
+#include <qcoroutine.h>
+#include <qfuture.h>
+#include <qpromise.h>
+
+#include <memory>
+#include <optional>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#  define HAS_COROUTINES
+#endif
+
+class tst_QCoroutine : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void awaitFinishedFuture();
+    void awaitFutureFromOtherThread();
+#ifndef QT_NO_EXCEPTIONS
+    void awaitFutureWithException();
+#endif
+    void awaitCanceledFuture();
+    void awaitFutureSeveralTimes();
+    void awaitingThreadFinishesFirst();
+    void awaitSignal();
+    void awaitSignalSenderDestroyed();
+    void threadPoolRoundTrip();
+    void awaitTask();
+    void detachedTask();
+};
+
+class Emitter : public QObject
+{
+    Q_OBJECT
+public:
+    using QObject::isSignalConnected;
+
+signals:
+    void noArgs();
+    void oneArg(int value);
+    void twoArgs(int value, const QString &text);
+};
+
+void tst_QCoroutine::initTestCase()
+{
+#ifndef HAS_COROUTINES
+    QSKIP("This compiler does not support C++20 coroutines");
+#endif
+}
+
+#ifdef HAS_COROUTINES
+
+using QtCoroutine::Task;
+
+template<typename T>
+static Task<T> await(QFuture<T> future)
+{
+    co_return co_await future;
+}
+
+static Task<QThread *> awaitAndReportThread(QFuture<void> future)
+{
+    co_await future;
+    co_return QThread::currentThread();
+}
+
+void tst_QCoroutine::awaitFinishedFuture()
+{
+    // A finished future doesn't suspend, so the task completes eagerly.
+    auto task = await(QtFuture::makeReadyFuture(42));
+    QVERIFY(task.isFinished());
+    QVERIFY(!task.isCanceled());
+    QCOMPARE(task.result(), 42);
+}
+
+void tst_QCoroutine::awaitFutureFromOtherThread()
+{
+    QPromise<void> promise;
+    promise.start();
+    auto task = awaitAndReportThread(promise.future());
+    QVERIFY(!task.isFinished());
+
+    QThread *finisher = QThread::create([&promise] { promise.finish(); });
+    finisher->start();
+    QVERIFY(finisher->wait());
+    delete finisher;
+
+    // The resumption is posted back to the thread that awaited.
+    QVERIFY(!task.isFinished());
+    QTRY_VERIFY(task.isFinished());
+    QCOMPARE(task.result(), QThread::currentThread());
+}
+
+#ifndef QT_NO_EXCEPTIONS
+void tst_QCoroutine::awaitFutureWithException()
+{
+    QPromise<int> promise;
+    promise.start();
+    auto task = await(promise.future());
+    promise.setException(std::make_exception_ptr(std::runtime_error("failed")));
+    promise.finish();
+
+    QTRY_VERIFY(task.isFinished());
+    QVERIFY(!task.isCanceled());
+    QVERIFY_EXCEPTION_THROWN(task.result(), std::runtime_error);
+}
+#endif
+
+void tst_QCoroutine::awaitCanceledFuture()
+{
+    int reached = 0;
+    auto inner = [&reached](QFuture<int> future) -> Task<int> {
+        const int value = co_await future;
+        ++reached;
+        co_return value;
+    };
+    auto outer = [&reached](Task<int> &task) -> Task<void> {
+        co_await task;
+        ++reached;
+    };
+
+    QPromise<int> promise;
+    promise.start();
+    auto innerTask = inner(promise.future());
+    auto outerTask = outer(innerTask);
+    promise.future().cancel();
+    promise.finish();
+
+    // Cancellation propagates through the awaiting tasks without resuming them.
+    QVERIFY(innerTask.isCanceled());
+    QTRY_VERIFY(outerTask.isCanceled());
+    QCOMPARE(reached, 0);
+}
+
+void tst_QCoroutine::awaitFutureSeveralTimes()
+{
+    QPromise<int> promise;
+    promise.start();
+    QFuture<int> future = promise.future();
+
+    // then() must be called before awaiting, which doesn't replace it
+    int continued = 0;
+    future.then(QtFuture::Launch::Sync, [&continued](int value) { continued = value; });
+    auto first = await(future);
+    auto second = await(QFuture<int>(future));
+    QVERIFY(!first.isFinished());
+    QVERIFY(!second.isFinished());
+
+    promise.addResult(42);
+    promise.finish();
+    QCOMPARE(continued, 42);
+    QTRY_VERIFY(first.isFinished());
+    QTRY_VERIFY(second.isFinished());
+    QCOMPARE(first.result(), 42);
+    QCOMPARE(second.result(), 42);
+}
+
+void tst_QCoroutine::awaitingThreadFinishesFirst()
+{
+    QPromise<void> promise;
+    promise.start();
+    Emitter emitter;
+    std::optional<Task<QThread *>> futureTask;
+    std::optional<Task<QThread *>> signalTask;
+
+    QThread thread;
+    QObject worker;
+    worker.moveToThread(&thread);
+    thread.start();
+    QMetaObject::invokeMethod(&worker, [&] {
+        futureTask.emplace(awaitAndReportThread(promise.future()));
+        signalTask.emplace([](Emitter *e) -> Task<QThread *> {
+            co_await QtCoroutine::signal(e, &Emitter::noArgs);
+            co_return QThread::currentThread();
+        }(&emitter));
+    }, Qt::BlockingQueuedConnection);
+    thread.quit();
+    QVERIFY(thread.wait());
+    QVERIFY(!futureTask->isFinished());
+    QVERIFY(!signalTask->isFinished());
+
+    // The event dispatcher of the awaiting thread is gone, so the coroutines
+    // continue where the awaited operations complete.
+    promise.finish();
+    QVERIFY(futureTask->isFinished());
+    QCOMPARE(futureTask->result(), QThread::currentThread());
+    emit emitter.noArgs();
+    QVERIFY(signalTask->isFinished());
+    QCOMPARE(signalTask->result(), QThread::currentThread());
+}
+
+void tst_QCoroutine::awaitSignal()
+{
+    Emitter emitter;
+
+    auto none = [](Emitter *e) -> Task<void> { co_await QtCoroutine::signal(e, &Emitter::noArgs); };
+    auto one = [](Emitter *e) -> Task<int> { co_return co_await QtCoroutine::signal(e, &Emitter::oneArg); };
+    auto two = [](Emitter *e) -> Task<QString> {
+        const auto [value, text] = co_await QtCoroutine::signal(e, &Emitter::twoArgs);
+        co_return text + QString::number(value);
+    };
+
+    auto noneTask = none(&emitter);
+    auto oneTask = one(&emitter);
+    auto twoTask = two(&emitter);
+    QVERIFY(!noneTask.isFinished());
+    QVERIFY(!oneTask.isFinished());
+    QVERIFY(!twoTask.isFinished());
+
+    emit emitter.noArgs();
+    emit emitter.oneArg(7);
+    emit emitter.twoArgs(3, QStringLiteral("x"));
+    QVERIFY(noneTask.isFinished());
+    QCOMPARE(oneTask.result(), 7);
+    QCOMPARE(twoTask.result(), QStringLiteral("x3"));
+
+    // Only a single emission is awaited; the connections are gone afterwards.
+    QVERIFY(!emitter.isSignalConnected(QMetaMethod::fromSignal(&Emitter::oneArg)));
+    QVERIFY(!emitter.isSignalConnected(QMetaMethod::fromSignal(&QObject::destroyed)));
+}
+
+void tst_QCoroutine::awaitSignalSenderDestroyed()
+{
+    auto task = [](Emitter *e) -> Task<int> {
+        co_return co_await QtCoroutine::signal(e, &Emitter::oneArg);
+    };
+
+    auto emitter = std::make_unique<Emitter>();
+    auto t = task(emitter.get());
+    emitter.reset();
+    QVERIFY(t.isCanceled());
+}
+
+void tst_QCoroutine::threadPoolRoundTrip()
+{
+    QThread *const mainThread = QThread::currentThread();
+    QThreadPool pool;
+
+    auto roundTrip = [](QThreadPool *pool, QObject *home) -> Task<QList<QThread *>> {
+        QList<QThread *> threads;
+        co_await QtCoroutine::resumeOnThreadPool(pool);
+        threads << QThread::currentThread();
+        co_await QtCoroutine::resumeOnThreadOf(home);
+        threads << QThread::currentThread();
+        co_return threads;
+    };
+
+    auto task = roundTrip(&pool, this);
+    QTRY_VERIFY(task.isFinished());
+    const QList<QThread *> threads = task.result();
+    QCOMPARE(threads.size(), 2);
+    QVERIFY(threads.at(0) != mainThread);
+    QCOMPARE(threads.at(1), mainThread);
+}
+
+void tst_QCoroutine::awaitTask()
+{
+    QPromise<int> promise;
+    promise.start();
+
+    auto producer = [](QFuture<int> future) -> Task<int> { co_return 2 * co_await future; };
+    auto consumer = [producer](QFuture<int> future) -> Task<int> {
+        const int a = co_await producer(future);
+        const int b = co_await producer(QtFuture::makeReadyFuture(5));
+        co_return a + b;
+    };
+
+    auto task = consumer(promise.future());
+    QVERIFY(!task.isFinished());
+    promise.addResult(10);
+    promise.finish();
+    QVERIFY(task.isFinished());
+    QCOMPARE(task.result(), 30);
+}
+
+void tst_QCoroutine::detachedTask()
+{
+    // A task whose handle is dropped keeps running and frees itself.
+    auto alive = std::make_shared<int>();
+    std::weak_ptr<int> observer = alive;
+
+    QPromise<void> promise;
+    promise.start();
+    bool done = false;
+    [](std::shared_ptr<int> keep, QFuture<void> future, bool *done) -> Task<void> {
+        Q_UNUSED(keep); // only held by the coroutine frame
+        co_await future;
+        *done = true;
+    }(std::move(alive), promise.future(), &done);
+
+    QVERIFY(!observer.expired());
+    promise.finish();
+    QVERIFY(done);
+    QVERIFY(observer.expired());
+}
+
+#else
+
+void tst_QCoroutine::awaitFinishedFuture() { }
+void tst_QCoroutine::awaitFutureFromOtherThread() { }
+#ifndef QT_NO_EXCEPTIONS
+void tst_QCoroutine::awaitFutureWithException() { }
+#endif
+void tst_QCoroutine::awaitCanceledFuture() { }
+void tst_QCoroutine::awaitFutureSeveralTimes() { }
+void tst_QCoroutine::awaitingThreadFinishesFirst() { }
+void tst_QCoroutine::awaitSignal() { }
+void tst_QCoroutine::awaitSignalSenderDestroyed() { }
+void tst_QCoroutine::threadPoolRoundTrip() { }
+void tst_QCoroutine::awaitTask() { }
+void tst_QCoroutine::detachedTask() { }
+
+#endif // HAS_COROUTINES
+
+QTEST_MAIN(tst_QCoroutine)
+#include "tst_qcoroutine.moc"
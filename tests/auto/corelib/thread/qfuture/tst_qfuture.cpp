@@ -148,6 +148,7 @@ private slots:
     void takeResults();
 #endif
     void takeResult();
+    void takeReadyResults();
     void runAndTake();
     void resultsReadyAt_data();
     void resultsReadyAt();
@@ -3016,6 +3017,30 @@ void tst_QFuture::takeResult()
     testSingleResult(result);
 }
 
+void tst_QFuture::takeReadyResults()
+{
+    QPromise<int> promise;
+    QFuture<int> future = promise.future();
+    promise.start();
+    QVERIFY(future.takeReadyResults().isEmpty());
+
+    for (int i = 0; i < 1000; ++i)
+        promise.addResult(i);
+    QList<int> results = future.takeReadyResults();
+    QCOMPARE(results.size(), 1000);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(results.at(i), i);
+    QCOMPARE(future.resultCount(), 1000);
+    QVERIFY(!future.isResultReadyAt(0));
+
+    promise.addResult(1000);
+    promise.addResult(1001);
+    promise.finish();
+    QCOMPARE(future.takeReadyResults(), QList<int>({ 1000, 1001 }));
+    QCOMPARE(future.resultCount(), 1002);
+    QVERIFY(future.takeReadyResults().isEmpty());
+}
+
 void tst_QFuture::runAndTake()
 {
     // Test if a 'moving' future can be used by
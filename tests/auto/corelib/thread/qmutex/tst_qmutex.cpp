@@ -34,9 +34,13 @@
 #include <qcoreapplication.h>
 #include <qelapsedtimer.h>
 #include <qmutex.h>
+#include <qreadwritelock.h>
+#include <qscopeguard.h>
 #include <qthread.h>
 #include <qwaitcondition.h>
 
+#include <private/qlockcontentionprofiler_p.h>
+
 class tst_QMutex : public QObject
 {
     Q_OBJECT
@@ -65,6 +69,7 @@ private slots:
     void tryLockNegative_data();
     void tryLockNegative();
     void moreStress();
+    void contentionProfiler();
 };
 
 static const int iterations = 100;
@@ -1335,5 +1340,86 @@ void tst_QMutex::moreStress()
 }
 
 
+void tst_QMutex::contentionProfiler()
+{
+    QLockContentionProfiler::reset();
+    QLockContentionProfiler::setEnabled(true);
+    auto cleanup = qScopeGuard([] {
+        QLockContentionProfiler::setEnabled(false);
+        QLockContentionProfiler::reset();
+    });
+
+    QMutex mutex;
+    QRecursiveMutex recursive;
+    QReadWriteLock readWriteLock;
+
+    // uncontended locking is not recorded
+    mutex.lock();
+    mutex.unlock();
+    recursive.lock();
+    recursive.lock();
+    recursive.unlock();
+    recursive.unlock();
+    readWriteLock.lockForRead();
+    readWriteLock.unlock();
+    readWriteLock.lockForWrite();
+    readWriteLock.unlock();
+    QVERIFY(QLockContentionProfiler::snapshot().isEmpty());
+
+    // lock in this thread, then have another thread wait for it
+    auto contend = [](auto lock, auto lockInThread, auto unlock) {
+        lock();
+        QSemaphore started;
+        QScopedPointer<QThread> thread(QThread::create([&] {
+            started.release();
+            lockInThread();
+            unlock();
+        }));
+        thread->start();
+        started.acquire();
+        QThread::msleep(100);
+        unlock();
+        QVERIFY(thread->wait());
+    };
+    contend([&] { mutex.lock(); }, [&] { mutex.lock(); }, [&] { mutex.unlock(); });
+    contend([&] { recursive.lock(); }, [&] { recursive.lock(); }, [&] { recursive.unlock(); });
+    contend([&] { readWriteLock.lockForWrite(); }, [&] { readWriteLock.lockForRead(); },
+            [&] { readWriteLock.unlock(); });
+    contend([&] { readWriteLock.lockForRead(); }, [&] { readWriteLock.lockForWrite(); },
+            [&] { readWriteLock.unlock(); });
+
+    const QList<QLockContentionProfiler::Entry> entries = QLockContentionProfiler::snapshot();
+    auto find = [&](QLockContentionProfiler::LockType type, const void *lock) {
+        for (const auto &entry : entries) {
+            if (entry.type == type && entry.lock == lock)
+                return entry;
+        }
+        return QLockContentionProfiler::Entry();
+    };
+    const QLockContentionProfiler::Entry expected[] = {
+        find(QLockContentionProfiler::Mutex, &mutex),
+        find(QLockContentionProfiler::RecursiveMutex, &recursive),
+        find(QLockContentionProfiler::ReadLock, &readWriteLock),
+        find(QLockContentionProfiler::WriteLock, &readWriteLock),
+    };
+    for (const auto &entry : expected) {
+        QCOMPARE(entry.waits, 1u);
+        QVERIFY(entry.totalWaitNSecs >= 50 * 1000 * 1000);
+        QCOMPARE(entry.maxWaitNSecs, entry.totalWaitNSecs);
+#if defined(Q_CC_GNU) || defined(Q_CC_CLANG) || defined(Q_CC_MSVC)
+        QVERIFY(entry.callSite);
+#endif
+    }
+    QVERIFY(QLockContentionProfiler::report().contains(QLatin1String("QRecursiveMutex")));
+
+    QLockContentionProfiler::reset();
+    QVERIFY(QLockContentionProfiler::snapshot().isEmpty());
+
+    // nothing is recorded while disabled
+    QLockContentionProfiler::setEnabled(false);
+    contend([&] { mutex.lock(); }, [&] { mutex.lock(); }, [&] { mutex.unlock(); });
+    QVERIFY(QLockContentionProfiler::snapshot().isEmpty());
+}
+
 QTEST_MAIN(tst_QMutex)
 #include "tst_qmutex.moc"
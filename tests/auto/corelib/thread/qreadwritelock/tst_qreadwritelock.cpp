@@ -52,6 +52,8 @@
 #endif
 
 #include <stdio.h>
+#include <memory>
+#include <vector>
 
 class tst_QReadWriteLock : public QObject
 {
@@ -95,6 +97,11 @@ private slots:
     // recursive locking tests
     void recursiveReadLock();
     void recursiveWriteLock();
+
+    // scalable readers tests
+    void scalableReaders_data();
+    void scalableReaders();
+    void scalableReadersCounting();
 };
 
 void tst_QReadWriteLock::constructDestruct()
@@ -1104,6 +1111,91 @@ void tst_QReadWriteLock::recursiveWriteLock()
     QVERIFY(thread.wait());
 }
 
+void tst_QReadWriteLock::scalableReaders_data()
+{
+    QTest::addColumn<QReadWriteLock::RecursionMode>("recursionMode");
+
+    QTest::newRow("NonRecursive") << QReadWriteLock::NonRecursive;
+    QTest::newRow("Recursive") << QReadWriteLock::Recursive;
+}
+
+void tst_QReadWriteLock::scalableReaders()
+{
+    QFETCH(QReadWriteLock::RecursionMode, recursionMode);
+    QReadWriteLock lock(recursionMode, QReadWriteLock::ScalableReaders);
+
+    auto tryLockInThread = [&lock](bool forWrite) {
+        bool result = false;
+        QScopedPointer<QThread> thread(QThread::create([&] {
+            result = forWrite ? lock.tryLockForWrite() : lock.tryLockForRead();
+            if (result)
+                lock.unlock();
+        }));
+        thread->start();
+        thread->wait();
+        return result;
+    };
+
+    for (int i = 0; i < 3; ++i) {
+        lock.lockForRead();
+        lock.unlock();
+        lock.lockForWrite();
+        lock.unlock();
+    }
+
+    // readers don't exclude each other, but exclude writers
+    QVERIFY(lock.tryLockForRead());
+    QVERIFY(tryLockInThread(false));
+    QVERIFY(!tryLockInThread(true));
+    QVERIFY(lock.tryLockForRead());
+    QVERIFY(!tryLockInThread(true));
+
+    // a waiting writer blocks new readers and gets the lock after the last unlock
+    QAtomicInt writerDone;
+    QScopedPointer<QThread> writer(QThread::create([&] {
+        lock.lockForWrite();
+        writerDone.storeRelaxed(1);
+        lock.unlock();
+    }));
+    writer->start();
+    QThread::msleep(100);
+    QVERIFY(!writerDone.loadRelaxed());
+    QVERIFY(!tryLockInThread(false));
+    lock.unlock();
+    QThread::msleep(100);
+    QVERIFY(!writerDone.loadRelaxed());
+    lock.unlock();
+    QVERIFY(writer->wait());
+    QVERIFY(writerDone.loadRelaxed());
+
+    // a writer excludes everybody else
+    QVERIFY(lock.tryLockForWrite());
+    QVERIFY(!tryLockInThread(false));
+    QVERIFY(!tryLockInThread(true));
+    lock.unlock();
+    QVERIFY(tryLockInThread(false));
+    QVERIFY(tryLockInThread(true));
+}
+
+void tst_QReadWriteLock::scalableReadersCounting()
+{
+    const int time = 2000;
+    const int readerThreads = 8;
+    const int writerThreads = 2;
+
+    QReadWriteLock testLock(QReadWriteLock::NonRecursive, QReadWriteLock::ScalableReaders);
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int i = 0; i < readerThreads; ++i)
+        threads.emplace_back(new ReadLockCountThread(testLock, time, 0));
+    for (int i = 0; i < writerThreads; ++i)
+        threads.emplace_back(new WriteLockCountThread(testLock, time, 20, 1000));
+
+    for (auto &thread : threads)
+        thread->start();
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+}
+
 QTEST_MAIN(tst_QReadWriteLock)
 
 #include "tst_qreadwritelock.moc"
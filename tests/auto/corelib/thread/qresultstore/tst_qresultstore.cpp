@@ -55,6 +55,8 @@ private slots:
     void count();
     void pendingResultsDoNotLeak_data();
     void pendingResultsDoNotLeak();
+    void appendedResults();
+    void takeReadyResults();
 private:
     int int0;
     int int1;
@@ -552,5 +554,89 @@ void tst_QtConcurrentResultStore::pendingResultsDoNotLeak()
     store.addResults(44, &lvalueListOfObj);
 }
 
+void tst_QtConcurrentResultStore::appendedResults()
+{
+    CountedObject::LeakChecker leakChecker; Q_UNUSED(leakChecker)
+
+    ResultStoreCountedObject store;
+    QList<const CountedObject *> addresses;
+    const int Count = 2000;
+    for (int i = 0; i < Count; ++i) {
+        CountedObject object;
+        object.id = i;
+        QCOMPARE(i % 2 ? store.moveResult(-1, std::move(object)) : store.addResult(-1, &object), i);
+        addresses.append(&store.resultAt(i).value<CountedObject>());
+    }
+    QCOMPARE(store.count(), Count);
+
+    // results are stored in batches, and never move
+    int batches = 0;
+    for (auto it = store.begin(); it != store.end(); it.batchedAdvance())
+        ++batches;
+    QVERIFY(batches < Count / 100);
+    for (int i = 0; i < Count; ++i) {
+        QCOMPARE(store.resultAt(i).value<CountedObject>().id, i);
+        QCOMPARE(&store.resultAt(i).value<CountedObject>(), addresses.at(i));
+    }
+
+    // results at other indexes are stored as before
+    CountedObject object;
+    QCOMPARE(store.addResult(Count + 1, &object), Count + 1);
+    QCOMPARE(store.count(), Count);
+    QCOMPARE(store.addResult(-1, &object), Count + 2);
+    QCOMPARE(store.addResult(Count, &object), Count);
+    QCOMPARE(store.count(), Count + 3);
+    QCOMPARE(store.addResult(Count, &object), -1);
+
+    // canceled results are skipped
+    ResultStoreInt intStore;
+    QCOMPARE(intStore.addResult(-1, &int0), 0);
+    QCOMPARE(intStore.addCanceledResult(-1), 1);
+    QCOMPARE(intStore.addResult(-1, &int1), 2);
+    QCOMPARE(intStore.addResult(-1, &int2), 3);
+    QCOMPARE(intStore.count(), 3);
+    QCOMPARE(intStore.resultAt(0).value<int>(), int0);
+    QCOMPARE(intStore.resultAt(1).value<int>(), int1);
+    QCOMPARE(intStore.resultAt(2).value<int>(), int2);
+}
+
+void tst_QtConcurrentResultStore::takeReadyResults()
+{
+    CountedObject::LeakChecker leakChecker; Q_UNUSED(leakChecker)
+
+    ResultStoreInt store;
+    QVERIFY(store.takeReadyResults<int>().isEmpty());
+
+    for (int i = 0; i < 10; ++i)
+        store.addResult(-1, &i);
+    store.addResults(-1, &vec0);
+    store.addResult(15, &int0);
+    QCOMPARE(store.takeReadyResults<int>(), QList<int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 2, 3 }));
+    QCOMPARE(store.count(), 12);
+    QVERIFY(!store.contains(0));
+    QVERIFY(!store.contains(11));
+    QVERIFY(store.contains(15));
+    QVERIFY(store.takeReadyResults<int>().isEmpty());
+
+    QCOMPARE(store.addResult(-1, &int1), 16);
+    store.addResult(12, &int1);
+    store.addResult(13, &int2);
+    store.addResult(14, &int2);
+    QCOMPARE(store.count(), 17);
+    QCOMPARE(store.takeReadyResults<int>(), QList<int>({ 1, 2, 2, 0, 1 }));
+    QVERIFY(!store.hasNextResult());
+
+    // appending continues after taking
+    for (int i = 0; i < 3; ++i)
+        store.addResult(-1, &i);
+    QCOMPARE(store.count(), 20);
+    QCOMPARE(store.takeReadyResults<int>(), QList<int>({ 0, 1, 2 }));
+
+    ResultStoreCountedObject objectStore;
+    for (int i = 0; i < 100; ++i)
+        objectStore.moveResult(-1, CountedObject());
+    QCOMPARE(objectStore.takeReadyResults<CountedObject>().size(), 100);
+}
+
 QTEST_MAIN(tst_QtConcurrentResultStore)
 #include "tst_qresultstore.moc"
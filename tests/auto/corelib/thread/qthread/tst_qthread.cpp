@@ -44,6 +44,9 @@
 #ifdef Q_OS_UNIX
 #include <pthread.h>
 #endif
+#ifdef Q_OS_LINUX
+#include <sched.h>
+#endif
 #if defined(Q_OS_WIN)
 #include <windows.h>
 #if defined(Q_OS_WIN32)
@@ -68,6 +71,7 @@ private slots:
     void isRunning();
     void setPriority();
     void setStackSize();
+    void cpuAffinity();
     void exit();
     void start();
     void terminate();
@@ -412,6 +416,69 @@ void tst_QThread::setStackSize()
     QCOMPARE(thread.stackSize(), 0u);
 }
 
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+static QList<int> currentCpuAffinity()
+{
+    QList<int> cpus;
+    cpu_set_t cpuSet;
+    if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) != 0)
+        return cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &cpuSet))
+            cpus.append(cpu);
+    }
+    return cpus;
+}
+#endif
+
+void tst_QThread::cpuAffinity()
+{
+    QVERIFY(QThread::numaNodeCount() >= 1);
+    const QList<int> nodeCpus = QThread::numaNodeCpus(0);
+    QVERIFY(!nodeCpus.isEmpty());
+    QVERIFY(QThread::numaNodeCpus(-1).isEmpty());
+    QVERIFY(QThread::numaNodeCpus(QThread::numaNodeCount()).isEmpty());
+
+    class AffinityThread : public QThread
+    {
+    public:
+        QSemaphore started;
+        QSemaphore proceed;
+        QList<int> initialCpus;
+        QList<int> finalCpus;
+
+        void run() override
+        {
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+            initialCpus = currentCpuAffinity();
+            started.release();
+            proceed.acquire();
+            finalCpus = currentCpuAffinity();
+#else
+            started.release();
+            proceed.acquire();
+#endif
+        }
+    };
+
+    const QList<int> affinity = { nodeCpus.last() };
+    AffinityThread thread;
+    QVERIFY(thread.cpuAffinity().isEmpty());
+    thread.setCpuAffinity(affinity);
+    QCOMPARE(thread.cpuAffinity(), affinity);
+    thread.start();
+    thread.started.acquire();
+    thread.setCpuAffinity(QList<int>());
+    QVERIFY(thread.cpuAffinity().isEmpty());
+    thread.proceed.release();
+    QVERIFY(thread.wait(30000));
+
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+    QCOMPARE(thread.initialCpus, affinity);
+    QCOMPARE(thread.finalCpus, currentCpuAffinity());
+#endif
+}
+
 void tst_QThread::exit()
 {
     Exit_Thread thread;
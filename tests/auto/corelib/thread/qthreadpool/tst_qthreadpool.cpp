@@ -101,6 +101,8 @@ private slots:
     void waitForDoneTimeout();
     void destroyingWaitsForTasksToFinish();
     void stackSize();
+    void workStealing();
+    void threadNameAndAffinity();
     void stressTest();
     void takeAllAndIncreaseMaxThreadCount();
     void waitForDoneAfterTake();
@@ -1145,6 +1147,161 @@ void tst_QThreadPool::stackSize()
     QCOMPARE(threadStackSize, targetStackSize);
 }
 
+void tst_QThreadPool::workStealing()
+{
+    QThreadPool threadPool;
+    QVERIFY(!threadPool.isWorkStealingEnabled());
+    threadPool.setWorkStealingEnabled(true);
+    QVERIFY(threadPool.isWorkStealingEnabled());
+
+    // runnables spawning runnables all get run
+    {
+        QAtomicInt runs;
+        std::function<void(int)> spawn = [&](int depth) {
+            runs.ref();
+            if (depth == 0)
+                return;
+            for (int i = 0; i < 4; ++i)
+                threadPool.start([&spawn, depth] { spawn(depth - 1); });
+        };
+        threadPool.start([&spawn] { spawn(5); });
+        QVERIFY(threadPool.waitForDone(60000));
+        QCOMPARE(runs.loadRelaxed(), 1 + 4 + 16 + 64 + 256 + 1024);
+    }
+
+    // without spare threads, runnables started from the pool run on the
+    // starting thread, most recent first; more important queued runnables
+    // and the ones taken back are left out
+    threadPool.setMaxThreadCount(1);
+    {
+        QSemaphore rootStarted;
+        QSemaphore priorityQueued;
+        QList<int> order;
+        QThread *rootThread = nullptr;
+        QAtomicInt otherThreadRuns;
+        bool taken = false;
+
+        auto notTaken = new FunctionPointerTask(emptyFunct);
+        notTaken->setAutoDelete(false);
+        threadPool.start([&] {
+            rootThread = QThread::currentThread();
+            for (int i = 0; i < 5; ++i) {
+                threadPool.start([&, i] {
+                    if (QThread::currentThread() != rootThread)
+                        otherThreadRuns.ref();
+                    order.append(i);
+                });
+            }
+            threadPool.start(notTaken);
+            taken = threadPool.tryTake(notTaken);
+            rootStarted.release();
+            priorityQueued.acquire();
+        });
+        rootStarted.acquire();
+        threadPool.start([&] { order.append(-1); }, 1);
+        priorityQueued.release();
+        QVERIFY(threadPool.waitForDone(60000));
+        delete notTaken;
+
+        QVERIFY(taken);
+        QCOMPARE(order, QList<int>({ -1, 4, 3, 2, 1, 0 }));
+        QCOMPARE(otherThreadRuns.loadRelaxed(), 0);
+    }
+
+    // spare threads take over runnables started from the pool
+    threadPool.setMaxThreadCount(4);
+    {
+        QSemaphore childrenRunning;
+        QSemaphore done;
+        bool childrenRan = false;
+        threadPool.start([&] {
+            for (int i = 0; i < 3; ++i)
+                threadPool.start([&] { childrenRunning.release(); done.acquire(); });
+            childrenRan = childrenRunning.tryAcquire(3, 60000);
+            done.release(3);
+        });
+        QVERIFY(threadPool.waitForDone(60000));
+        QVERIFY(childrenRan);
+    }
+
+    // clear() removes runnables started from the pool
+    threadPool.setMaxThreadCount(1);
+    {
+        QSemaphore started;
+        QSemaphore cleared;
+        QAtomicInt runs;
+        threadPool.start([&] {
+            for (int i = 0; i < 10; ++i)
+                threadPool.start([&] { runs.ref(); });
+            started.release();
+            cleared.acquire();
+        });
+        started.acquire();
+        threadPool.clear();
+        cleared.release();
+        QVERIFY(threadPool.waitForDone(60000));
+        QCOMPARE(runs.loadRelaxed(), 0);
+    }
+}
+
+void tst_QThreadPool::threadNameAndAffinity()
+{
+    QThreadPool threadPool;
+    QVERIFY(threadPool.threadName().isEmpty());
+    QVERIFY(threadPool.cpuAffinity().isEmpty());
+    QCOMPARE(threadPool.numaNode(), -1);
+
+    QString name;
+    QList<int> affinity;
+    const auto recordThread = [&] {
+        name = QThread::currentThread()->objectName();
+        affinity = QThread::currentThread()->cpuAffinity();
+    };
+
+    threadPool.start(recordThread);
+    QVERIFY(threadPool.waitForDone(30000));
+    QCOMPARE(name, QStringLiteral("Thread (pooled)"));
+    QVERIFY(affinity.isEmpty());
+
+    threadPool.setThreadName(QStringLiteral("Worker"));
+    threadPool.setNumaNode(0);
+    QCOMPARE(threadPool.threadName(), QStringLiteral("Worker"));
+    QCOMPARE(threadPool.numaNode(), 0);
+    QCOMPARE(threadPool.cpuAffinity(), QThread::numaNodeCpus(0));
+    threadPool.start(recordThread);
+    QVERIFY(threadPool.waitForDone(30000));
+    QCOMPARE(name, QStringLiteral("Worker"));
+    QCOMPARE(affinity, QThread::numaNodeCpus(0));
+
+    // running threads follow the affinity, but keep their name
+    QSemaphore started;
+    QSemaphore proceed;
+    threadPool.start([&] {
+        started.release();
+        proceed.acquire();
+        recordThread();
+    });
+    started.acquire();
+    const QList<int> cpus = { QThread::numaNodeCpus(0).first() };
+    threadPool.setCpuAffinity(cpus);
+    threadPool.setThreadName(QString());
+    proceed.release();
+    QVERIFY(threadPool.waitForDone(30000));
+    QCOMPARE(threadPool.numaNode(), -1);
+    QCOMPARE(affinity, cpus);
+    QCOMPARE(name, QStringLiteral("Worker"));
+    threadPool.start(recordThread);
+    QVERIFY(threadPool.waitForDone(30000));
+    QCOMPARE(name, QStringLiteral("Thread (pooled)"));
+
+    const int missingNode = QThread::numaNodeCount();
+    QTest::ignoreMessage(QtWarningMsg, qPrintable(QStringLiteral("QThreadPool::setNumaNode: NUMA node %1 does not exist").arg(missingNode)));
+    threadPool.setNumaNode(missingNode);
+    QCOMPARE(threadPool.cpuAffinity(), cpus);
+    threadPool.setNumaNode(-1);
+    QVERIFY(threadPool.cpuAffinity().isEmpty());
+}
+
 void tst_QThreadPool::stressTest()
 {
     class Task : public QRunnable
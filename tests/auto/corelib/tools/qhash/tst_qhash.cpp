@@ -77,6 +77,7 @@ private slots:
     void emplace();
 
     void badHashFunction();
+    void clusteredHashes();
     void hashOfHash();
 
     void stdHash();
@@ -1885,6 +1886,57 @@ void tst_QHash::badHashFunction()
 
 }
 
+struct ChosenHashKey {
+    int id;
+    size_t hash;
+    bool operator==(const ChosenHashKey &other) const { return id == other.id; }
+};
+
+size_t qHash(const ChosenHashKey &key, size_t)
+{
+    return key.hash;
+}
+
+void tst_QHash::clusteredHashes()
+{
+    // Build long probe sequences out of keys sharing their home bucket,
+    // starting right before the end of a span and of the whole table.
+    QHash<ChosenHashKey, int> hash;
+    hash.reserve(1000);
+    const size_t buckets = size_t(hash.capacity()) * 2;
+    QVERIFY(buckets >= 1024);
+
+    QList<ChosenHashKey> keys;
+    int id = 0;
+    for (size_t home : { size_t(126), buckets - 3 }) {
+        for (int i = 0; i < 36; ++i)
+            keys.append({ id++, (size_t(i) << 16) | home });
+    }
+    for (const ChosenHashKey &key : qAsConst(keys))
+        hash.insert(key, key.id);
+    QCOMPARE(hash.size(), keys.size());
+    QCOMPARE(size_t(hash.capacity()) * 2, buckets);
+
+    for (const ChosenHashKey &key : qAsConst(keys))
+        QCOMPARE(hash.value(key, -1), key.id);
+    for (size_t home : { size_t(126), buckets - 3, size_t(500) })
+        QVERIFY(!hash.contains({ -1, (size_t(100) << 16) | home }));
+
+    // erasing moves the following entries back
+    for (int i = 0; i < keys.size(); i += 3)
+        QVERIFY(hash.remove(keys.at(i)));
+    for (int i = 0; i < keys.size(); ++i)
+        QCOMPARE(hash.value(keys.at(i), -1), i % 3 ? keys.at(i).id : -1);
+
+    // copying into a larger table while the hash is shared, and rehashing
+    const QHash<ChosenHashKey, int> copy = hash;
+    hash.reserve(5000);
+    for (int i = 0; i < keys.size(); ++i) {
+        QCOMPARE(copy.value(keys.at(i), -1), i % 3 ? keys.at(i).id : -1);
+        QCOMPARE(hash.value(keys.at(i), -1), i % 3 ? keys.at(i).id : -1);
+    }
+}
+
 void tst_QHash::hashOfHash()
 {
     QHash<int, int> hash;
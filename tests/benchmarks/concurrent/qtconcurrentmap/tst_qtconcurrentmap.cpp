@@ -0,0 +1,125 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest>
+#include <QtConcurrent/qtconcurrentmap.h>
+
+#include <cmath>
+
+class tst_QtConcurrentMap : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void mappedReduced_data();
+    void mappedReduced();
+    void mappedReducedOrdered_data();
+    void mappedReducedOrdered();
+};
+
+static void addReduceOptions()
+{
+    QTest::addColumn<int>("itemCount");
+    QTest::addColumn<int>("threadCount");
+    QTest::addColumn<bool>("parallel");
+
+    for (int itemCount : {10000, 1000000}) {
+        for (int threadCount : {1, 4, 16}) {
+            for (bool parallel : {false, true}) {
+                QTest::addRow("%d items, %d threads%s", itemCount, threadCount,
+                              parallel ? ", parallel" : "")
+                        << itemCount << threadCount << parallel;
+            }
+        }
+    }
+}
+
+void tst_QtConcurrentMap::mappedReduced_data()
+{
+    addReduceOptions();
+}
+
+void tst_QtConcurrentMap::mappedReduced()
+{
+    QFETCH(int, itemCount);
+    QFETCH(int, threadCount);
+    QFETCH(bool, parallel);
+
+    QList<int> list(itemCount);
+    std::iota(list.begin(), list.end(), 0);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount);
+    QtConcurrent::ReduceOptions options(QtConcurrent::UnorderedReduce);
+    if (parallel)
+        options |= QtConcurrent::ParallelReduce;
+
+    auto map = [](int value) { return std::sqrt(double(value)); };
+    auto reduce = [](double &result, double value) { result += value; };
+
+    double result = 0;
+    QBENCHMARK {
+        result = QtConcurrent::blockingMappedReduced<double>(&pool, list, map, reduce, options);
+    }
+    QVERIFY(result > 0);
+}
+
+void tst_QtConcurrentMap::mappedReducedOrdered_data()
+{
+    addReduceOptions();
+}
+
+void tst_QtConcurrentMap::mappedReducedOrdered()
+{
+    QFETCH(int, itemCount);
+    QFETCH(int, threadCount);
+    QFETCH(bool, parallel);
+
+    QList<int> list(itemCount);
+    std::iota(list.begin(), list.end(), 0);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount);
+    QtConcurrent::ReduceOptions options(QtConcurrent::OrderedReduce);
+    if (parallel)
+        options |= QtConcurrent::ParallelReduce;
+
+    // a cheap map function, so that the reduction is the bottleneck
+    auto map = [](int value) { return qint64(value) * value; };
+    auto reduce = [](qint64 &result, qint64 value) { result += value; };
+
+    qint64 result = 0;
+    QBENCHMARK {
+        result = QtConcurrent::blockingMappedReduced<qint64>(&pool, list, map, reduce, options);
+    }
+    QVERIFY(result > 0);
+}
+
+QTEST_MAIN(tst_QtConcurrentMap)
+
+#include "tst_qtconcurrentmap.moc"
@@ -30,6 +30,9 @@
 #include <qtest.h>
 #include <qtesteventloop.h>
 
+#include <memory>
+#include <vector>
+
 class PingPong : public QObject
 {
 public:
@@ -83,6 +86,19 @@ int EventTester::foo(int bar)
     return bar + 1;
 }
 
+class PassThroughFilter : public QObject
+{
+public:
+    int filtered = 0;
+
+protected:
+    bool eventFilter(QObject *, QEvent *) override
+    {
+        ++filtered;
+        return false;
+    }
+};
+
 class EventsBench : public QObject
 {
     Q_OBJECT
@@ -96,6 +112,10 @@ private slots:
     void sendEvent();
     void postEvent_data();
     void postEvent();
+    void postEventContention_data();
+    void postEventContention();
+    void applicationEventFilters_data();
+    void applicationEventFilters();
 };
 
 void EventsBench::initTestCase()
@@ -169,6 +189,79 @@ void EventsBench::postEvent()
     }
 }
 
+void EventsBench::postEventContention_data()
+{
+    QTest::addColumn<int>("producerCount");
+    for (int count : { 1, 2, 4, 8, 16 })
+        QTest::addRow("%d producers", count) << count;
+}
+
+// Many threads feeding one receiving thread with queued invocations.
+void EventsBench::postEventContention()
+{
+    QFETCH(int, producerCount);
+    static constexpr int EventsPerProducer = 10000;
+
+    QObject receiver;
+    int received = 0;
+
+    QBENCHMARK {
+        received = 0;
+        std::vector<std::unique_ptr<QThread>> producers;
+        for (int i = 0; i < producerCount; ++i) {
+            producers.emplace_back(QThread::create([&receiver, &received] {
+                for (int j = 0; j < EventsPerProducer; ++j)
+                    QMetaObject::invokeMethod(&receiver, [&received] { ++received; },
+                                              Qt::QueuedConnection);
+            }));
+            producers.back()->start();
+        }
+        while (received < producerCount * EventsPerProducer)
+            QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+        for (const auto &producer : producers)
+            producer->wait();
+    }
+}
+
+void EventsBench::applicationEventFilters_data()
+{
+    QTest::addColumn<int>("filterCount");
+    QTest::addColumn<bool>("restrictTypes");
+    QTest::newRow("no filters") << 0 << false;
+    QTest::newRow("5 filters, all types") << 5 << false;
+    QTest::newRow("5 filters, other types") << 5 << true;
+}
+
+// Per-event overhead of application-wide event filters that are not
+// interested in the event being delivered.
+void EventsBench::applicationEventFilters()
+{
+    QFETCH(int, filterCount);
+    QFETCH(bool, restrictTypes);
+
+    std::vector<std::unique_ptr<PassThroughFilter>> filters;
+    for (int i = 0; i < filterCount; ++i) {
+        filters.emplace_back(new PassThroughFilter);
+        if (restrictTypes) {
+            const auto type = QEvent::Type(QEvent::MaxUser - i);
+            qApp->installEventFilter(filters.back().get(), { type });
+        } else {
+            qApp->installEventFilter(filters.back().get());
+        }
+    }
+
+    EventTester tst;
+    QEvent evt(QEvent::Type(QEvent::User+1));
+    QBENCHMARK {
+        QCoreApplication::sendEvent(&tst, &evt);
+    }
+
+    for (const auto &filter : filters) {
+        QCOMPARE(filter->filtered > 0, !restrictTypes);
+        qApp->removeEventFilter(filter.get());
+    }
+}
+
 QTEST_MAIN(EventsBench)
 
 #include "main.moc"
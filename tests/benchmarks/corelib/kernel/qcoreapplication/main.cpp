@@ -29,14 +29,103 @@
 #include <qtest.h>
 #include <qcoreapplication.h>
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 class QCoreApplicationBenchmark : public QObject
 {
 Q_OBJECT
 private slots:
     void event_posting_benchmark_data();
     void event_posting_benchmark();
+    void translate_data();
+    void translate();
 };
 
+// Builds the contents of a .qm file that translates \a count strings
+// "Message <i>" in \a context.
+static QByteArray qmData(const QByteArray &context, int count)
+{
+    static const uchar magic[16] = {
+        0x3c, 0xb8, 0x64, 0x18, 0xca, 0xef, 0x9c, 0x95,
+        0xcd, 0x21, 0x1c, 0xbf, 0x60, 0xa1, 0xbd, 0xdd
+    };
+    const auto elfHash = [](const QByteArray &text) {
+        uint h = 0;
+        for (uchar c : text) {
+            h = (h << 4) + c;
+            if (uint g = (h & 0xf0000000))
+                h ^= g >> 24;
+            h &= 0x0fffffff;
+        }
+        return h ? h : 1;
+    };
+
+    QByteArray messages;
+    QList<QPair<uint, uint>> hashes;
+    QDataStream messageStream(&messages, QIODevice::WriteOnly);
+    for (int i = 0; i < count; ++i) {
+        const QByteArray source = "Message " + QByteArray::number(i);
+        const QString translation = QString::fromLatin1(context + ' ' + source);
+        hashes.append({ elfHash(source), uint(messages.size()) });
+        messageStream << quint8(3) << translation;  // translation, as UTF-16
+        messageStream << quint8(6) << source;       // source text
+        messageStream << quint8(7) << context;      // context
+        messageStream << quint8(1);                 // end
+    }
+    std::sort(hashes.begin(), hashes.end());
+
+    QByteArray qm;
+    QDataStream stream(&qm, QIODevice::WriteOnly);
+    stream.writeRawData(reinterpret_cast<const char *>(magic), sizeof(magic));
+    stream << quint8(0x42) << quint32(hashes.size() * 8);
+    for (const auto &hash : qAsConst(hashes))
+        stream << hash.first << hash.second;
+    stream << quint8(0x69) << quint32(messages.size());
+    stream.writeRawData(messages.constData(), messages.size());
+    return qm;
+}
+
+void QCoreApplicationBenchmark::translate_data()
+{
+    QTest::addColumn<int>("translatorCount");
+    QTest::newRow("1 translator") << 1;
+    QTest::newRow("5 translators") << 5;
+    QTest::newRow("15 translators") << 15;
+}
+
+void QCoreApplicationBenchmark::translate()
+{
+    QFETCH(int, translatorCount);
+    const int messageCount = 100;
+
+    // The strings looked up are all in the translator searched last.
+    QList<QByteArray> files;
+    std::vector<std::unique_ptr<QTranslator>> translators;
+    for (int i = 0; i < translatorCount; ++i) {
+        files.append(qmData("Context" + QByteArray::number(i), messageCount));
+        translators.push_back(std::make_unique<QTranslator>());
+        QVERIFY(translators.back()->load(reinterpret_cast<const uchar *>(files.last().constData()),
+                                         int(files.last().size())));
+        QVERIFY(QCoreApplication::installTranslator(translators.back().get()));
+    }
+
+    QList<QByteArray> sources;
+    for (int i = 0; i < messageCount; ++i)
+        sources.append("Message " + QByteArray::number(i));
+    QCOMPARE(QCoreApplication::translate("Context0", sources.first()),
+             QLatin1String("Context0 Message 0"));
+
+    QBENCHMARK {
+        for (const QByteArray &source : qAsConst(sources))
+            QCoreApplication::translate("Context0", source);
+    }
+
+    for (const auto &translator : translators)
+        QCoreApplication::removeTranslator(translator.get());
+}
+
 void QCoreApplicationBenchmark::event_posting_benchmark_data()
 {
     QTest::addColumn<int>("size");
@@ -0,0 +1,128 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/qsocketnotifier.h>
+#include <QtCore/private/qeventdispatcher_unix_p.h>
+#include <QtCore/private/qcore_unix_p.h>
+#include <QTest>
+
+#include <memory>
+#include <vector>
+
+#include <sys/resource.h>
+
+class tst_QEventDispatcher : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void wakeUp_data();
+    void wakeUp();
+
+private:
+    int pipeFds[2] = { -1, -1 };
+};
+
+void tst_QEventDispatcher::initTestCase()
+{
+    // make room for the descriptors of the larger rows
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    QVERIFY(qt_safe_pipe(pipeFds) == 0);
+}
+
+void tst_QEventDispatcher::wakeUp_data()
+{
+    QTest::addColumn<bool>("epoll");
+    QTest::addColumn<int>("notifierCount");
+
+    for (bool epoll : { false, true }) {
+#if !QT_CONFIG(epoll)
+        if (epoll)
+            continue;
+#endif
+        for (int count : { 0, 10, 100, 1000, 10000 }) {
+            QTest::addRow("%s-%d", epoll ? "epoll" : "poll", count) << epoll << count;
+        }
+    }
+}
+
+// Measures the cost of one wake-up of an event loop that watches
+// notifierCount idle read notifiers.
+void tst_QEventDispatcher::wakeUp()
+{
+    QFETCH(bool, epoll);
+    QFETCH(int, notifierCount);
+
+    if (epoll)
+        qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+    std::unique_ptr<QEventDispatcherUNIX> dispatcher(new QEventDispatcherUNIX);
+    qunsetenv("QT_EVENT_DISPATCHER_EPOLL");
+
+    // The read end of a pipe nobody writes to never becomes ready; each
+    // notifier gets its own duplicate so every one has a distinct descriptor.
+    std::vector<int> fds;
+    std::vector<std::unique_ptr<QSocketNotifier>> notifiers;
+    fds.reserve(notifierCount);
+    notifiers.reserve(notifierCount);
+    for (int i = 0; i < notifierCount; ++i) {
+        const int fd = qt_safe_dup(pipeFds[0]);
+        if (fd == -1)
+            break;
+        fds.push_back(fd);
+        notifiers.emplace_back(new QSocketNotifier(fd, QSocketNotifier::Read));
+        // detach from the application's dispatcher, attach to the one under test
+        notifiers.back()->setEnabled(false);
+        dispatcher->registerSocketNotifier(notifiers.back().get());
+    }
+
+    if (int(fds.size()) == notifierCount) {
+        QBENCHMARK {
+            dispatcher->wakeUp();
+            dispatcher->processEvents(QEventLoop::WaitForMoreEvents);
+        }
+    }
+
+    for (const auto &notifier : notifiers)
+        dispatcher->unregisterSocketNotifier(notifier.get());
+    notifiers.clear();
+    for (int fd : fds)
+        qt_safe_close(fd);
+
+    if (int(fds.size()) != notifierCount)
+        QSKIP("Not enough file descriptors available");
+}
+
+QTEST_MAIN(tst_QEventDispatcher)
+
+#include "main.moc"
@@ -107,6 +107,18 @@ signals:
     void extraSignal70();
 };
 
+class Invokable : public LotsOfSignals
+{
+    Q_OBJECT
+public:
+    int calls = 0;
+
+public slots:
+    void noArgs() { ++calls; }
+    void intArg(int) { ++calls; }
+    void stringArg(const QString &) { ++calls; }
+};
+
 class tst_qmetaobject: public QObject
 {
 Q_OBJECT
@@ -122,6 +134,8 @@ private slots:
     void indexOfSignal();
     void indexOfSlot_data();
     void indexOfSlot();
+    void invokeMethod_data();
+    void invokeMethod();
 
     void unconnected_data();
     void unconnected();
@@ -222,6 +236,38 @@ void tst_qmetaobject::indexOfSlot()
     }
 }
 
+void tst_qmetaobject::invokeMethod_data()
+{
+    QTest::addColumn<QByteArray>("member");
+    QTest::newRow("noArgs") << QByteArray("noArgs");
+    QTest::newRow("intArg") << QByteArray("intArg");
+    QTest::newRow("stringArg") << QByteArray("stringArg");
+    QTest::newRow("inherited signal") << QByteArray("extraSignal1");
+}
+
+// String-based invocation as used by scripting bridges: every call looks
+// the method up by name and signature.
+void tst_qmetaobject::invokeMethod()
+{
+    QFETCH(QByteArray, member);
+    const char *p = member.constData();
+    Invokable obj;
+    const QString str = QStringLiteral("hello");
+    if (member == "intArg") {
+        QBENCHMARK {
+            QMetaObject::invokeMethod(&obj, p, Qt::DirectConnection, Q_ARG(int, 42));
+        }
+    } else if (member == "stringArg") {
+        QBENCHMARK {
+            QMetaObject::invokeMethod(&obj, p, Qt::DirectConnection, Q_ARG(QString, str));
+        }
+    } else {
+        QBENCHMARK {
+            QMetaObject::invokeMethod(&obj, p, Qt::DirectConnection);
+        }
+    }
+}
+
 void tst_qmetaobject::unconnected_data()
 {
     QTest::addColumn<int>("signal_index");
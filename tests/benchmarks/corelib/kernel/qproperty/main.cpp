@@ -31,6 +31,8 @@
 
 #include <qtest.h>
 
+#include <functional>
+
 #include "propertytester.h"
 
 class PropertyBenchmark : public QObject
@@ -51,8 +53,70 @@ private slots:
     void cppNotifyingReadOnce();
     void cppNotifyingDirect();
     void cppNotifyingDirectReadOnce();
+
+    void diamondUpdate_data();
+    void diamondUpdate();
+    void diamondEvaluations_data();
+    void diamondEvaluations();
 };
 
+namespace {
+// Many inputs feeding two intermediate bindings, which in turn both feed a
+// result that has a change handler attached.
+struct Diamond
+{
+    static constexpr int InputCount = 20;
+
+    Diamond()
+    {
+        sum.setBinding([this]() {
+            ++evaluations;
+            int s = 0;
+            for (const auto &input : inputs)
+                s += input.value();
+            return s;
+        });
+        maximum.setBinding([this]() {
+            ++evaluations;
+            int m = 0;
+            for (const auto &input : inputs)
+                m = qMax(m, input.value());
+            return m;
+        });
+        result.setBinding([this]() {
+            ++evaluations;
+            return sum.value() + maximum.value();
+        });
+    }
+
+    void update(int round, bool grouped)
+    {
+        if (grouped)
+            Qt::beginPropertyUpdateGroup();
+        for (int i = 0; i < InputCount; ++i)
+            inputs[i] = round * InputCount + i;
+        if (grouped)
+            Qt::endPropertyUpdateGroup();
+    }
+
+    static int expectedResult(int round)
+    {
+        const int first = round * InputCount;
+        const int last = first + InputCount - 1;
+        return (first + last) * InputCount / 2 + last;
+    }
+
+    QProperty<int> inputs[InputCount];
+    QProperty<int> sum;
+    QProperty<int> maximum;
+    QProperty<int> result;
+    int evaluations = 0;
+    int notifications = 0;
+    QPropertyChangeHandler<std::function<void()>> handler =
+            result.onValueChanged(std::function<void()>([this]() { ++notifications; }));
+};
+}
+
 void PropertyBenchmark::cppOldBinding()
 {
     QScopedPointer<PropertyTester> tester {new PropertyTester};
@@ -227,5 +291,52 @@ void PropertyBenchmark::cppNotifyingDirectReadOnce()
     QCOMPARE(tester->yNotified.value(), i);
 }
 
+void PropertyBenchmark::diamondUpdate_data()
+{
+    QTest::addColumn<bool>("grouped");
+
+    QTest::newRow("immediate") << false;
+    QTest::newRow("update group") << true;
+}
+
+void PropertyBenchmark::diamondUpdate()
+{
+    QFETCH(bool, grouped);
+
+    Diamond diamond;
+    int round = 0;
+    QBENCHMARK {
+        diamond.update(++round, grouped);
+    }
+
+    QCOMPARE(diamond.result.value(), Diamond::expectedResult(round));
+}
+
+void PropertyBenchmark::diamondEvaluations_data()
+{
+    diamondUpdate_data();
+}
+
+// Reports the number of binding evaluations needed to update all inputs once.
+void PropertyBenchmark::diamondEvaluations()
+{
+    QFETCH(bool, grouped);
+
+    Diamond diamond;
+    diamond.update(1, grouped);
+    diamond.evaluations = 0;
+    diamond.notifications = 0;
+    diamond.update(2, grouped);
+
+    // Without a group, the result may even be notified about intermediate
+    // values computed from partially updated dependencies.
+    if (grouped)
+        QCOMPARE(diamond.notifications, 1);
+    else
+        QVERIFY(diamond.notifications >= Diamond::InputCount);
+    QCOMPARE(diamond.result.value(), Diamond::expectedResult(2));
+    QTest::setBenchmarkResult(diamond.evaluations, QTest::Events);
+}
+
 QTEST_MAIN(PropertyBenchmark)
 #include "main.moc"
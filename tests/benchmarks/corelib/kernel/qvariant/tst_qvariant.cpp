@@ -32,6 +32,9 @@
 #endif
 #include <qtest.h>
 
+#include <memory>
+#include <vector>
+
 #define ITERATION_COUNT 1e5
 
 class tst_qvariant : public QObject
@@ -85,6 +88,9 @@ private slots:
     void createCoreType();
     void createCoreTypeCopy_data();
     void createCoreTypeCopy();
+
+    void convertContention_data();
+    void convertContention();
 };
 
 struct BigClass
@@ -107,6 +113,12 @@ Q_DECLARE_TYPEINFO(SmallClass, Q_RELOCATABLE_TYPE);
 QT_END_NAMESPACE
 Q_DECLARE_METATYPE(SmallClass);
 
+struct Celsius
+{
+    double degrees;
+};
+Q_DECLARE_METATYPE(Celsius);
+
 void tst_qvariant::testBound()
 {
     qreal d = qreal(.5);
@@ -376,6 +388,47 @@ void tst_qvariant::createCoreTypeCopy()
     }
 }
 
+void tst_qvariant::convertContention_data()
+{
+    QTest::addColumn<int>("threadCount");
+    for (int count : { 1, 2, 4, 8, 16, 32 })
+        QTest::addRow("%d threads", count) << count;
+}
+
+// Custom type conversions and name lookups from many threads at once, as
+// done by models that convert the QVariants they hand out.
+void tst_qvariant::convertContention()
+{
+    QFETCH(int, threadCount);
+    static constexpr int ConversionsPerThread = 20000;
+
+    static const bool registered = QMetaType::registerConverter<Celsius, double>(
+                [](const Celsius &c) { return c.degrees; });
+    QVERIFY(registered);
+    const QMetaType doubleType = QMetaType::fromType<double>();
+    const QByteArray typeName = QMetaType::fromType<Celsius>().name();
+
+    QBENCHMARK {
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int i = 0; i < threadCount; ++i) {
+            threads.emplace_back(QThread::create([&] {
+                double sum = 0;
+                for (int j = 0; j < ConversionsPerThread; ++j) {
+                    QVariant v = QVariant::fromValue(Celsius{ double(j) });
+                    if (v.canConvert(doubleType) && v.convert(doubleType))
+                        sum += v.toDouble();
+                    if (!QMetaType::fromName(typeName).isValid())
+                        return;
+                }
+                Q_UNUSED(sum);
+            }));
+            threads.back()->start();
+        }
+        for (const auto &thread : threads)
+            thread->wait();
+    }
+}
+
 QTEST_MAIN(tst_qvariant)
 
 #include "tst_qvariant.moc"
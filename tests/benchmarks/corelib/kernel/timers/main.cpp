@@ -0,0 +1,133 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/qbasictimer.h>
+#include <QtCore/qrandom.h>
+#include <QTest>
+
+#include <vector>
+
+class TimerObject : public QObject
+{
+public:
+    QBasicTimer timer;
+
+protected:
+    void timerEvent(QTimerEvent *) override {}
+};
+
+class tst_Timers : public QObject
+{
+    Q_OBJECT
+private slots:
+    void restart_data();
+    void restart();
+    void startStop_data() { restart_data(); }
+    void startStop();
+    void idleWakeUp_data() { restart_data(); }
+    void idleWakeUp();
+
+private:
+    void startTimers(std::vector<TimerObject> &objects, Qt::TimerType type);
+};
+
+void tst_Timers::restart_data()
+{
+    QTest::addColumn<int>("timerCount");
+    QTest::addColumn<Qt::TimerType>("timerType");
+
+    for (int count : { 1000, 10000, 100000 }) {
+        QTest::addRow("precise-%d", count) << count << Qt::PreciseTimer;
+        QTest::addRow("coarse-%d", count) << count << Qt::CoarseTimer;
+        QTest::addRow("verycoarse-%d", count) << count << Qt::VeryCoarseTimer;
+    }
+}
+
+// Every timer gets a long, distinct interval so that none fires while the
+// benchmark runs; only the cost of maintaining the timer store is measured.
+static int intervalFor(qsizetype i)
+{
+    return 60000 + int(i % 3000) * 10;
+}
+
+void tst_Timers::startTimers(std::vector<TimerObject> &objects, Qt::TimerType type)
+{
+    for (qsizetype i = 0; i < qsizetype(objects.size()); ++i)
+        objects[i].timer.start(intervalFor(i), type, &objects[i]);
+}
+
+// Connection-timeout pattern: a large population of live timers, a part of
+// which is restarted over and over.
+void tst_Timers::restart()
+{
+    QFETCH(int, timerCount);
+    QFETCH(Qt::TimerType, timerType);
+
+    std::vector<TimerObject> objects(timerCount);
+    startTimers(objects, timerType);
+
+    QRandomGenerator rng(timerCount);
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i) {
+            const int index = rng.bounded(timerCount);
+            objects[index].timer.start(intervalFor(index + i), timerType, &objects[index]);
+        }
+    }
+}
+
+void tst_Timers::startStop()
+{
+    QFETCH(int, timerCount);
+    QFETCH(Qt::TimerType, timerType);
+
+    std::vector<TimerObject> objects(timerCount);
+    QBENCHMARK {
+        startTimers(objects, timerType);
+        for (TimerObject &object : objects)
+            object.timer.stop();
+    }
+}
+
+// Cost of an event loop iteration that finds no expired timer.
+void tst_Timers::idleWakeUp()
+{
+    QFETCH(int, timerCount);
+    QFETCH(Qt::TimerType, timerType);
+
+    std::vector<TimerObject> objects(timerCount);
+    startTimers(objects, timerType);
+
+    QBENCHMARK {
+        QCoreApplication::processEvents();
+    }
+}
+
+QTEST_MAIN(tst_Timers)
+
+#include "main.moc"
@@ -59,6 +59,7 @@ private slots:
 
     void matchCustom();
     void matchCustomOptimized();
+    void matchCustomUncached();
 
     void globalMatchDefault();
     void globalMatchDefaultOptimized();
@@ -70,6 +71,12 @@ private slots:
     void queryMatchResultsByGroupIndex();
     void queryMatchResultsByGroupName();
     void iterateThroughGlobalMatchResults();
+
+    void matchManyPatterns_data();
+    void matchManyPatterns();
+
+    void globalMatchUtf8Data_data();
+    void globalMatchUtf8Data();
 };
 
 void tst_QRegularExpressionBenchmark::createDefault()
@@ -113,8 +120,8 @@ void tst_QRegularExpressionBenchmark::createAndMoveCustom()
 /*!
     \internal This benchmark measures the performance of the match() together
     with pattern compilation for a default-constructed object.
-    We need to create the object every time, so that the compiled pattern
-    does not get cached.
+    The object is created every time, so the compiled pattern comes from
+    the process-wide cache of compiled patterns.
 */
 void tst_QRegularExpressionBenchmark::matchDefault()
 {
@@ -148,8 +155,8 @@ void tst_QRegularExpressionBenchmark::matchDefaultOptimized()
     \internal This benchmark measures the performance of the match() together
     with pattern compilation for an object with custom pattern and pattern
     options.
-    We need to create the object every time, so that the compiled pattern
-    does not get cached.
+    The object is created every time, so the compiled pattern comes from
+    the process-wide cache of compiled patterns.
 */
 void tst_QRegularExpressionBenchmark::matchCustom()
 {
@@ -176,11 +183,28 @@ void tst_QRegularExpressionBenchmark::matchCustomOptimized()
     }
 }
 
+/*!
+    \internal This benchmark measures the performance of the match() together
+    with pattern compilation for an object with custom pattern and pattern
+    options. The pattern is different every time (thanks to a comment), so
+    it really has to be compiled.
+*/
+void tst_QRegularExpressionBenchmark::matchCustomUncached()
+{
+    int counter = 0;
+    QBENCHMARK {
+        QRegularExpression re(nonEmptyPattern + QStringLiteral("(?#%1)").arg(++counter),
+                              nonEmptyPatternOptions);
+        auto matchResult = re.match(textToMatch);
+        Q_UNUSED(matchResult);
+    }
+}
+
 /*!
     \internal This benchmark measures the performance of the globalMatch()
     together with the pattern compilation for a default-constructed object.
-    We need to create the object every time, so that the compiled pattern
-    does not get cached.
+    The object is created every time, so the compiled pattern comes from
+    the process-wide cache of compiled patterns.
 */
 void tst_QRegularExpressionBenchmark::globalMatchDefault()
 {
@@ -214,8 +238,8 @@ void tst_QRegularExpressionBenchmark::globalMatchDefaultOptimized()
     \internal This benchmark measures the performance of the globalMatch()
     together with the pattern compilation for an object with custom pattern
     and pattern options.
-    We need to create the object every time, so that the compiled pattern
-    does not get cached.
+    The object is created every time, so the compiled pattern comes from
+    the process-wide cache of compiled patterns.
 */
 void tst_QRegularExpressionBenchmark::globalMatchCustom()
 {
@@ -295,6 +319,107 @@ void tst_QRegularExpressionBenchmark::iterateThroughGlobalMatchResults()
     }
 }
 
+void tst_QRegularExpressionBenchmark::matchManyPatterns_data()
+{
+    QTest::addColumn<bool>("useSet");
+
+    QTest::newRow("QRegularExpression") << false;
+    QTest::newRow("QRegularExpressionSet") << true;
+}
+
+/*!
+    \internal This benchmark classifies lines of a log with 300 patterns,
+    either matching each pattern separately or using a QRegularExpressionSet.
+*/
+void tst_QRegularExpressionBenchmark::matchManyPatterns()
+{
+    QFETCH(bool, useSet);
+
+    QStringList patterns;
+    for (int i = 0; i < 100; ++i) {
+        patterns << QStringLiteral("\\bservice%1: (error|failure) code \\d+").arg(i)
+                 << QStringLiteral("^\\d{4}-\\d\\d-\\d\\d \\S+ \\[worker %1\\] timeout").arg(i)
+                 << QStringLiteral("user=(\\w+) action=delete item=%1\\b").arg(i);
+    }
+
+    QStringList lines;
+    for (int i = 0; i < 100; ++i) {
+        lines << QStringLiteral("2021-03-04 12:%1:00 [worker %2] service%2: started").arg(i % 60).arg(i)
+              << QStringLiteral("2021-03-04 12:%1:01 [worker %2] service%2: error code %1").arg(i % 60).arg(i)
+              << QStringLiteral("2021-03-04 12:%1:02 [worker %2] ok user=john action=view item=%2").arg(i % 60).arg(i);
+    }
+
+    qsizetype matches = 0;
+    if (useSet) {
+        const QRegularExpressionSet set(patterns);
+        QBENCHMARK {
+            matches = 0;
+            for (const QString &line : qAsConst(lines))
+                matches += set.matchingIndexes(line).size();
+        }
+    } else {
+        QList<QRegularExpression> regularExpressions;
+        for (const QString &pattern : qAsConst(patterns)) {
+            regularExpressions.append(QRegularExpression(pattern));
+            regularExpressions.last().optimize();
+        }
+        QBENCHMARK {
+            matches = 0;
+            for (const QString &line : qAsConst(lines)) {
+                for (const QRegularExpression &re : qAsConst(regularExpressions))
+                    matches += re.match(line).hasMatch();
+            }
+        }
+    }
+    QCOMPARE(matches, 100);
+}
+
+void tst_QRegularExpressionBenchmark::globalMatchUtf8Data_data()
+{
+    QTest::addColumn<bool>("convert");
+
+    QTest::newRow("via QString") << true;
+    QTest::newRow("UTF-8") << false;
+}
+
+/*!
+    \internal This benchmark looks for a few lines in a UTF-8 encoded log,
+    either converting it to a QString first or matching the UTF-8 data
+    directly.
+*/
+void tst_QRegularExpressionBenchmark::globalMatchUtf8Data()
+{
+    QFETCH(bool, convert);
+
+    QByteArray log;
+    for (int i = 0; i < 1000; ++i) {
+        log += QStringLiteral("2021-03-04 12:%1:00 [worker %2] user=jürgen action=%3 path=/ünïcödé/%2\n")
+                   .arg(i % 60).arg(i).arg(i % 100 ? u"view" : u"delete").toUtf8();
+    }
+
+    const QRegularExpression re(QStringLiteral("user=(\\S+) action=(delete)"));
+    re.optimize();
+
+    qsizetype total = 0;
+    if (convert) {
+        QBENCHMARK {
+            total = 0;
+            const QString text = QString::fromUtf8(log);
+            QRegularExpressionMatchIterator it = re.globalMatch(text);
+            while (it.hasNext())
+                total += it.next().capturedView(2).size();
+        }
+    } else {
+        QBENCHMARK {
+            total = 0;
+            QRegularExpressionMatchIterator it = re.globalMatch(QUtf8StringView(log));
+            while (it.hasNext())
+                total += it.next().capturedUtf8View(2).size();
+        }
+    }
+    QCOMPARE(total, 60);
+}
+
 QTEST_MAIN(tst_QRegularExpressionBenchmark)
 
 #include "tst_bench_qregularexpression.moc"
@@ -28,6 +28,10 @@
 #include <QStringList>
 #include <QFile>
 #include <QTest>
+#include <QScopeGuard>
+
+#include <private/qsimd_p.h>
+#include <private/qstringconverter_p.h>
 
 class tst_QString: public QObject
 {
@@ -48,9 +52,26 @@ private slots:
     void toCaseFolded_data();
     void toCaseFolded();
 
+    // the string kernels, at each ISA level supported by the CPU
+    void compare_data() { isaLevels_data(); }
+    void compare();
+    void compareLatin1_data() { isaLevels_data(); }
+    void compareLatin1();
+    void compareCaseInsensitive_data() { isaLevels_data(); }
+    void compareCaseInsensitive();
+    void indexOfChar_data() { isaLevels_data(); }
+    void indexOfChar();
+    void fromLatin1_data() { isaLevels_data(); }
+    void fromLatin1();
+    void toLatin1_data() { isaLevels_data(); }
+    void toLatin1();
+    void isValidUtf8_data() { isaLevels_data(); }
+    void isValidUtf8();
+
 private:
     void section_data_impl(bool includeRegExOnly = true);
     template <typename RX> void section_impl();
+    void isaLevels_data();
 };
 
 tst_QString::tst_QString()
@@ -187,6 +208,149 @@ void tst_QString::toCaseFolded()
     }
 }
 
+void tst_QString::isaLevels_data()
+{
+    QTest::addColumn<quint64>("disabledFeatures");
+    QTest::addColumn<int>("size");
+
+    struct IsaLevel {
+        const char *name;
+        quint64 disabledFeatures;
+        quint64 requiredFeatures;
+    };
+    const IsaLevel levels[] = {
+#if defined(Q_PROCESSOR_X86) && defined(Q_ATOMIC_INT64_IS_SUPPORTED)
+        { "sse2", CpuFeatureAVX2 | CpuFeatureAVX512BW, 0 },
+        { "avx2", CpuFeatureAVX512BW, CpuFeatureArchHaswell },
+        { "avx512", 0, CpuFeatureArchSkylakeAvx512 },
+#else
+        { "default", 0, 0 },
+#endif
+    };
+
+    for (const IsaLevel &level : levels) {
+        // skip what the CPU can't run and what Qt was compiled to always use
+        if ((qCpuFeatures() & level.requiredFeatures) != level.requiredFeatures)
+            continue;
+        if (qCompilerCpuFeatures & level.disabledFeatures)
+            continue;
+        for (int size : { 8, 40, 1000, 100000 })
+            QTest::addRow("%s:%d", level.name, size) << level.disabledFeatures << size;
+    }
+}
+
+// Makes the string code behave as if the CPU did not have \a disabledFeatures
+// until the returned guard is destroyed
+static auto disableCpuFeatures(quint64 disabledFeatures)
+{
+#ifdef Q_ATOMIC_INT64_IS_SUPPORTED
+    qCpuFeatures();     // make sure the features have been detected
+    const quint64 savedFeatures = qt_cpu_features[0].loadRelaxed();
+    qt_cpu_features[0].storeRelaxed(savedFeatures & ~disabledFeatures);
+    return qScopeGuard([=] { qt_cpu_features[0].storeRelaxed(savedFeatures); });
+#else
+    Q_UNUSED(disabledFeatures);
+    return qScopeGuard([] {});
+#endif
+}
+
+static QString asciiString(int size)
+{
+    QString s(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i)
+        s[i] = QLatin1Char('a' + i % 26);
+    return s;
+}
+
+void tst_QString::compare()
+{
+    QFETCH(quint64, disabledFeatures);
+    QFETCH(int, size);
+    const QString a = asciiString(size);
+    const QString b = asciiString(size);
+    auto guard = disableCpuFeatures(disabledFeatures);
+
+    QBENCHMARK {
+        QCOMPARE(QString::compare(a, b), 0);
+    }
+}
+
+void tst_QString::compareLatin1()
+{
+    QFETCH(quint64, disabledFeatures);
+    QFETCH(int, size);
+    const QString a = asciiString(size);
+    const QByteArray b = a.toLatin1();
+    auto guard = disableCpuFeatures(disabledFeatures);
+
+    QBENCHMARK {
+        QCOMPARE(QString::compare(a, QLatin1String(b)), 0);
+    }
+}
+
+void tst_QString::compareCaseInsensitive()
+{
+    QFETCH(quint64, disabledFeatures);
+    QFETCH(int, size);
+    const QString a = asciiString(size);
+    const QString b = a.toUpper();
+    auto guard = disableCpuFeatures(disabledFeatures);
+
+    QBENCHMARK {
+        QCOMPARE(QString::compare(a, b, Qt::CaseInsensitive), 0);
+    }
+}
+
+void tst_QString::indexOfChar()
+{
+    QFETCH(quint64, disabledFeatures);
+    QFETCH(int, size);
+    const QString a = asciiString(size);
+    auto guard = disableCpuFeatures(disabledFeatures);
+
+    QBENCHMARK {
+        QCOMPARE(a.indexOf(QLatin1Char('{')), -1);
+    }
+}
+
+void tst_QString::fromLatin1()
+{
+    QFETCH(quint64, disabledFeatures);
+    QFETCH(int, size);
+    const QByteArray a = asciiString(size).toLatin1();
+    auto guard = disableCpuFeatures(disabledFeatures);
+
+    QBENCHMARK {
+        QString s = QString::fromLatin1(a);
+        Q_UNUSED(s);
+    }
+}
+
+void tst_QString::toLatin1()
+{
+    QFETCH(quint64, disabledFeatures);
+    QFETCH(int, size);
+    const QString a = asciiString(size);
+    auto guard = disableCpuFeatures(disabledFeatures);
+
+    QBENCHMARK {
+        QByteArray s = a.toLatin1();
+        Q_UNUSED(s);
+    }
+}
+
+void tst_QString::isValidUtf8()
+{
+    QFETCH(quint64, disabledFeatures);
+    QFETCH(int, size);
+    const QByteArray a = asciiString(size).toUtf8();
+    auto guard = disableCpuFeatures(disabledFeatures);
+
+    QBENCHMARK {
+        QVERIFY(QUtf8::isValidUtf8(a).isValidUtf8);
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QString)
 
 #include "main.moc"
@@ -0,0 +1,170 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QStringConverter>
+#include <QScopeGuard>
+#include <QTest>
+
+#include <private/qsimd_p.h>
+
+class tst_QStringConverter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void decode_data() { corpora_data(); }
+    void decode();
+    void decodeStateful_data() { corpora_data(); }
+    void decodeStateful();
+    void encode_data() { corpora_data(); }
+    void encode();
+    void encodeStateful_data() { corpora_data(); }
+    void encodeStateful();
+
+private:
+    void corpora_data();
+};
+
+static QString makeText(std::initializer_list<char32_t> alphabet)
+{
+    QString text;
+    for (int i = 0; i < 100000; ++i)
+        text += QString::fromUcs4(alphabet.begin() + i % alphabet.size(), 1);
+    return text;
+}
+
+// Each corpus is run with the SIMD transcoding code disabled and enabled
+void tst_QStringConverter::corpora_data()
+{
+    QTest::addColumn<quint64>("disabledFeatures");
+    QTest::addColumn<QString>("text");
+
+    const struct {
+        const char *name;
+        QString text;
+    } corpora[] = {
+        { "ascii", makeText({ 'H', 'e', 'l', 'l', 'o', ',', ' ', 'w', 'o', 'r', 'l', 'd', '!', ' ' }) },
+        { "latin", makeText({ 'G', 'r', 0xfc, 0xdf, 'e', ' ', 'a', 'u', 's', ' ', 'K', 0xf6, 'l', 'n', ' ' }) },
+        { "cyrillic", makeText({ 0x41f, 0x440, 0x438, 0x432, 0x435, 0x442, ' ', 0x43c, 0x438, 0x440, ',', ' ' }) },
+        { "cjk", makeText({ 0x4f60, 0x597d, 0xff0c, 0x4e16, 0x754c, 0x3002 }) },
+        { "emoji", makeText({ 0x1f600, ' ', 0x1f680, 0x1f44d, 0x1f3fd, ' ', 0x1f1e8, 0x1f1ed, '!' }) },
+    };
+
+    for (const auto &corpus : corpora) {
+#if defined(Q_PROCESSOR_X86) && defined(Q_ATOMIC_INT64_IS_SUPPORTED)
+        QTest::addRow("%s:scalar", corpus.name) << quint64(CpuFeatureAVX2) << corpus.text;
+        if (qCpuHasFeature(ArchHaswell))
+            QTest::addRow("%s:avx2", corpus.name) << quint64(0) << corpus.text;
+#else
+        QTest::addRow("%s", corpus.name) << quint64(0) << corpus.text;
+#endif
+    }
+}
+
+static auto disableCpuFeatures(quint64 features)
+{
+#if defined(Q_PROCESSOR_X86) && defined(Q_ATOMIC_INT64_IS_SUPPORTED)
+    qCpuFeatures();     // make sure the features have been detected
+    const quint64 savedFeatures = qt_cpu_features[0].loadRelaxed();
+    qt_cpu_features[0].storeRelaxed(savedFeatures & ~features);
+    return qScopeGuard([=] { qt_cpu_features[0].storeRelaxed(savedFeatures); });
+#else
+    Q_UNUSED(features);
+    return qScopeGuard([] {});
+#endif
+}
+
+void tst_QStringConverter::decode()
+{
+    QFETCH(quint64, disabledFeatures);
+    QFETCH(QString, text);
+    const QByteArray utf8 = text.toUtf8();
+    auto restoreFeatures = disableCpuFeatures(disabledFeatures);
+
+    QString result;
+    QBENCHMARK {
+        result = QString::fromUtf8(utf8);
+    }
+    QCOMPARE(result, text);
+}
+
+void tst_QStringConverter::decodeStateful()
+{
+    QFETCH(quint64, disabledFeatures);
+    QFETCH(QString, text);
+    const QByteArray utf8 = text.toUtf8();
+    auto restoreFeatures = disableCpuFeatures(disabledFeatures);
+
+    // the chunks split multi-byte sequences
+    constexpr qsizetype ChunkSize = 4093;
+    QString result;
+    QBENCHMARK {
+        QStringDecoder decoder(QStringDecoder::Utf8);
+        result.clear();
+        for (qsizetype i = 0; i < utf8.size(); i += ChunkSize)
+            result += decoder(QByteArrayView(utf8).sliced(i, qMin(ChunkSize, utf8.size() - i)));
+    }
+    QCOMPARE(result, text);
+}
+
+void tst_QStringConverter::encode()
+{
+    QFETCH(quint64, disabledFeatures);
+    QFETCH(QString, text);
+    const QByteArray expected = text.toUtf8();
+    auto restoreFeatures = disableCpuFeatures(disabledFeatures);
+
+    QByteArray result;
+    QBENCHMARK {
+        result = text.toUtf8();
+    }
+    QCOMPARE(result, expected);
+}
+
+void tst_QStringConverter::encodeStateful()
+{
+    QFETCH(quint64, disabledFeatures);
+    QFETCH(QString, text);
+    const QByteArray expected = text.toUtf8();
+    auto restoreFeatures = disableCpuFeatures(disabledFeatures);
+
+    // the chunks split surrogate pairs
+    constexpr qsizetype ChunkSize = 4093;
+    QByteArray result;
+    QBENCHMARK {
+        QStringEncoder encoder(QStringEncoder::Utf8);
+        result.clear();
+        for (qsizetype i = 0; i < text.size(); i += ChunkSize)
+            result += encoder(QStringView(text).sliced(i, qMin(ChunkSize, text.size() - i)));
+    }
+    QCOMPARE(result, expected);
+}
+
+QTEST_MAIN(tst_QStringConverter)
+
+#include "main.moc"
@@ -0,0 +1,113 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest>
+#include <QtCore/qfuture.h>
+#include <QtCore/qpromise.h>
+#include <QtCore/qthread.h>
+
+class tst_QFuture : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void addResults_data();
+    void addResults();
+    void streamResults_data();
+    void streamResults();
+};
+
+void tst_QFuture::addResults_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::addRow("1") << 1;
+    QTest::addRow("1000") << 1000;
+    QTest::addRow("1000000") << 1000000;
+}
+
+void tst_QFuture::addResults()
+{
+    QFETCH(int, count);
+
+    QBENCHMARK {
+        QPromise<int> promise;
+        promise.start();
+        for (int i = 0; i < count; ++i)
+            promise.addResult(i);
+        promise.finish();
+        QCOMPARE(promise.future().resultCount(), count);
+    }
+}
+
+void tst_QFuture::streamResults_data()
+{
+    QTest::addColumn<bool>("takeResults");
+
+    QTest::addRow("keep results") << false;
+    QTest::addRow("take results") << true;
+}
+
+// One thread reporting many small results while another one consumes them.
+void tst_QFuture::streamResults()
+{
+    QFETCH(bool, takeResults);
+
+    const int Count = 1000000;
+    QBENCHMARK {
+        QPromise<int> promise;
+        QFuture<int> future = promise.future();
+        promise.start();
+        QScopedPointer<QThread> producer(QThread::create([&promise] {
+            for (int i = 0; i < Count; ++i)
+                promise.addResult(i);
+            promise.finish();
+        }));
+        producer->start();
+
+        qint64 sum = 0;
+        if (takeResults) {
+            while (!future.isFinished() || future.isResultReadyAt(future.resultCount() - 1)) {
+                const QList<int> results = future.takeReadyResults();
+                for (int result : results)
+                    sum += result;
+                if (results.isEmpty())
+                    QThread::yieldCurrentThread();
+            }
+        } else {
+            for (int result : future)
+                sum += result;
+        }
+        producer->wait();
+        QCOMPARE(sum, qint64(Count) * (Count - 1) / 2);
+    }
+}
+
+QTEST_MAIN(tst_QFuture)
+
+#include "tst_qfuture.moc"
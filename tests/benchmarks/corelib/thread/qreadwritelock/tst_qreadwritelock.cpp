@@ -66,6 +66,8 @@ private slots:
     void readOnly();
     void writeOnly_data();
     void writeOnly();
+    void readerScaling_data();
+    void readerScaling();
     // void readWrite();
 };
 
@@ -255,5 +257,64 @@ void tst_QReadWriteLock::writeOnly()
     holder.value();
 }
 
+void tst_QReadWriteLock::readerScaling_data()
+{
+    QTest::addColumn<QReadWriteLock::ReaderMode>("readerMode");
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<int>("writeEvery");
+
+    const int maxThreads = qMax(2, QThread::idealThreadCount());
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        for (int writeEvery : { 0, 1000 }) {
+            const QByteArray suffix = QByteArray::number(threads) + " threads"
+                    + (writeEvery ? ", 0.1% writes" : ", read only");
+            QTest::addRow("default, %s", suffix.constData())
+                    << QReadWriteLock::DefaultReaders << threads << writeEvery;
+            QTest::addRow("scalable, %s", suffix.constData())
+                    << QReadWriteLock::ScalableReaders << threads << writeEvery;
+        }
+    }
+}
+
+void tst_QReadWriteLock::readerScaling()
+{
+    QFETCH(QReadWriteLock::ReaderMode, readerMode);
+    QFETCH(int, threads);
+    QFETCH(int, writeEvery);
+
+    struct Thread : QThread
+    {
+        QReadWriteLock *lock;
+        int writeEvery;
+        void run() override
+        {
+            volatile int sink = 0;
+            for (int i = 0; i < Iterations; ++i) {
+                if (writeEvery && i % writeEvery == 0) {
+                    QWriteLocker locker(lock);
+                    global_string.clear();
+                } else {
+                    QReadLocker locker(lock);
+                    sink = sink + global_string.size();
+                }
+            }
+        }
+    };
+    QReadWriteLock lock(QReadWriteLock::NonRecursive, readerMode);
+    std::vector<std::unique_ptr<Thread>> pool;
+    for (int i = 0; i < threads; ++i) {
+        auto t = std::make_unique<Thread>();
+        t->lock = &lock;
+        t->writeEvery = writeEvery;
+        pool.push_back(std::move(t));
+    }
+    QBENCHMARK {
+        for (auto &t : pool)
+            t->start();
+        for (auto &t : pool)
+            t->wait();
+    }
+}
+
 QTEST_MAIN(tst_QReadWriteLock)
 #include "tst_qreadwritelock.moc"
@@ -40,6 +40,8 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void spawnSmallTasks_data();
+    void spawnSmallTasks();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -75,5 +77,56 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+static void busyWait(qint64 nsecs)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.nsecsElapsed() < nsecs)
+        ;
+}
+
+void tst_QThreadPool::spawnSmallTasks_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::addColumn<bool>("workStealing");
+
+    for (int threadCount = 1; threadCount <= 64; threadCount *= 2) {
+        QTest::addRow("%d threads", threadCount) << threadCount << false;
+        QTest::addRow("%d threads, work stealing", threadCount) << threadCount << true;
+    }
+}
+
+// Runnables that start many runnables taking about a microsecond each,
+// as when recursively dividing up work.
+void tst_QThreadPool::spawnSmallTasks()
+{
+    QFETCH(int, threadCount);
+    QFETCH(bool, workStealing);
+
+    enum { Spawners = 64, TasksPerSpawner = 1000 };
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    threadPool.setWorkStealingEnabled(workStealing);
+
+    QBENCHMARK {
+        QAtomicInt remaining(Spawners * TasksPerSpawner);
+        QSemaphore done;
+        const auto task = [&] {
+            busyWait(1000);
+            if (!remaining.deref())
+                done.release();
+        };
+        for (int i = 0; i < Spawners; ++i) {
+            threadPool.start([&] {
+                for (int j = 0; j < TasksPerSpawner; ++j)
+                    threadPool.start(task);
+            });
+        }
+        done.acquire();
+    }
+    threadPool.waitForDone();
+}
+
 QTEST_MAIN(tst_QThreadPool)
 #include "tst_qthreadpool.moc"
@@ -61,6 +61,9 @@ private slots:
     void hashing_javaString_data() { data(); }
     void hashing_javaString() { hashing_template<JavaString>(); }
 
+    void lookup_quint64_data();
+    void lookup_quint64();
+
 private:
     void data();
     template <typename String> void qhash_template();
@@ -168,6 +171,63 @@ template <typename String> void tst_QHash::hashing_template()
     }
 }
 
+// a cheap, reproducible sequence of well-spread 64-bit keys
+static quint64 nextKey(quint64 &state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+void tst_QHash::lookup_quint64_data()
+{
+    QTest::addColumn<qsizetype>("size");
+    QTest::addColumn<bool>("hit");
+
+    QList<qsizetype> sizes = { 1000, 100000, 1000000, 10000000 };
+    // needs about 2 GB of memory, so only on request
+    if (qEnvironmentVariableIsSet("QTEST_QHASH_HUGE"))
+        sizes << 50000000;
+    for (qsizetype size : qAsConst(sizes)) {
+        QTest::addRow("%lld-hit", qlonglong(size)) << size << true;
+        QTest::addRow("%lld-miss", qlonglong(size)) << size << false;
+    }
+}
+
+void tst_QHash::lookup_quint64()
+{
+    QFETCH(qsizetype, size);
+    QFETCH(bool, hit);
+
+    // Inserted keys are even, so odd keys are guaranteed misses.
+    QHash<quint64, quint64> hash;
+    hash.reserve(size);
+    quint64 state = 0x2545f4914f6cdd1d;
+    QList<quint64> inserted;
+    inserted.reserve(size);
+    for (qsizetype i = 0; i < size; ++i) {
+        const quint64 key = nextKey(state) & ~quint64(1);
+        hash.insert(key, i);
+        inserted.append(key);
+    }
+
+    const qsizetype lookups = 1 << 20;
+    QList<quint64> keys;
+    keys.reserve(lookups);
+    for (qsizetype i = 0; i < lookups; ++i) {
+        const quint64 r = nextKey(state);
+        keys.append(hit ? inserted.at(r % inserted.size()) : (r | 1));
+    }
+
+    quint64 sum = 0;
+    QBENCHMARK {
+        for (quint64 key : qAsConst(keys))
+            sum += hash.value(key);
+    }
+    QVERIFY(hit ? sum != 0 : sum == 0);
+}
+
 QTEST_MAIN(tst_QHash)
 
 #include "main.moc"